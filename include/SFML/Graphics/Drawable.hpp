@@ -30,6 +30,10 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 
+#include <SFML/Graphics/Rect.hpp>
+
+#include <optional>
+
 
 namespace sf
 {
@@ -67,6 +71,28 @@ protected:
     ///
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, const RenderStates& states) const = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the object
+    ///
+    /// When culling is enabled on the render target (see
+    /// RenderTarget::setCullingEnabled), objects whose bounds,
+    /// transformed by the render states, don't intersect the
+    /// visible area of the current view are not drawn at all.
+    ///
+    /// The bounds must be expressed in the coordinate system of
+    /// the render states passed to draw(), i.e. they include the
+    /// object's own transform if it has one, and must contain
+    /// everything the object draws. The default implementation
+    /// returns no bounds: the object is never culled.
+    ///
+    /// \return Bounds of the object, or std::nullopt if it must not be culled
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual std::optional<FloatRect> getCullingBounds() const
+    {
+        return std::nullopt;
+    }
 };
 
 } // namespace sf
@@ -83,7 +109,8 @@ protected:
 /// of derived classes to be drawn to a sf::RenderTarget.
 ///
 /// All you have to do in your derived class is to override the
-/// draw virtual function.
+/// draw virtual function. Overriding getCullingBounds as well
+/// allows the object to be skipped when it is outside the view.
 ///
 /// Note that inheriting from sf::Drawable is not mandatory,
 /// but it allows this nice syntax "window.draw(object)" rather
@@ -34,22 +34,28 @@
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/Texture.hpp>
 
+#include <SFML/System/Time.hpp>
+
+#include <deque>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 
-#ifdef SFML_SYSTEM_ANDROID
 namespace sf::priv
 {
+#ifdef SFML_SYSTEM_ANDROID
 class ResourceStream;
-}
 #endif
+class SkylinePacker;
+} // namespace sf::priv
 
 namespace sf
 {
 class InputStream;
+class Shader;
 
 ////////////////////////////////////////////////////////////
 /// \brief Class for loading and manipulating character fonts
@@ -280,18 +286,38 @@ public:
     float getUnderlineThickness(unsigned int characterSize) const;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Retrieve the texture containing the loaded glyphs of a certain size
+    /// \brief Retrieve a texture containing the loaded glyphs of a certain size
+    ///
+    /// The glyphs of a size are spread over several textures when
+    /// they don't fit in a single one, the texture of each glyph
+    /// is given by Glyph::page. The contents of the returned texture
+    /// changes as more glyphs are requested, thus it is not very
+    /// relevant. It is mainly used internally by sf::Text.
+    ///
+    /// \param characterSize Reference character size
+    /// \param page          Index of the texture, must be lower than getTextureCount(characterSize)
+    ///
+    /// \return Texture containing glyphs of the requested size
+    ///
+    /// \see getTextureCount
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(unsigned int characterSize, unsigned int page = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of textures containing the loaded glyphs of a certain size
     ///
-    /// The contents of the returned texture changes as more glyphs
-    /// are requested, thus it is not very relevant. It is mainly
-    /// used internally by sf::Text.
+    /// A new texture is added when the glyphs don't fit in
+    /// the existing ones anymore.
     ///
     /// \param characterSize Reference character size
     ///
-    /// \return Texture containing the glyphs of the requested size
+    /// \return Number of textures of the requested size
+    ///
+    /// \see getTexture
     ///
     ////////////////////////////////////////////////////////////
-    const Texture& getTexture(unsigned int characterSize) const;
+    std::size_t getTextureCount(unsigned int characterSize) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable the smooth filter
@@ -319,6 +345,152 @@ public:
     ////////////////////////////////////////////////////////////
     bool isSmooth() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the glyphs of a range of characters in advance
+    ///
+    /// Glyphs are normally rasterized and written to the texture
+    /// the first time they are requested, which can cause a
+    /// visible hitch when many new characters appear at once.
+    /// This function loads the glyphs of all the characters from
+    /// \a first to \a last (included) which are available in the
+    /// font and not loaded yet, and writes them to the textures
+    /// in batches.
+    ///
+    /// If asynchronous glyph loading is enabled, the glyphs are
+    /// queued for rasterization on the loading thread and this
+    /// function returns immediately.
+    ///
+    /// If distance field rendering is enabled and supported, the
+    /// distance field glyphs used by texts of every character size
+    /// and outline thickness are loaded instead, and \a characterSize
+    /// and \a outlineThickness are ignored.
+    ///
+    /// \param first            Unicode code point of the first character to load
+    /// \param last             Unicode code point of the last character to load
+    /// \param characterSize    Reference character size
+    /// \param bold             Load the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyphs will not be filled)
+    ///
+    /// \see setAsyncGlyphLoading, setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void preloadGlyphs(Uint32       first,
+                       Uint32       last,
+                       unsigned int characterSize,
+                       bool         bold             = false,
+                       float        outlineThickness = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable asynchronous glyph loading
+    ///
+    /// When asynchronous loading is enabled, glyphs which are not
+    /// loaded yet are rasterized on a separate thread rather than
+    /// when they are requested. In the meantime, getGlyph returns
+    /// an empty placeholder glyph with an approximate advance, so
+    /// that texts keep their layout but don't display the missing
+    /// characters. The rasterized glyphs are written to the
+    /// textures in batches the next time a glyph or a texture is
+    /// requested, and the texts using them update automatically.
+    ///
+    /// If the loading thread can't be started, glyphs are loaded
+    /// when they are requested.
+    /// Asynchronous glyph loading is disabled by default.
+    ///
+    /// \param async True to enable asynchronous glyph loading, false to disable it
+    ///
+    /// \see isAsyncGlyphLoading, getPendingGlyphCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAsyncGlyphLoading(bool async);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether asynchronous glyph loading is enabled or not
+    ///
+    /// \return True if glyphs are loaded asynchronously, false if they are loaded when requested
+    ///
+    /// \see setAsyncGlyphLoading
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAsyncGlyphLoading() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of glyphs waiting to be rasterized or written to the textures
+    ///
+    /// \return Number of glyphs queued by asynchronous glyph loading
+    ///
+    /// \see setAsyncGlyphLoading
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingGlyphCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of glyphs rasterized by the font
+    ///
+    /// \return Number of glyphs rasterized since the font was loaded
+    ///
+    /// \see getRasterizationTime
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getRasterizedGlyphCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the time spent rasterizing glyphs
+    ///
+    /// This is the time spent by FreeType to produce the pixels
+    /// of the glyphs, on any thread. Glyphs rasterized on the
+    /// loading thread are only counted once they are written
+    /// to the textures.
+    ///
+    /// \return Total rasterization time since the font was loaded
+    ///
+    /// \see getRasterizedGlyphCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRasterizationTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable distance field rendering
+    ///
+    /// By default, sf::Text draws glyphs rasterized at its
+    /// character size, with separate glyphs for outlines: each
+    /// character size and outline thickness used with the font
+    /// has its own glyphs and textures.
+    ///
+    /// With distance field rendering, texts draw glyphs which
+    /// are rasterized once at a reference size of 64 pixels and
+    /// stored as signed distance fields. A shader reconstructs
+    /// their edges at any character size and outline thickness,
+    /// which makes zooming and animating texts much cheaper.
+    /// Small characters are a bit less sharp than with regular
+    /// glyphs, and outlines thicker than 12/64 of the character
+    /// size are clipped.
+    ///
+    /// Distance fields require shaders: if they are not available,
+    /// texts keep drawing regular glyphs. A shader given in the
+    /// render states of a text replaces the distance field shader,
+    /// and receives the distance fields in the alpha channel of
+    /// the texture.
+    /// This setting doesn't change the glyphs returned by getGlyph
+    /// and the textures returned by getTexture.
+    /// Distance field rendering is disabled by default.
+    ///
+    /// \param enabled True to enable distance field rendering, false to disable it
+    ///
+    /// \see isDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDistanceFieldEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether distance field rendering is enabled or not
+    ///
+    /// \return True if texts draw distance field glyphs, false if they draw regular glyphs
+    ///
+    /// \see setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDistanceFieldEnabled() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -330,24 +502,20 @@ public:
     Font& operator=(const Font& right);
 
 private:
+    friend class Text;
+
     ////////////////////////////////////////////////////////////
-    /// \brief Structure defining a row of glyphs
-    ///
+    // Distance field settings
     ////////////////////////////////////////////////////////////
-    struct Row
-    {
-        Row(unsigned int rowTop, unsigned int rowHeight) : width(0), top(rowTop), height(rowHeight)
-        {
-        }
-
-        unsigned int width;  //!< Current width of the row
-        unsigned int top;    //!< Y position of the row into the texture
-        unsigned int height; //!< Height of the row
-    };
+    static constexpr unsigned int distanceFieldSize   = 64; //!< Character size of the distance field glyphs
+    static constexpr unsigned int distanceFieldSpread = 12; //!< Distance covered on each side of the edges, in pixels
 
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
+    class FontHandles;
+    class GlyphLoader;
+    struct RasterizedGlyph;
     using GlyphTable = std::unordered_map<Uint64, Glyph>; //!< Table mapping a codepoint to its glyph
 
     ////////////////////////////////////////////////////////////
@@ -358,10 +526,21 @@ private:
     {
         explicit Page(bool smooth);
 
-        GlyphTable       glyphs;  //!< Table mapping code points to their corresponding glyph
-        Texture          texture; //!< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; //!< Y position of the next new row in the texture
-        std::vector<Row> rows;    //!< List containing the position of all the existing rows
+        ////////////////////////////////////////////////////////////
+        /// \brief Add an empty texture to the page
+        ///
+        /// \param size   Width and height of the texture
+        /// \param smooth Status of the smooth filter
+        ///
+        /// \return True if the texture could be created
+        ///
+        ////////////////////////////////////////////////////////////
+        [[nodiscard]] bool addTexture(unsigned int size, bool smooth);
+
+        GlyphTable                       glyphs;       //!< Table mapping code points to their corresponding glyph
+        GlyphTable                       placeholders; //!< Glyphs returned while the real ones are being rasterized
+        std::deque<Texture>              textures;     //!< Textures containing the pixels of the glyphs
+        std::vector<priv::SkylinePacker> packers;      //!< Free space left in each texture
     };
 
     ////////////////////////////////////////////////////////////
@@ -370,15 +549,78 @@ private:
     ////////////////////////////////////////////////////////////
     void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve a glyph, either regular or distance field
+    ///
+    /// This function is mainly for internal use by sf::Text.
+    ///
+    /// \param codePoint        Unicode code point of the character to get
+    /// \param characterSize    Reference character size, must be distanceFieldSize for distance fields
+    /// \param bold             Retrieve the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
+    /// \param distanceField    Retrieve the distance field version or the regular one?
+    ///
+    /// \return The glyph corresponding to \a codePoint and \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& getGlyph(Uint32       codePoint,
+                          unsigned int characterSize,
+                          bool         bold,
+                          float        outlineThickness,
+                          bool         distanceField) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the kerning offset of two glyphs, either regular or distance field
+    ///
+    /// This function is mainly for internal use by sf::Text.
+    ///
+    /// \param first         Unicode code point of the first character
+    /// \param second        Unicode code point of the second character
+    /// \param characterSize Reference character size, must be distanceFieldSize for distance fields
+    /// \param bold          Retrieve the bold version or the regular one?
+    /// \param distanceField Use the distance field glyphs or the regular ones?
+    ///
+    /// \return Kerning value for \a first and \a second, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    float getKerning(Uint32 first, Uint32 second, unsigned int characterSize, bool bold, bool distanceField) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve a texture containing regular or distance field glyphs
+    ///
+    /// This function is mainly for internal use by sf::Text.
+    ///
+    /// \param characterSize Reference character size, must be distanceFieldSize for distance fields
+    /// \param page          Index of the texture
+    /// \param distanceField Retrieve a texture of distance field glyphs or of regular ones?
+    ///
+    /// \return Texture containing glyphs of the requested size
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(unsigned int characterSize, unsigned int page, bool distanceField) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader drawing distance field glyphs
+    ///
+    /// The shader is created the first time it is requested.
+    /// Its "threshold" uniform is the distance value of the
+    /// edges to draw: 0.5 for the glyphs, lower for outlines.
+    ///
+    /// \return Distance field shader, or a null pointer if distance field rendering is disabled or unavailable
+    ///
+    ////////////////////////////////////////////////////////////
+    Shader* getDistanceFieldShader() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Find or create the glyphs page corresponding to the given character size
     ///
-    /// \param characterSize Reference character size
+    /// \param characterSize Reference character size, ignored for distance fields
+    /// \param distanceField Get the page of the distance field glyphs?
     ///
     /// \return The glyphs page corresponding to \a characterSize
     ///
     ////////////////////////////////////////////////////////////
-    Page& loadPage(unsigned int characterSize) const;
+    Page& loadPage(unsigned int characterSize, bool distanceField = false) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Load a new glyph and store it in the cache
@@ -387,47 +629,141 @@ private:
     /// \param characterSize    Reference character size
     /// \param bold             Retrieve the bold version or the regular one?
     /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
+    /// \param distanceField    Load the distance field version or the regular one?
     ///
     /// \return The glyph corresponding to \a codePoint and \a characterSize
     ///
     ////////////////////////////////////////////////////////////
-    Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
+    Glyph loadGlyph(Uint32       codePoint,
+                    unsigned int characterSize,
+                    bool         bold,
+                    float        outlineThickness,
+                    bool         distanceField) const;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Find a suitable rectangle within the texture for a glyph
+    /// \brief Queue a glyph for asynchronous loading
     ///
-    /// \param page Page of glyphs to search in
-    /// \param size Width and height of the rectangle
+    /// \param page             Page of glyphs of the character size
+    /// \param key              Key of the glyph in the tables of the page
+    /// \param codePoint        Unicode code point of the character to load
+    /// \param characterSize    Reference character size
+    /// \param bold             Retrieve the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
+    /// \param distanceField    Load the distance field version or the regular one?
+    ///
+    /// \return Placeholder for the glyph, or a null pointer if the loading thread is not running
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph* requestGlyph(Page&        page,
+                              Uint64       key,
+                              Uint32       codePoint,
+                              unsigned int characterSize,
+                              bool         bold,
+                              float        outlineThickness,
+                              bool         distanceField) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the glyphs rasterized by the loading thread to the textures
+    ///
+    ////////////////////////////////////////////////////////////
+    void processLoadedGlyphs() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Place rasterized glyphs in the textures and store them in the cache
+    ///
+    /// The pixels are written with a single update per texture.
+    ///
+    /// \param glyphs Rasterized glyphs to insert
+    ///
+    ////////////////////////////////////////////////////////////
+    void insertGlyphs(std::vector<RasterizedGlyph>& glyphs) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a glyph with FreeType
+    ///
+    /// The code point, character size, bold flag, outline
+    /// thickness and distance field flag of \a glyph must be set,
+    /// the glyph metrics and pixels are filled. This function can be called from any
+    /// thread.
+    ///
+    /// \param fontHandles FreeType objects of the font
+    /// \param glyph       Glyph to rasterize
+    ///
+    ////////////////////////////////////////////////////////////
+    static void rasterizeGlyph(FontHandles& fontHandles, RasterizedGlyph& glyph);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a suitable rectangle within the textures for a glyph
+    ///
+    /// The glyph is placed in the first texture which has room
+    /// for it, a new texture is added to the page if none has.
+    ///
+    /// \param page         Page of glyphs to search in
+    /// \param size         Width and height of the rectangle
+    /// \param textureIndex Filled with the index of the texture containing the rectangle
     ///
     /// \return Found rectangle within the texture
     ///
     ////////////////////////////////////////////////////////////
-    IntRect findGlyphRect(Page& page, const Vector2u& size) const;
+    IntRect findGlyphRect(Page& page, const Vector2u& size, unsigned int& textureIndex) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Place a rasterized glyph in the textures of a page
+    ///
+    /// The texture rectangle and texture index of the glyph are
+    /// set, excluding the padding around its pixels.
+    ///
+    /// \param page  Page of glyphs of the character size
+    /// \param glyph Rasterized glyph to place
+    ///
+    /// \return Rectangle to write the glyph's pixels to, including padding
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect placeGlyph(Page& page, RasterizedGlyph& glyph) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of the glyph of a character in the font face
+    ///
+    /// \param codePoint Unicode code point of the character
+    ///
+    /// \return Index of the glyph, 0 if the font has none for \a codePoint
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getCharIndex(Uint32 codePoint) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Make sure that the given size is the current one
     ///
+    /// The mutex of the font handles must be locked.
+    ///
+    /// \param fontHandles   FreeType objects of the font
     /// \param characterSize Reference character size
     ///
     /// \return True on success, false if any error happened
     ///
     ////////////////////////////////////////////////////////////
-    [[nodiscard]] bool setCurrentSize(unsigned int characterSize) const;
+    [[nodiscard]] static bool setCurrentSize(FontHandles& fontHandles, unsigned int characterSize);
 
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    class FontHandles;
-    using PageTable = std::unordered_map<unsigned int, Page>; //!< Table mapping a character size to its page (texture)
+    using PageTable = std::unordered_map<unsigned int, Page>; //!< Table mapping a character size to its page (textures)
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::shared_ptr<FontHandles> m_fontHandles; //!< Shared information about the internal font instance
-    bool                         m_isSmooth;    //!< Status of the smooth filter
-    Info                         m_info;        //!< Information about the font
-    mutable PageTable            m_pages;       //!< Table containing the glyphs pages by character size
-    mutable std::vector<Uint8> m_pixelBuffer; //!< Pixel buffer holding a glyph's pixels before being written to the texture
+    std::shared_ptr<FontHandles>         m_fontHandles;            //!< Shared FreeType objects of the font
+    bool                                 m_isSmooth;               //!< Status of the smooth filter
+    Info                                 m_info;                   //!< Information about the font
+    mutable PageTable                    m_pages;                  //!< Glyphs pages by character size
+    mutable std::vector<Uint8>           m_pixelBuffer;            //!< Pixels of the last glyph written to a texture
+    bool                                 m_isAsyncGlyphLoading;    //!< Are glyphs rasterized on the loading thread?
+    mutable std::unique_ptr<GlyphLoader> m_glyphLoader;            //!< Loading thread, started by the first request
+    mutable std::size_t                  m_rasterizedGlyphCount;   //!< Number of glyphs rasterized so far
+    mutable Time                         m_rasterizationTime;      //!< Time spent rasterizing glyphs so far
+    bool                                 m_isDistanceFieldEnabled; //!< Do texts draw distance field glyphs?
+    mutable std::optional<Page>          m_distanceFieldPage;      //!< Glyphs page of the distance field glyphs
+    mutable std::unique_ptr<Shader>      m_distanceFieldShader;    //!< Shader drawing the distance field glyphs
 #ifdef SFML_SYSTEM_ANDROID
     std::unique_ptr<priv::ResourceStream> m_stream; //!< Asset file streamer (if loaded from file)
 #endif
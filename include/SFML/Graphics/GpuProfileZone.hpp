@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GPUPROFILEZONE_HPP
+#define SFML_GPUPROFILEZONE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief Scoped measurement of the GPU time spent rendering
+///        a section of a frame
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API GpuProfileZone
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Timings of a profile zone
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Result
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Result();
+
+        std::string  name;       //!< Name of the zone
+        unsigned int depth;      //!< Nesting depth of the zone, 0 for top-level zones
+        Time         cpuTime;    //!< Time spent on the CPU between the beginning and the end of the zone
+        Time         gpuTime;    //!< Time spent by the GPU executing the commands of the zone
+        bool         hasGpuTime; //!< Whether gpuTime could be measured
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Begin a profile zone
+    ///
+    /// Draws pending in the batch of \a target are flushed
+    /// first, so that they are not accounted to the zone.
+    ///
+    /// \param target Render target to profile
+    /// \param name   Name of the zone, reported in the results
+    ///
+    ////////////////////////////////////////////////////////////
+    GpuProfileZone(RenderTarget& target, const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Ends the zone.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GpuProfileZone();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    GpuProfileZone(const GpuProfileZone&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    GpuProfileZone& operator=(const GpuProfileZone&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timings of the latest resolved frame of a render target
+    ///
+    /// GPU timings are read back a few frames after they have
+    /// been recorded, so that waiting for them never stalls the
+    /// pipeline. The results therefore describe a frame a little
+    /// older than the last displayed one. The list is empty until
+    /// a frame containing profile zones has been resolved.
+    ///
+    /// \param target Render target whose timings to get
+    ///
+    /// \return Timings of the zones of the frame, in the order in which they began
+    ///
+    ////////////////////////////////////////////////////////////
+    static const std::vector<Result>& getResults(const RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether GPU timings are available on the current system
+    ///
+    /// This requires the ARB_timer_query OpenGL extension (core
+    /// since OpenGL 3.3). When it is not available, profile zones
+    /// only measure CPU timings.
+    ///
+    /// \return True if GPU timings are available, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isGpuTimingAvailable();
+
+private:
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    RenderTarget& m_target; //!< Render target being profiled
+    std::size_t   m_zone;   //!< Identifier of the zone in the profiler of the target
+};
+
+} // namespace sf
+
+
+#endif // SFML_GPUPROFILEZONE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GpuProfileZone
+/// \ingroup graphics
+///
+/// sf::GpuProfileZone measures how long the GPU takes to execute
+/// the rendering commands issued to a render target during its
+/// lifetime. Zones can be nested; the results of a frame list all
+/// its zones in the order in which they began, with their depth.
+///
+/// GPU times are measured with OpenGL timestamp queries, which
+/// are only read back once the GPU has reached them, a few
+/// frames later. The frame a zone belongs to ends when display()
+/// is called on the render window or render texture. On systems
+/// that don't support timer queries, only CPU times are measured
+/// (see isGpuTimingAvailable).
+///
+/// A profile zone must begin and end within the same frame, zones
+/// still open when the frame ends are discarded.
+///
+/// Usage example:
+/// \code
+/// {
+///     sf::GpuProfileZone zone(window, "shadows");
+///     window.draw(shadows);
+/// }
+///
+/// window.display();
+///
+/// for (const sf::GpuProfileZone::Result& result : sf::GpuProfileZone::getResults(window))
+///     std::cout << result.name << ": " << result.gpuTime.asMicroseconds() << " us" << std::endl;
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
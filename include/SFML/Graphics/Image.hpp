@@ -31,9 +31,11 @@
 #include <SFML/Graphics/Export.hpp>
 
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
 #include <SFML/Graphics/Rect.hpp>
 
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -49,6 +51,67 @@ class InputStream;
 class SFML_GRAPHICS_API Image
 {
 public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters used to resample images
+    ///
+    /// \see resize, scaled, generateMipmaps
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ResizeFilter
+    {
+        Nearest,  //!< Nearest pixel, fastest but blocky
+        Bilinear, //!< Linear interpolation between neighbor pixels, averaged when downscaling
+        Box,      //!< Average of the covered pixels, best suited to downscaling by integer factors
+        Lanczos   //!< Lanczos (3 lobes) windowed sinc, sharpest but may ring around hard edges
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters applied to the rows of PNG images before compression
+    ///
+    /// Filters replace each byte by its difference with a
+    /// prediction made from the neighbor pixels, which makes
+    /// smooth images compress better.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum PngFilter
+    {
+        PngNone,    //!< Rows are stored unchanged, fastest
+        PngSub,     //!< Prediction from the pixel on the left
+        PngUp,      //!< Prediction from the pixel above
+        PngAverage, //!< Prediction from the average of the pixels on the left and above
+        PngPaeth,   //!< Prediction from the pixel on the left, above or above-left closest to their gradient
+        PngAdaptive //!< Best of the other filters, chosen for each row; slowest but usually gives the smallest files
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Options used to encode images when saving them
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SaveSettings
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// \param level   PNG compression level
+        /// \param filter  PNG row filter
+        /// \param quality JPEG quality
+        ///
+        ////////////////////////////////////////////////////////////
+        constexpr explicit SaveSettings(int level = 8, PngFilter filter = PngAdaptive, int quality = 90) :
+        compressionLevel(level),
+        pngFilter(filter),
+        jpegQuality(quality)
+        {
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        int       compressionLevel; //!< PNG compression level, from 0 (no compression, fastest) to 9 (smallest files)
+        PngFilter pngFilter;        //!< Filter applied to the rows of PNG images
+        int       jpegQuality;      //!< JPEG quality, from 1 (smallest files) to 100 (best quality)
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the image and fill it with a unique color
     ///
@@ -72,12 +135,47 @@ public:
     ////////////////////////////////////////////////////////////
     void create(const Vector2u& size, const Uint8* pixels);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the image from an array of pixels of any format
+    ///
+    /// The pixels are converted to RGBA8, the format of the image.
+    /// The \a pixel array is assumed to have the given \a size
+    /// and to use the given \a format. If not, this is an
+    /// undefined behavior.
+    /// If \a pixels is null, an empty image is created.
+    ///
+    /// \param size   Width and height of the image
+    /// \param pixels Array of pixels to convert to the image
+    /// \param format Format of the pixels in the array
+    ///
+    /// \see convertPixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(const Vector2u& size, const void* pixels, PixelFormat format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the image by taking over an array of pixels
+    ///
+    /// The \a pixels array is moved into the image instead of
+    /// being copied, and must contain 32-bits RGBA pixels.
+    /// If its size is not size.x * size.y * 4, an error is
+    /// written to sf::err() and an empty image is created.
+    ///
+    /// \param size   Width and height of the image
+    /// \param pixels Array of pixels to move into the image
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(const Vector2u& size, std::vector<Uint8>&& pixels);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file on disk
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
     /// like progressive jpeg.
+    /// 2D textures stored in KTX, KTX2 and DDS containers with
+    /// BC1 to BC5, BC7, ETC1 or ETC2 compression are supported
+    /// too; their first mipmap level is decompressed.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param filename Path of the image file to load
@@ -95,6 +193,9 @@ public:
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
     /// like progressive jpeg.
+    /// 2D textures stored in KTX, KTX2 and DDS containers with
+    /// BC1 to BC5, BC7, ETC1 or ETC2 compression are supported
+    /// too; their first mipmap level is decompressed.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param data Pointer to the file data in memory
@@ -113,6 +214,9 @@ public:
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
     /// like progressive jpeg.
+    /// 2D textures stored in KTX, KTX2 and DDS containers with
+    /// BC1 to BC5, BC7, ETC1 or ETC2 compression are supported
+    /// too; their first mipmap level is decompressed.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param stream Source stream to read from
@@ -131,15 +235,18 @@ public:
     /// the extension. The supported image formats are bmp, png,
     /// tga and jpg. The destination file is overwritten
     /// if it already exists. This function fails if the image is empty.
+    /// Large PNG images are encoded on several threads.
     ///
     /// \param filename Path of the file to save
+    /// \param settings Encoding options
     ///
     /// \return True if saving was successful
     ///
     /// \see create, loadFromFile, loadFromMemory
     ///
     ////////////////////////////////////////////////////////////
-    [[nodiscard]] bool saveToFile(const std::filesystem::path& filename) const;
+    [[nodiscard]] bool saveToFile(const std::filesystem::path& filename,
+                                  const SaveSettings&          settings = SaveSettings()) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Save the image to a buffer in memory
@@ -149,15 +256,41 @@ public:
     /// This function fails if the image is empty, or if
     /// the format was invalid.
     ///
-    /// \param output Buffer to fill with encoded data
-    /// \param format Encoding format to use
+    /// \param output   Buffer to fill with encoded data
+    /// \param format   Encoding format to use
+    /// \param settings Encoding options
     ///
     /// \return True if saving was successful
     ///
     /// \see create, loadFromFile, loadFromMemory, saveToFile
     ///
     ////////////////////////////////////////////////////////////
-    [[nodiscard]] bool saveToMemory(std::vector<sf::Uint8>& output, const std::string& format) const;
+    [[nodiscard]] bool saveToMemory(std::vector<sf::Uint8>& output,
+                                    const std::string&      format,
+                                    const SaveSettings&     settings = SaveSettings()) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the image to a caller provided buffer
+    ///
+    /// This function works like the other overload of saveToMemory,
+    /// but writes to a fixed size buffer, which can be reused
+    /// between calls to avoid allocating memory. It fails if
+    /// the encoded image doesn't fit in the buffer.
+    ///
+    /// \param output   Buffer to write the encoded data to
+    /// \param capacity Size of the buffer, in bytes
+    /// \param format   Encoding format to use
+    /// \param settings Encoding options
+    ///
+    /// \return Number of bytes written to the buffer, or std::nullopt if saving failed
+    ///
+    /// \see saveToFile
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::optional<std::size_t> saveToMemory(void*               output,
+                                                          std::size_t         capacity,
+                                                          const std::string&  format,
+                                                          const SaveSettings& settings = SaveSettings()) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Return the size (width and height) of the image
@@ -263,6 +396,22 @@ public:
     ////////////////////////////////////////////////////////////
     const Uint8* getPixelsPtr() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a copy of the pixels converted to another format
+    ///
+    /// The size of the returned array is
+    /// getSize().x * getSize().y * getPixelSize(format).
+    /// Conversions to formats with fewer or smaller components
+    /// drop the missing components and round the others to
+    /// the nearest representable value.
+    ///
+    /// \param format Format of the returned pixels
+    ///
+    /// \return Converted pixels, empty if the image is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::vector<Uint8> convertPixels(PixelFormat format) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Flip the image horizontally (left <-> right)
     ///
@@ -275,6 +424,87 @@ public:
     ////////////////////////////////////////////////////////////
     void flipVertically();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Resample the image to a new size
+    ///
+    /// Apart from sf::Image::Nearest, filters blend the color
+    /// of neighbor pixels weighted by their alpha, so that the
+    /// color of transparent pixels doesn't bleed into the
+    /// result. Large images are processed on several threads,
+    /// see setMaximumThreadCount.
+    ///
+    /// If the image is empty, or if one of the components of
+    /// \a size is 0, the image becomes empty.
+    ///
+    /// \param size   New width and height of the image
+    /// \param filter Filter used to compute the new pixels
+    ///
+    /// \see scaled
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(const Vector2u& size, ResizeFilter filter = Bilinear);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a resampled copy of the image
+    ///
+    /// This function works like resize, but leaves the
+    /// image unchanged.
+    ///
+    /// \param size   Width and height of the copy
+    /// \param filter Filter used to compute the new pixels
+    ///
+    /// \return Resampled copy of the image
+    ///
+    /// \see resize
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Image scaled(const Vector2u& size, ResizeFilter filter = Bilinear) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Generate the mipmap levels of the image
+    ///
+    /// Each level is half the size of the previous one, rounded
+    /// down and at least 1 pixel, and is computed from the
+    /// previous level. The chain ends with a 1x1 level. The
+    /// image itself (level 0) is not part of the result.
+    /// Large levels are processed on several threads, see
+    /// setMaximumThreadCount.
+    ///
+    /// \param filter Filter used to compute each level
+    ///
+    /// \return Mipmap levels, starting at level 1; empty if the image is empty or 1x1
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::vector<Image> generateMipmaps(ResizeFilter filter = Box) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Limit the number of threads used to process large images
+    ///
+    /// Pixel operations, resampling, mipmap generation and PNG
+    /// encoding split large images between several threads,
+    /// by default one per hardware thread. Applications that
+    /// manage their own worker threads can lower this limit,
+    /// or set it to 1 to process all images on the calling
+    /// thread only.
+    ///
+    /// \param count Maximum number of threads, including the calling
+    ///              one; 0 to use one thread per hardware thread
+    ///
+    /// \see getMaximumThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setMaximumThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of threads used to process large images
+    ///
+    /// \return Maximum number of threads, 0 if it follows the number of hardware threads
+    ///
+    /// \see setMaximumThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumThreadCount();
+
 private:
     ////////////////////////////////////////////////////////////
     // Member data
@@ -326,6 +556,9 @@ private:
 /// if (!image.copy(background, {10, 10}))
 ///     return -1;
 ///
+/// // Create a half size thumbnail of the background
+/// sf::Image thumbnail = background.scaled(background.getSize() / 2u, sf::Image::Box);
+///
 /// // Make the top-left pixel transparent
 /// sf::Color color = image.getPixel({0, 0});
 /// color.a = 0;
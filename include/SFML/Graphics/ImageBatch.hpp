@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAGEBATCH_HPP
+#define SFML_IMAGEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+
+namespace priv
+{
+struct ImageBatchImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Loads a list of images on worker threads
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageBatch
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Outcome of the loading of one image of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        std::size_t index;   //!< Position of the source in the list given to the batch
+        bool        success; //!< Whether the image could be loaded
+        Image       image;   //!< Loaded image, empty if loading failed
+        std::string error;   //!< Errors written while loading the image, empty if there were none
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading images from files on disk
+    ///
+    /// The supported image formats are the ones of Image::loadFromFile.
+    ///
+    /// \param filenames   Paths of the image files to load
+    /// \param threadCount Number of worker threads, 0 to use one per hardware thread
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ImageBatch(std::vector<std::filesystem::path> filenames, unsigned int threadCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading images from custom streams
+    ///
+    /// The streams are read by the worker threads, they must
+    /// be distinct objects and stay alive until the batch is
+    /// destroyed.
+    ///
+    /// \param streams     Source streams to read from
+    /// \param threadCount Number of worker threads, 0 to use one per hardware thread
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ImageBatch(std::vector<InputStream*> streams, unsigned int threadCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Images which are still being loaded are finished, the
+    /// ones which were not started yet are skipped.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageBatch(const ImageBatch&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageBatch& operator=(const ImageBatch&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageBatch(ImageBatch&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageBatch& operator=(ImageBatch&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images of the batch
+    ///
+    /// \return Number of sources given to the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::size_t getCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images which have not been returned yet
+    ///
+    /// \return Number of results still to be returned by poll or wait
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::size_t getRemainingCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the next loaded image, if there is one
+    ///
+    /// This function doesn't block: it returns false if no
+    /// image has finished loading since the last call.
+    ///
+    /// \param result Filled with the next loaded image
+    ///
+    /// \return True if a result was returned
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool poll(Result& result);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for the next loaded image
+    ///
+    /// Images are returned in the order in which they finish
+    /// loading, which is not necessarily the order of the sources.
+    ///
+    /// \param result Filled with the next loaded image
+    ///
+    /// \return True if a result was returned, false if all the images have already been returned
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool wait(Result& result);
+
+private:
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::unique_ptr<priv::ImageBatchImpl> m_impl; //!< Sources, results and worker threads
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageBatch
+/// \ingroup graphics
+///
+/// sf::ImageBatch decodes a list of image files or streams on a
+/// pool of worker threads, and hands each image over as soon as
+/// it is loaded. This speeds up the loading of many images, which
+/// is usually limited by the decoding on a single core, and lets
+/// the calling thread upload the first images to textures while
+/// the next ones are still being decoded.
+///
+/// The images are loaded like with sf::Image::loadFromFile and
+/// sf::Image::loadFromStream. The errors of each image are
+/// collected by the worker that loads it, and written to
+/// sf::err() by poll or wait when the image is returned, so
+/// that sf::err() is only used by the calling thread.
+///
+/// Usage example:
+/// \code
+/// std::vector<std::filesystem::path> paths = ...;
+/// std::vector<sf::Texture> textures(paths.size());
+///
+/// sf::ImageBatch batch(paths);
+///
+/// sf::ImageBatch::Result result;
+/// while (batch.wait(result))
+/// {
+///     if (!result.success || !textures[result.index].loadFromImage(result.image))
+///         std::cerr << "Failed to load " << paths[result.index] << std::endl;
+/// }
+/// \endcode
+///
+/// \see sf::Image, sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PIXELFORMAT_HPP
+#define SFML_PIXELFORMAT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \ingroup graphics
+/// \brief Memory layouts of pixels that sf::Image and
+///        sf::Texture can convert and upload
+///
+/// Components are stored in the order of the name of the
+/// format. Packed 16-bit formats (RGB565, RGBA4444) store each
+/// pixel as a native-endian 16-bit integer, with the first
+/// component in the most significant bits. RGBA16F stores
+/// each component as a native-endian IEEE half-precision float.
+///
+/// When converted to RGBA8, missing components are set like
+/// OpenGL samples them: 0 for green and blue, 255 for alpha.
+///
+////////////////////////////////////////////////////////////
+enum PixelFormat
+{
+    RGBA8,    //!< 8-bit red, green, blue and alpha, the native format of sf::Image (4 bytes per pixel)
+    R8,       //!< 8-bit red only, for masks and height maps (1 byte per pixel)
+    RG8,      //!< 8-bit red and green (2 bytes per pixel)
+    RGB565,   //!< 5-bit red, 6-bit green and 5-bit blue, opaque (2 bytes per pixel)
+    RGBA4444, //!< 4-bit red, green, blue and alpha (2 bytes per pixel)
+    RGBA16F   //!< 16-bit floating point red, green, blue and alpha (8 bytes per pixel)
+};
+
+////////////////////////////////////////////////////////////
+/// \ingroup graphics
+/// \brief Get the number of bytes used by a pixel of a format
+///
+/// \param format Pixel format
+///
+/// \return Size of a pixel, in bytes
+///
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API std::size_t getPixelSize(PixelFormat format);
+
+} // namespace sf
+
+
+#endif // SFML_PIXELFORMAT_HPP
@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RENDERCOMMANDLIST_HPP
+#define SFML_RENDERCOMMANDLIST_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class VertexBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Recorded sequence of rendering commands that can
+///        be replayed on a render target
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderCommandList : public Drawable
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty command list.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderCommandList();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a clear of the entire target
+    ///
+    /// \param color Fill color to use to clear the render target
+    ///
+    /// \see RenderTarget::clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear(const Color& color = Color(0, 0, 0, 255));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a change of the current active view
+    ///
+    /// The command list keeps its own copy of the view.
+    ///
+    /// \param view New view to use
+    ///
+    /// \see RenderTarget::setView
+    ///
+    ////////////////////////////////////////////////////////////
+    void setView(const View& view);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the drawing of a drawable object
+    ///
+    /// Only a reference to the drawable is recorded: it must
+    /// stay alive as long as the list is replayed, and it is
+    /// drawn in the state it is in at the time of the replay.
+    ///
+    /// \param drawable Object to draw
+    /// \param states   Render states to use for drawing
+    ///
+    /// \see RenderTarget::draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Drawable& drawable, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the drawing of primitives defined by an array of vertices
+    ///
+    /// The vertices are copied into the command list, the
+    /// array can be modified or destroyed right after the call.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    /// \see RenderTarget::draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex*       vertices,
+              std::size_t         vertexCount,
+              PrimitiveType       type,
+              const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the drawing of primitives defined by a vertex buffer
+    ///
+    /// Only a reference to the vertex buffer is recorded: it
+    /// must stay alive as long as the list is replayed.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param firstVertex  Index of the first vertex to render
+    /// \param vertexCount  Number of vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    /// \see RenderTarget::draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer,
+              std::size_t         firstVertex,
+              std::size_t         vertexCount,
+              const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the recorded commands
+    ///
+    /// This function doesn't deallocate the corresponding
+    /// memory, so that recording the next frame into the same
+    /// list doesn't involve reallocating all the memory.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of recorded commands
+    ///
+    /// \return Number of commands in the list
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCommandCount() const;
+
+private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Replay the recorded commands on a render target
+    ///
+    /// \param target Render target to replay the commands on
+    /// \param states Render states combined with the recorded ones
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(RenderTarget& target, const RenderStates& states) const override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Single recorded command
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        enum Type
+        {
+            Clear,           //!< RenderTarget::clear
+            SetView,         //!< RenderTarget::setView
+            DrawDrawable,    //!< RenderTarget::draw(const Drawable&, ...)
+            DrawVertices,    //!< RenderTarget::draw(const Vertex*, ...)
+            DrawVertexBuffer //!< RenderTarget::draw(const VertexBuffer&, ...)
+        };
+
+        Type                type;          //!< Type of the command
+        RenderStates        states;        //!< Render states of draw commands
+        Color               color;         //!< Fill color of clear commands
+        std::size_t         index;         //!< Index of the view or of the first vertex
+        std::size_t         count;         //!< Number of vertices of draw commands
+        PrimitiveType       primitiveType; //!< Primitive type of vertex draw commands
+        const Drawable*     drawable;      //!< Drawable of drawable draw commands
+        const VertexBuffer* vertexBuffer;  //!< Vertex buffer of vertex buffer draw commands
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a new command to the list
+    ///
+    /// \param type Type of the command
+    ///
+    /// \return Reference to the new command
+    ///
+    ////////////////////////////////////////////////////////////
+    Command& addCommand(Command::Type type);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Command> m_commands; //!< Recorded commands, in submission order
+    std::vector<Vertex>  m_vertices; //!< Copies of the vertices of vertex draw commands
+    std::vector<View>    m_views;    //!< Copies of the views of view commands
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERCOMMANDLIST_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderCommandList
+/// \ingroup graphics
+///
+/// sf::RenderCommandList records clear, setView and draw calls
+/// with the same signatures as sf::RenderTarget, without
+/// issuing any OpenGL command. The list can therefore be built
+/// on any thread, for example while traversing and culling the
+/// scene, and later replayed on the thread that owns the render
+/// target's context, simply by drawing it.
+///
+/// Raw vertices are copied at recording time. Drawables and
+/// vertex buffers are recorded by reference and are drawn as
+/// they are at replay time, which makes it cheap to keep a list
+/// of unchanged elements (a UI for example) and replay it every
+/// frame without recording it again.
+///
+/// When the list is replayed, the transform of the render states
+/// given to RenderTarget::draw is combined with the recorded ones,
+/// the other render states are taken from the recorded commands.
+/// View and clear commands affect the target exactly as if they
+/// had been called directly, and persist after the replay.
+///
+/// A command list must not be recorded and replayed at the same
+/// time from different threads.
+///
+/// Usage example:
+/// \code
+/// // On a worker thread
+/// sf::RenderCommandList list;
+/// list.clear();
+/// list.setView(camera);
+/// for (const Entity& entity : visibleEntities)
+///     list.draw(entity.sprite);
+///
+/// // On the rendering thread
+/// window.draw(list);
+/// window.display();
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
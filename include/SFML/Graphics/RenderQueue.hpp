@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RENDERQUEUE_HPP
+#define SFML_RENDERQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Deferred queue of draws, reordered to minimize
+///        render state changes
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderQueue : public Drawable
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty queue. All layers are sorted by state.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit a drawable object to the queue
+    ///
+    /// Only a reference to the drawable is stored: it must stay
+    /// alive until the queue is drawn.
+    ///
+    /// The shader, texture and blend mode of \a states are used
+    /// as the sort key. Drawables that use their own texture
+    /// (sf::Sprite, sf::Shape, sf::Text) override the texture of
+    /// the render states when they are drawn, so it is safe to
+    /// pass their texture in \a states to sort them by texture.
+    ///
+    /// \param drawable Object to draw
+    /// \param states   Render states to use for drawing
+    /// \param layer    Layer of the draw, lower layers are drawn first
+    /// \param depth    Depth of the draw within its layer, lower depths are drawn first among draws with identical states
+    ///
+    ////////////////////////////////////////////////////////////
+    void submit(const Drawable&     drawable,
+                const RenderStates& states = RenderStates::Default,
+                int                 layer  = 0,
+                float               depth  = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit primitives defined by an array of vertices to the queue
+    ///
+    /// The vertices are copied into the queue, the array can be
+    /// modified or destroyed right after the call.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param layer       Layer of the draw, lower layers are drawn first
+    /// \param depth       Depth of the draw within its layer, lower depths are drawn first among draws with identical states
+    ///
+    ////////////////////////////////////////////////////////////
+    void submit(const Vertex*       vertices,
+                std::size_t         vertexCount,
+                PrimitiveType       type,
+                const RenderStates& states = RenderStates::Default,
+                int                 layer  = 0,
+                float               depth  = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose whether a layer keeps the submission order
+    ///
+    /// By default, the draws of a layer are sorted by shader,
+    /// texture, blend mode and depth, in order to minimize the
+    /// number of state changes. Layers that rely on the painter's
+    /// algorithm (overlapping translucent elements, UI, ...) can
+    /// instead be drawn in the order in which they were submitted.
+    ///
+    /// \param layer     Layer to configure
+    /// \param preserved True to draw the layer in submission order, false to sort it by state
+    ///
+    /// \see isSubmissionOrderPreserved
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSubmissionOrderPreserved(int layer, bool preserved);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a layer keeps the submission order
+    ///
+    /// \param layer Layer to check
+    ///
+    /// \return True if the layer is drawn in submission order, false if it is sorted by state
+    ///
+    /// \see setSubmissionOrderPreserved
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSubmissionOrderPreserved(int layer) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the submitted draws
+    ///
+    /// This function doesn't deallocate the corresponding
+    /// memory, so that filling the queue again for the next
+    /// frame doesn't involve reallocating all the memory.
+    /// The layer settings are kept.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of draws submitted to the queue
+    ///
+    /// \return Number of submitted draws
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSubmissionCount() const;
+
+private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the submitted draws to a render target, in sorted order
+    ///
+    /// \param target Render target to draw to
+    /// \param states Render states combined with the submitted ones
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(RenderTarget& target, const RenderStates& states) const override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sort the submitted draws, if not already done
+    ///
+    ////////////////////////////////////////////////////////////
+    void sort() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Single submitted draw
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Submission
+    {
+        const Drawable* drawable;    //!< Drawable to draw, or null for vertices
+        std::size_t     firstVertex; //!< Index of the first vertex of vertex draws
+        std::size_t     vertexCount; //!< Number of vertices of vertex draws
+        PrimitiveType   type;        //!< Primitive type of vertex draws
+        RenderStates    states;      //!< Render states of the draw
+        int             layer;       //!< Layer of the draw
+        float           depth;       //!< Depth of the draw within its layer
+        std::size_t     blendIndex;  //!< Index of the blend mode in the list of distinct blend modes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a new submission to the queue
+    ///
+    /// \param states Render states of the draw
+    /// \param layer  Layer of the draw
+    /// \param depth  Depth of the draw within its layer
+    ///
+    /// \return Reference to the new submission
+    ///
+    ////////////////////////////////////////////////////////////
+    Submission& addSubmission(const RenderStates& states, int layer, float depth);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Submission>          m_submissions;     //!< Submitted draws, in submission order
+    std::vector<Vertex>              m_vertices;        //!< Copies of the vertices of vertex draws
+    std::vector<BlendMode>           m_blendModes;      //!< Distinct blend modes used by the submitted draws
+    std::vector<int>                 m_orderedLayers;   //!< Layers drawn in submission order
+    mutable std::vector<std::size_t> m_order;           //!< Indices of the submitted draws, in drawing order
+    mutable bool                     m_orderNeedUpdate; //!< Do the draws need to be sorted again?
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderQueue
+/// \ingroup graphics
+///
+/// sf::RenderQueue collects draws during a frame and emits them
+/// in an order that minimizes the number of shader, texture and
+/// blend mode switches performed by the render target.
+///
+/// Each submission has a layer and a depth. Layers are always
+/// drawn in increasing order. Within a layer, draws are sorted
+/// by shader, then texture, then blend mode, then depth; draws
+/// with identical keys keep their submission order. Layers for
+/// which setSubmissionOrderPreserved was called are not sorted
+/// at all, which is required whenever overlapping elements must
+/// be drawn in a specific order.
+///
+/// The queue is emitted by drawing it on a render target. Combined
+/// with batching (see sf::RenderTarget::setBatchingEnabled), the
+/// consecutive draws that share the same states are merged
+/// into a single draw call.
+///
+/// Usage example:
+/// \code
+/// sf::RenderQueue queue;
+/// queue.setSubmissionOrderPreserved(UiLayer, true);
+///
+/// // Pass the texture of the sprites so that they are grouped by atlas
+/// for (const Unit& unit : units)
+///     queue.submit(unit.sprite, sf::RenderStates(unit.sprite.getTexture()), UnitLayer);
+///
+/// queue.submit(healthBar, sf::RenderStates::Default, UiLayer);
+///
+/// window.draw(queue);
+/// queue.clear();
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::RenderCommandList
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RENDERSTATISTICS_HPP
+#define SFML_RENDERSTATISTICS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+#include <SFML/Config.hpp>
+
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Structure holding the rendering counters of a frame
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderStatistics
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// All the counters are set to zero.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderStatistics() :
+    drawCalls(0),
+    vertices(0),
+    textureBinds(0),
+    shaderBinds(0),
+    blendModeChanges(0),
+    viewChanges(0),
+    vertexCacheHits(0),
+    vertexCacheMisses(0),
+    culledDraws(0),
+    textureUploadBytes(0),
+    bufferUploadBytes(0)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t drawCalls;          //!< Number of OpenGL draw calls
+    std::size_t vertices;           //!< Number of vertices (or indices, for indexed draws) submitted
+    std::size_t textureBinds;       //!< Number of texture bindings, including unbinds
+    std::size_t shaderBinds;        //!< Number of shader bindings, including unbinds
+    std::size_t blendModeChanges;   //!< Number of blend mode changes
+    std::size_t viewChanges;        //!< Number of times the view (viewport and projection) was applied
+    std::size_t vertexCacheHits;    //!< Number of vertex array draws small enough to be pre-transformed
+    std::size_t vertexCacheMisses;  //!< Number of vertex array draws too large to be pre-transformed
+    std::size_t culledDraws;        //!< Number of drawables skipped because they were outside the view or the repaint area
+    Uint64      textureUploadBytes; //!< Number of bytes uploaded to textures
+    Uint64      bufferUploadBytes;  //!< Number of bytes uploaded to vertex and index buffers
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERSTATISTICS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderStatistics
+/// \ingroup graphics
+///
+/// sf::RenderStatistics gathers the counters collected by a
+/// render target during a frame, see
+/// sf::RenderTarget::setStatisticsEnabled.
+///
+/// Draw, binding and state counters only include the work done
+/// by the render target that reports them. Texture and buffer
+/// uploads are not tied to a render target: the upload counters
+/// include all the uploads done by the process, on any thread,
+/// during the frame of the reporting target.
+///
+/// Usage example:
+/// \code
+/// window.setStatisticsEnabled(true);
+///
+/// // ... draw and display the frame ...
+///
+/// const sf::RenderStatistics& statistics = window.getStatistics();
+/// std::cout << statistics.drawCalls << " draw calls, "
+///           << statistics.textureBinds << " texture binds" << std::endl;
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
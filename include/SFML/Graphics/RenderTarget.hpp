@@ -32,19 +32,33 @@
 
 #include <SFML/Graphics/BlendMode.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/GpuProfileZone.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderStatistics.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/IndexBuffer.hpp>
 #include <SFML/Graphics/View.hpp>
 
 #include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 
 namespace sf
 {
+namespace priv
+{
+class GpuProfiler;
+class VertexStream;
+}
+
 class Drawable;
+class Shader;
+class Texture;
 class VertexBuffer;
 class Transform;
 
@@ -294,6 +308,242 @@ public:
     void draw(const VertexBuffer& vertexBuffer,const IndexBuffer& indexBuffer, std::size_t indexCount, const RenderStates& states = RenderStates::Default);
 
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic batching of draw calls
+    ///
+    /// When batching is enabled, vertices passed to
+    /// draw(const Vertex*, ...) are not submitted immediately.
+    /// They are pre-transformed and accumulated in a CPU buffer
+    /// for as long as consecutive draws use the same texture,
+    /// shader and blend mode, and are then rendered with a
+    /// single OpenGL draw call. Strips and fans are converted to
+    /// their list equivalent so that they can be merged as well.
+    ///
+    /// The pending batch is flushed automatically when the
+    /// render states change, and by setView, clear, display,
+    /// pushGLStates, popGLStates, resetGLStates and any draw
+    /// that bypasses the batch (e.g. vertex buffers).
+    ///
+    /// Since rendering is deferred, textures and shaders used
+    /// by a batched draw must stay alive and unchanged until
+    /// the batch is flushed. If you modify a shader parameter
+    /// between two draws that use the same shader, or read back
+    /// the contents of the target yourself, call flush() first.
+    ///
+    /// Batching is disabled by default.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic batching of draw calls is enabled
+    ///
+    /// \return True if batching is enabled, false otherwise
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit the pending batch of draw calls, if any
+    ///
+    /// This function does nothing if batching is disabled or
+    /// if no draw is currently pending.
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of batches submitted during the last frame
+    ///
+    /// A frame ends every time display() is called on the
+    /// render window or render texture. This value can be
+    /// used to check that batching is effective: ideally it
+    /// matches the number of texture/shader/blend mode changes
+    /// in the frame rather than the number of draw calls.
+    ///
+    /// \return Number of batches flushed during the last complete frame
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBatchFlushCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the collection of rendering statistics
+    ///
+    /// When enabled, the render target counts its draw calls,
+    /// submitted vertices, state changes and the bytes uploaded
+    /// to textures and buffers, and makes the counters of the
+    /// last complete frame available through getStatistics().
+    /// When disabled, the counters are not updated, the only
+    /// cost left is a test of this flag.
+    ///
+    /// Statistics are disabled by default.
+    ///
+    /// \param enabled True to enable statistics, false to disable them
+    ///
+    /// \see isStatisticsEnabled, getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStatisticsEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the collection of rendering statistics is enabled
+    ///
+    /// \return True if statistics are enabled, false otherwise
+    ///
+    /// \see setStatisticsEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isStatisticsEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rendering statistics of the last frame
+    ///
+    /// A frame ends every time display() is called on the
+    /// render window or render texture. The returned counters
+    /// are all zero until a frame has been completed with
+    /// statistics enabled.
+    ///
+    /// \return Counters of the last complete frame
+    ///
+    /// \see setStatisticsEnabled, resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    const RenderStatistics& getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the counters of the current frame
+    ///
+    /// The counters are reset automatically at the end of each
+    /// frame. This function can be used to exclude work done
+    /// at the beginning of a frame (loading, uploads, ...) from
+    /// the statistics.
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable view culling of drawables
+    ///
+    /// When culling is enabled, draw(const Drawable&, ...)
+    /// skips the drawables whose bounds don't intersect the
+    /// area visible through the current view. Only drawables
+    /// that provide their bounds are culled: sf::Sprite,
+    /// sf::Shape, sf::Text, sf::VertexArray and sf::SpriteBatch,
+    /// as well as custom drawables that override
+    /// Drawable::getCullingBounds. Other drawables are always
+    /// drawn, but the drawables they draw can still be culled.
+    ///
+    /// Culling relies on the bounds computed on the CPU: it must
+    /// be disabled if a shader moves vertices outside of them.
+    ///
+    /// Culling is disabled by default.
+    ///
+    /// \param enabled True to enable culling, false to disable it
+    ///
+    /// \see isCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCullingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether view culling of drawables is enabled
+    ///
+    /// \return True if culling is enabled, false otherwise
+    ///
+    /// \see setCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCullingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable damage tracking
+    ///
+    /// When damage tracking is enabled, only the regions marked
+    /// dirty with markDirty are repainted: clear() and all draws
+    /// are clipped to the smallest rectangle that contains them,
+    /// and drawables that provide their bounds (see
+    /// setCullingEnabled) are skipped when they are outside of it.
+    /// The rest of the target keeps the contents of the previous
+    /// frames, which saves most of the rasterization cost when
+    /// only small parts of the scene change.
+    ///
+    /// The contents of a render window are only preserved
+    /// between frames when the platform reports the age of its
+    /// back buffer (EGL_EXT_buffer_age, GLX_EXT_buffer_age),
+    /// the whole window is repainted every frame otherwise. When
+    /// EGL_KHR_swap_buffers_with_damage is available, the
+    /// windowing system is also told which region changed.
+    ///
+    /// Enabling damage tracking marks the whole target dirty.
+    /// While it is enabled, the OpenGL scissor test is used by
+    /// the render target; it is left untouched otherwise.
+    ///
+    /// Damage tracking is disabled by default.
+    ///
+    /// \param enabled True to enable damage tracking, false to disable it
+    ///
+    /// \see isDamageTrackingEnabled, markDirty
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDamageTrackingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether damage tracking is enabled
+    ///
+    /// \return True if damage tracking is enabled, false otherwise
+    ///
+    /// \see setDamageTrackingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDamageTrackingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a region of the target as dirty
+    ///
+    /// The region is repainted during the current frame. Regions
+    /// must be marked before the frame is drawn (before clear()),
+    /// typically for both the previous and the new location of
+    /// everything that moved or changed since the last frame.
+    ///
+    /// This function does nothing if damage tracking is disabled.
+    ///
+    /// \param region Dirty region, in pixels
+    ///
+    /// \see setDamageTrackingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void markDirty(const IntRect& region);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the region covered by a drawable as dirty
+    ///
+    /// The region is computed from the bounds of the drawable
+    /// (see setCullingEnabled), transformed by \a states and
+    /// the current view. Drawables that don't provide their
+    /// bounds mark the whole target dirty.
+    ///
+    /// This function does nothing if damage tracking is disabled.
+    ///
+    /// \param drawable Object whose area is dirty
+    /// \param states   Render states that the drawable is drawn with
+    ///
+    /// \see setDamageTrackingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void markDirty(const Drawable& drawable, const RenderStates& states = RenderStates::Default);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -416,13 +666,70 @@ protected:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Performs the common step at the end of a frame
+    ///
+    /// The derived classes must call this function when the
+    /// contents of the target are about to be presented or
+    /// used, typically at the beginning of display().
+    ///
+    ////////////////////////////////////////////////////////////
+    void endFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the region of the target changed by the current frame
+    ///
+    /// \return Region marked dirty during the current frame, in pixels,
+    ///         or std::nullopt if damage tracking is disabled or nothing changed
+    ///
+    ////////////////////////////////////////////////////////////
+    std::optional<IntRect> getFrameDamage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the contents of the target
+    ///
+    /// The age is the number of frames since the current contents
+    /// of the target were presented: 1 if it contains the previous
+    /// frame, 2 if it contains the frame before, etc. 0 means that
+    /// its contents are undefined, which is what the default
+    /// implementation returns.
+    ///
+    /// \return Age of the contents, in frames
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getBackBufferAge() const;
+
 private:
+    friend class GpuProfileZone;
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
     ////////////////////////////////////////////////////////////
     void applyCurrentView();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives immediately, bypassing the batch
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawImmediate(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append primitives to the pending batch
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendToBatch(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new blending mode
     ///
@@ -485,6 +792,68 @@ private:
     ////////////////////////////////////////////////////////////
     void cleanupDraw(const RenderStates& states);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the repaint area of the current frame, if not done yet
+    ///
+    /// Does nothing if damage tracking is disabled.
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateRepaintArea();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the repaint area of the frame if needed, and apply the scissor
+    ///
+    /// The scissor is only touched by targets that enabled it:
+    /// when damage tracking is turned off, the scissor test is
+    /// disabled once, and left to the application afterwards.
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyDamage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the region of the target that is repainted during the current frame
+    ///
+    /// \return Repaint area, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getRepaintArea() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a rectangle from world coordinates to pixels, using the current view
+    ///
+    /// \param rectangle Rectangle in world coordinates
+    ///
+    /// \return Smallest pixel rectangle that covers the rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect mapRectToPixels(const FloatRect& rectangle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Begin a profile zone
+    ///
+    /// \param name Name of the zone
+    ///
+    /// \return Identifier of the zone
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t beginProfileZone(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End a profile zone
+    ///
+    /// \param zone Identifier of the zone returned by beginProfileZone
+    ///
+    ////////////////////////////////////////////////////////////
+    void endProfileZone(std::size_t zone);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timings of the latest resolved frame
+    ///
+    /// \return Timings of the profile zones of the frame
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<GpuProfileZone::Result>& getProfileResults() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Render states cache
     ///
@@ -506,13 +875,80 @@ private:
         Vertex    vertexCache[VertexCacheSize]; //!< Pre-transformed vertices cache
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pending batch of pre-transformed vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        bool                enabled;        //!< Is batching enabled?
+        PrimitiveType       type;           //!< Primitive type of the batch (Points, Lines or Triangles)
+        BlendMode           blendMode;      //!< Blending mode shared by the batched draws
+        const Texture*      texture;        //!< Texture shared by the batched draws
+        Uint64              textureId;      //!< Cache identifier of the texture when the batch was started
+        const Shader*       shader;         //!< Shader shared by the batched draws
+        std::vector<Vertex> vertices;       //!< Pre-transformed vertices waiting to be drawn
+        std::size_t         flushCount;     //!< Number of batches flushed during the current frame
+        std::size_t         lastFlushCount; //!< Number of batches flushed during the last complete frame
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rendering statistics collected by the target
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        bool             enabled;            //!< Are statistics collected?
+        RenderStatistics current;            //!< Counters of the current frame
+        RenderStatistics last;               //!< Counters of the last complete frame
+        Uint64           textureUploadStart; //!< Global texture upload counter at the beginning of the frame
+        Uint64           bufferUploadStart;  //!< Global buffer upload counter at the beginning of the frame
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief View culling state
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Culling
+    {
+        bool      enabled;     //!< Is culling enabled?
+        bool      areaChanged; //!< Has the view changed since the visible area was computed?
+        FloatRect visibleArea; //!< Area visible through the current view, in world coordinates
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Damage tracking state
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Damage
+    {
+        enum
+        {
+            MaxHistory = 4 //!< Number of past frames whose damage is remembered
+        };
+
+        bool                 enabled;        //!< Is damage tracking enabled?
+        bool                 frameStarted;   //!< Has the repaint area of the current frame been computed?
+        bool                 scissorChanged; //!< Does the scissor need to be applied again?
+        bool                 scissorApplied; //!< Has the scissor test been enabled by this target?
+        IntRect              current;        //!< Region marked dirty during the current frame
+        IntRect              previous;       //!< Region of the past frames missing from the back buffer
+        std::vector<IntRect> history;        //!< Regions marked dirty during the past frames, most recent first
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; //!< Default view
-    View        m_view;        //!< Current view
-    StatesCache m_cache;       //!< Render states cache
-    Uint64      m_id;          //!< Unique number that identifies the RenderTarget
+    View                                m_defaultView;  //!< Default view
+    View                                m_view;         //!< Current view
+    StatesCache                         m_cache;        //!< Render states cache
+    Batch                               m_batch;        //!< Pending batch of draw calls
+    Statistics                          m_statistics;   //!< Rendering statistics
+    Culling                             m_culling;      //!< View culling state
+    Damage                              m_damage;       //!< Damage tracking state
+    std::unique_ptr<priv::GpuProfiler>  m_profiler;     //!< Profile zones of the target, created on first use
+    std::unique_ptr<priv::VertexStream> m_vertexStream; //!< Ring buffer for draws too large for the vertex cache, created on first use
+    Uint64                              m_id;           //!< Unique number that identifies the RenderTarget
 };
 
 } // namespace sf
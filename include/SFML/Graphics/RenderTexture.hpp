@@ -181,6 +181,8 @@ public:
     /// has been drawn so far. Like for windows, calling this
     /// function is mandatory at the end of rendering. Not calling
     /// it may leave the texture in an undefined state.
+    /// Any draw call still pending in the batch (see
+    /// RenderTarget::setBatchingEnabled) is submitted first.
     ///
     ////////////////////////////////////////////////////////////
     void display();
@@ -225,6 +227,14 @@ public:
     const Texture& getTexture() const;
 
 private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the contents of the render-texture
+    ///
+    /// \return Always 1, the contents of a render-texture are preserved between frames
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBackBufferAge() const override;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
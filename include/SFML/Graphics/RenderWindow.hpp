@@ -142,6 +142,19 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] bool setActive(bool active = true) override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Display on screen what has been rendered to the window so far
+    ///
+    /// This function is typically called after all OpenGL rendering
+    /// has been done for the current frame, in order to show
+    /// it on screen. Any draw call still pending in the batch
+    /// (see RenderTarget::setBatchingEnabled) is submitted first.
+    /// When damage tracking is enabled, the windowing system is
+    /// told which region of the window changed, if supported.
+    ///
+    ////////////////////////////////////////////////////////////
+    void display() override;
+
 protected:
     ////////////////////////////////////////////////////////////
     /// \brief Function called after the window has been created
@@ -162,7 +175,24 @@ protected:
     ////////////////////////////////////////////////////////////
     void onResize() override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the contents of the window are read back
+    ///
+    /// Submits the draw calls still pending in the batch, so
+    /// that the contents which are read contain them.
+    ///
+    ////////////////////////////////////////////////////////////
+    void onBeforeRead() const override;
+
 private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the back buffer of the window
+    ///
+    /// \return Age of the back buffer in frames, 0 if its contents are undefined
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBackBufferAge() const override;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
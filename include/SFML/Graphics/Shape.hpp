@@ -276,6 +276,14 @@ private:
     ////////////////////////////////////////////////////////////
     void draw(RenderTarget& target, const RenderStates& states) const override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the shape
+    ///
+    /// \return Global bounds of the shape
+    ///
+    ////////////////////////////////////////////////////////////
+    std::optional<FloatRect> getCullingBounds() const override;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the fill vertices' color
     ///
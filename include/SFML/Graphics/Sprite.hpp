@@ -199,6 +199,14 @@ private:
     ////////////////////////////////////////////////////////////
     void draw(RenderTarget& target, const RenderStates& states) const override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the sprite
+    ///
+    /// \return Global bounds of the sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    std::optional<FloatRect> getCullingBounds() const override;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the vertices' positions
     ///
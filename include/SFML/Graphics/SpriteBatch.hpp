@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SPRITEBATCH_HPP
+#define SFML_SPRITEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/Angle.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Large set of sprites sharing the same texture,
+///        drawn with a single draw call
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpriteBatch : public Drawable
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Per-sprite data of a batch
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Instance
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an instance at the origin, with no rotation,
+        /// a scale of 1, an empty texture rectangle and a white color.
+        ///
+        ////////////////////////////////////////////////////////////
+        Instance();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the instance from its texture rectangle and position
+        ///
+        /// \param thePosition    Position of the instance
+        /// \param theTextureRect Sub-rectangle of the texture to display
+        /// \param theColor       Global color of the instance
+        ///
+        ////////////////////////////////////////////////////////////
+        Instance(const Vector2f& thePosition, const IntRect& theTextureRect, const Color& theColor = Color::White);
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Vector2f position;    //!< Position of the instance
+        Vector2f origin;      //!< Local origin of the instance, used for rotation and scaling
+        Angle    rotation;    //!< Orientation of the instance
+        Vector2f scale;       //!< Scale factors of the instance
+        IntRect  textureRect; //!< Sub-rectangle of the texture to display
+        Color    color;       //!< Global color of the instance
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch with no texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the batch from a texture
+    ///
+    /// \param texture Texture shared by all the instances
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpriteBatch(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the texture shared by all the instances
+    ///
+    /// The \a texture argument refers to a texture that must
+    /// exist as long as the batch uses it. Indeed, the batch
+    /// doesn't store its own copy of the texture, but rather keeps
+    /// a pointer to the one that you passed to this function.
+    ///
+    /// \param texture New texture
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture shared by all the instances
+    ///
+    /// \return Pointer to the texture, or null if no texture was set
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of instances in the batch
+    ///
+    /// \return Number of instances
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getInstanceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the batch
+    ///
+    /// If \a instanceCount is greater than the current size, the
+    /// new instances are default-constructed (and thus invisible
+    /// until they are given a texture rectangle).
+    /// If \a instanceCount is less than the current size, the
+    /// last instances are removed from the batch.
+    ///
+    /// \param instanceCount New number of instances
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(std::size_t instanceCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the instances of the batch
+    ///
+    /// This function doesn't deallocate the corresponding
+    /// memory, so that adding new instances after clearing
+    /// doesn't involve reallocating all the memory.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an instance to the batch
+    ///
+    /// \param instance Instance to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const Instance& instance);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a single instance of the batch
+    ///
+    /// Only the vertices of the modified instance are
+    /// uploaded to the graphics card the next time the
+    /// batch is drawn.
+    ///
+    /// \param index    Index of the instance to change
+    /// \param instance New value of the instance
+    ///
+    /// \see getInstance, setInstances
+    ///
+    ////////////////////////////////////////////////////////////
+    void setInstance(std::size_t index, const Instance& instance);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a contiguous range of instances of the batch
+    ///
+    /// Only the vertices of the modified range are uploaded
+    /// to the graphics card the next time the batch is drawn,
+    /// the rest of the batch stays untouched in graphics memory.
+    /// The range must lie inside the batch.
+    ///
+    /// \param first     Index of the first instance to change
+    /// \param instances Pointer to the new instances
+    /// \param count     Number of instances to change
+    ///
+    /// \see setInstance
+    ///
+    ////////////////////////////////////////////////////////////
+    void setInstances(std::size_t first, const Instance* instances, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an instance of the batch
+    ///
+    /// \param index Index of the instance to get
+    ///
+    /// \return Const reference to the index-th instance
+    ///
+    /// \see setInstance
+    ///
+    ////////////////////////////////////////////////////////////
+    const Instance& getInstance(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the vertices of the batch
+    ///
+    /// Each instance is drawn as two triangles, whose 6 vertices
+    /// start at index 6 * instance in the returned array. They
+    /// are computed when the instances are modified, in the
+    /// local coordinates of the batch.
+    ///
+    /// \return Pointer to the 6 * getInstanceCount() vertices of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vertex* getVertices() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the bounding rectangle of the batch
+    ///
+    /// This function returns the minimal axis-aligned rectangle
+    /// that contains all the instances of the batch. It is only
+    /// computed again after the instances have been modified.
+    ///
+    /// \return Bounding rectangle of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getBounds() const;
+
+private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(RenderTarget& target, const RenderStates& states) const override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the batch
+    ///
+    /// \return Bounds of the instances
+    ///
+    ////////////////////////////////////////////////////////////
+    std::optional<FloatRect> getCullingBounds() const override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the vertices of a single instance
+    ///
+    /// \param index Index of the instance to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateVertices(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a range of instances as needing an upload
+    ///
+    /// The bounds of the batch are also marked as outdated.
+    ///
+    /// \param first Index of the first modified instance
+    /// \param count Number of modified instances
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate(std::size_t first, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the modified vertices to the vertex buffer
+    ///
+    /// \return True if the vertex buffer is ready for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    bool uploadVertices() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Texture*                      m_texture;          //!< Texture shared by all the instances
+    std::vector<Instance>               m_instances;        //!< Instances of the batch
+    std::vector<Vertex>                 m_vertices;         //!< Vertices of the batch, 6 per instance
+    mutable std::optional<VertexBuffer> m_vertexBuffer;     //!< Graphics memory copy of the vertices, created when drawn
+    mutable std::size_t                 m_dirtyBegin;       //!< First instance not yet uploaded
+    mutable std::size_t                 m_dirtyEnd;         //!< One past the last instance not yet uploaded
+    mutable FloatRect                   m_bounds;           //!< Bounding rectangle of the instances
+    mutable bool                        m_boundsNeedUpdate; //!< Do the bounds need to be computed again?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpriteBatch
+/// \ingroup graphics
+///
+/// sf::SpriteBatch draws thousands of textured quads sharing
+/// the same texture with a single draw call. Each instance
+/// has its own position, origin, rotation, scale, texture
+/// rectangle and color, just like a sf::Sprite, but without
+/// the cost of a separate draw call and transform per sprite.
+///
+/// The vertices of the instances are computed on the CPU when
+/// the instances are modified, and are streamed into a
+/// persistent sf::VertexBuffer the next time the batch is drawn.
+/// Only the range of instances that changed since the last draw
+/// is re-uploaded, so the static parts of a batch don't cost
+/// any bandwidth. If vertex buffers are not available, the
+/// vertices are drawn directly from system memory instead.
+///
+/// Like sf::VertexArray, the batch is not transformable as a
+/// whole: you can pass a transform in the render states when
+/// drawing it.
+///
+/// Usage example:
+/// \code
+/// sf::SpriteBatch particles(texture);
+///
+/// for (const Particle& particle : field)
+///     particles.append(sf::SpriteBatch::Instance(particle.position, particle.frame));
+///
+/// ...
+///
+/// // Only the vertices of the moved particle will be uploaded again
+/// sf::SpriteBatch::Instance instance = particles.getInstance(42);
+/// instance.position += velocity * dt;
+/// particles.setInstance(42, instance);
+///
+/// window.draw(particles);
+/// \endcode
+///
+/// \see sf::Sprite, sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
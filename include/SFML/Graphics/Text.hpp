@@ -416,6 +416,14 @@ private:
     ////////////////////////////////////////////////////////////
     void draw(RenderTarget& target, const RenderStates& states) const override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the text
+    ///
+    /// \return Global bounds of the text
+    ///
+    ////////////////////////////////////////////////////////////
+    std::optional<FloatRect> getCullingBounds() const override;
+
     ////////////////////////////////////////////////////////////
     /// \brief Make sure the text's geometry is updated
     ///
@@ -428,20 +436,23 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    String              m_string;              //!< String to display
-    const Font*         m_font;                //!< Font used to display the string
-    unsigned int        m_characterSize;       //!< Base size of characters, in pixels
-    float               m_letterSpacingFactor; //!< Spacing factor between letters
-    float               m_lineSpacingFactor;   //!< Spacing factor between lines
-    Uint32              m_style;               //!< Text style (see Style enum)
-    Color               m_fillColor;           //!< Text fill color
-    Color               m_outlineColor;        //!< Text outline color
-    float               m_outlineThickness;    //!< Thickness of the text's outline
-    mutable VertexArray m_vertices;            //!< Vertex array containing the fill geometry
-    mutable VertexArray m_outlineVertices;     //!< Vertex array containing the outline geometry
-    mutable FloatRect   m_bounds;              //!< Bounding rectangle of the text (in local coordinates)
-    mutable bool        m_geometryNeedUpdate;  //!< Does the geometry need to be recomputed?
-    mutable Uint64      m_fontTextureId;       //!< The font texture id
+    String                           m_string;              //!< String to display
+    const Font*                      m_font;                //!< Font used to display the string
+    unsigned int                     m_characterSize;       //!< Base size of characters, in pixels
+    float                            m_letterSpacingFactor; //!< Spacing factor between letters
+    float                            m_lineSpacingFactor;   //!< Spacing factor between lines
+    Uint32                           m_style;               //!< Text style (see Style enum)
+    Color                            m_fillColor;           //!< Text fill color
+    Color                            m_outlineColor;        //!< Text outline color
+    float                            m_outlineThickness;    //!< Thickness of the text's outline
+    mutable VertexArray              m_vertices;            //!< Vertex array containing the fill geometry
+    mutable VertexArray              m_outlineVertices;     //!< Vertex array containing the outline geometry
+    mutable FloatRect                m_bounds;              //!< Bounding rectangle of the text (in local coordinates)
+    mutable bool                     m_geometryNeedUpdate;  //!< Does the geometry need to be recomputed?
+    mutable Uint64                   m_fontTextureId;       //!< The font texture id
+    mutable std::vector<std::size_t> m_vertexCounts;        //!< Number of fill vertices per font texture
+    mutable std::vector<std::size_t> m_outlineVertexCounts; //!< Number of outline vertices per font texture
+    mutable bool                     m_usesDistanceField;   //!< Is the geometry made of distance field glyphs?
 };
 
 } // namespace sf
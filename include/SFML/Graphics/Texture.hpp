@@ -30,10 +30,15 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 
+#include <SFML/Graphics/PixelFormat.hpp>
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/TextureReadback.hpp>
+#include <SFML/Graphics/TextureUpload.hpp>
 #include <SFML/Window/GlResource.hpp>
 
 #include <filesystem>
+#include <memory>
+#include <vector>
 
 
 namespace sf
@@ -44,6 +49,14 @@ class RenderTexture;
 class Text;
 class Window;
 class Image;
+class TextureCache;
+
+namespace priv
+{
+class PixelBufferPool;
+struct TextureCacheEntry;
+struct TextureCacheImpl;
+} // namespace priv
 
 ////////////////////////////////////////////////////////////
 /// \brief Image living on the graphics card that can be used for drawing
@@ -88,14 +101,25 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Create the texture
     ///
+    /// The pixel format defines how the texture is stored in
+    /// video memory; compact formats such as sf::R8 use less
+    /// memory and upload bandwidth than sf::RGBA8. The texture
+    /// is sampled like OpenGL samples its format: missing
+    /// components read as 0 (green, blue) or 1 (alpha).
+    /// Automatic sRGB conversion (see setSrgb) only applies
+    /// to sf::RGBA8 textures.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
-    /// \param size Width and height of the texture
+    /// \param size   Width and height of the texture
+    /// \param format Pixel format of the texture
     ///
     /// \return True if creation was successful
     ///
+    /// \see isPixelFormatAvailable
+    ///
     ////////////////////////////////////////////////////////////
-    [[nodiscard]] bool create(const Vector2u& size);
+    [[nodiscard]] bool create(const Vector2u& size, PixelFormat format = RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the texture from a file on disk
@@ -116,6 +140,13 @@ public:
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
+    /// KTX, KTX2 and DDS files compressed with BC1 to BC5, BC7,
+    /// ETC1 or ETC2 are uploaded as is, with their mipmaps, when
+    /// the graphics driver supports their format; they are
+    /// decompressed first otherwise, or when \a area is not empty.
+    /// Textures stored compressed can't be modified by the update
+    /// functions.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param filename Path of the image file to load
@@ -147,6 +178,13 @@ public:
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
+    /// KTX, KTX2 and DDS files compressed with BC1 to BC5, BC7,
+    /// ETC1 or ETC2 are uploaded as is, with their mipmaps, when
+    /// the graphics driver supports their format; they are
+    /// decompressed first otherwise, or when \a area is not empty.
+    /// Textures stored compressed can't be modified by the update
+    /// functions.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param data Pointer to the file data in memory
@@ -179,6 +217,13 @@ public:
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
+    /// KTX, KTX2 and DDS files compressed with BC1 to BC5, BC7,
+    /// ETC1 or ETC2 are uploaded as is, with their mipmaps, when
+    /// the graphics driver supports their format; they are
+    /// decompressed first otherwise, or when \a area is not empty.
+    /// Textures stored compressed can't be modified by the update
+    /// functions.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param stream Source stream to read from
@@ -223,6 +268,16 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the pixel format of the texture
+    ///
+    /// \return Format in which the texture is stored
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelFormat getPixelFormat() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the texture pixels to an image
     ///
@@ -233,11 +288,27 @@ public:
     ///
     /// \return Image containing the texture's pixels
     ///
-    /// \see loadFromImage
+    /// \see loadFromImage, copyToImageAsync
     ///
     ////////////////////////////////////////////////////////////
     Image copyToImage() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying the texture pixels to an image, without waiting
+    ///
+    /// The pixels are transferred to a pixel buffer object in the
+    /// background; the returned readback tells when they have
+    /// arrived and copies them to an image. If asynchronous
+    /// readbacks are not supported (see TextureReadback::isAvailable),
+    /// the pixels are copied right away by copyToImage.
+    ///
+    /// \return Readback of the texture's pixels, empty if the texture was not created
+    ///
+    /// \see copyToImage, sf::TextureReadback
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] TextureReadback copyToImageAsync() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the whole texture from an array of pixels
     ///
@@ -276,6 +347,50 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Uint8* pixels, const Vector2u& size, const Vector2u& dest);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the whole texture from an array of pixels of any format
+    ///
+    /// The \a pixel array is assumed to have the same size as
+    /// the texture, and to use the given \a format. Pixels that
+    /// use the format of the texture are uploaded directly,
+    /// others are converted first.
+    ///
+    /// No additional check is performed on the size of the pixel
+    /// array, passing invalid arguments will lead to an undefined
+    /// behavior.
+    ///
+    /// This function does nothing if \a pixels is null or if the
+    /// texture was not previously created.
+    ///
+    /// \param pixels Array of pixels to copy to the texture
+    /// \param format Format of the pixels in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const void* pixels, PixelFormat format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from an array of pixels of any format
+    ///
+    /// The size of the \a pixel array must match the \a size
+    /// argument, and it must use the given \a format. Pixels that
+    /// use the format of the texture are uploaded directly,
+    /// others are converted first.
+    ///
+    /// No additional check is performed on the size of the pixel
+    /// array or the bounds of the area to update, passing invalid
+    /// arguments will lead to an undefined behavior.
+    ///
+    /// This function does nothing if \a pixels is null or if the
+    /// texture was not previously created.
+    ///
+    /// \param pixels Array of pixels to copy to the texture
+    /// \param format Format of the pixels in the array
+    /// \param size   Width and height of the pixel region contained in \a pixels
+    /// \param dest   Coordinates of the destination position
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const void* pixels, PixelFormat format, const Vector2u& size, const Vector2u& dest);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update a part of this texture from another texture
     ///
@@ -384,6 +499,48 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Window& window, const Vector2u& dest);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve staging memory for an asynchronous update of the texture
+    ///
+    /// The pixels of the returned upload can be written from any
+    /// thread, then update(TextureUpload&) transfers them to the
+    /// texture without waiting for the copy to complete. They
+    /// must be given in the pixel format of the texture.
+    ///
+    /// No additional check is performed on the size of the area,
+    /// passing an invalid combination of size and destination
+    /// will lead to an undefined behavior.
+    ///
+    /// The returned upload is empty if the texture was not
+    /// previously created or is stored with block compression.
+    ///
+    /// \param size Size of the area to update
+    /// \param dest Coordinates of the destination position
+    ///
+    /// \return Upload to fill and submit
+    ///
+    /// \see update(TextureUpload&), sf::TextureUpload
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] TextureUpload prepareUpdate(const Vector2u& size, const Vector2u& dest = Vector2u(0, 0));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start the transfer of an upload to the texture
+    ///
+    /// The copy is queued to the GPU and this function returns
+    /// without waiting for it; TextureUpload::isComplete tells
+    /// when it is done. The pixels of the upload can't be
+    /// written anymore once it is submitted.
+    ///
+    /// \param upload Upload prepared by prepareUpdate on this texture
+    ///
+    /// \return True if the transfer was started
+    ///
+    /// \see prepareUpdate
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(TextureUpload& upload);
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable the smooth filter
     ///
@@ -497,16 +654,35 @@ public:
     /// reason, this function will return false. Mipmap data is only valid from
     /// the time it is generated until the next time the base level image is
     /// modified, at which point this function will have to be called again to
-    /// regenerate it.
+    /// regenerate it. Textures stored compressed can't generate a mipmap, they
+    /// use the mipmaps of the file they were loaded from.
     ///
     /// \return True if mipmap generation was successful, false if unsuccessful
     ///
     ////////////////////////////////////////////////////////////
     [[nodiscard]] bool generateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an estimate of the video memory used by the texture
+    ///
+    /// The estimate is computed from the internal size of the
+    /// texture (including the padding added when non power of
+    /// two sizes are not supported), its format and its mipmap
+    /// levels. Drivers may allocate more memory than that.
+    ///
+    /// \return Video memory used by the texture, in bytes, 0 if it is empty
+    ///
+    /// \see sf::TextureCache
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Uint64 getMemoryUsage() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
+    /// If this texture belongs to a sf::TextureCache, it is
+    /// removed from it.
+    ///
     /// \param right Instance to assign
     ///
     /// \return Reference to self
@@ -517,6 +693,9 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Swap the contents of this texture with those of another
     ///
+    /// The membership in a sf::TextureCache is part of the
+    /// contents, it is swapped as well.
+    ///
     /// \param right Instance to swap with
     ///
     ////////////////////////////////////////////////////////////
@@ -579,10 +758,28 @@ public:
     ////////////////////////////////////////////////////////////
     static unsigned int getMaximumSize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether textures of a pixel format can be created
+    ///
+    /// sf::RGBA8 is always available. sf::RGB565 and sf::RGBA4444
+    /// require OpenGL 1.2 or OpenGL ES, sf::R8 and sf::RG8 require
+    /// OpenGL 3.0 or ARB_texture_rg, and sf::RGBA16F requires
+    /// OpenGL 3.0 or ARB_texture_float and ARB_half_float_pixel.
+    ///
+    /// \param format Pixel format to check
+    ///
+    /// \return True if textures of this format can be created
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isPixelFormatAvailable(PixelFormat format);
+
 private:
+    friend class Font;
     friend class Text;
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class TextureCache;
+    friend struct priv::TextureCacheImpl;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -599,6 +796,21 @@ private:
     ////////////////////////////////////////////////////////////
     static unsigned int getValidSize(unsigned int size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a KTX, KTX2 or DDS file in memory
+    ///
+    /// The compressed blocks are uploaded directly if possible,
+    /// and decompressed to an image otherwise.
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    /// \param area Area of the image to load
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool loadFromCompressedImage(const void* data, std::size_t size, const IntRect& area);
+
     ////////////////////////////////////////////////////////////
     /// \brief Invalidate the mipmap if one exists
     ///
@@ -608,19 +820,59 @@ private:
     ////////////////////////////////////////////////////////////
     void invalidateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the video memory of the texture
+    ///
+    /// The size, format and parameters of the texture are kept,
+    /// so that it can be created again with the same settings.
+    /// This function is for internal use by TextureCache.
+    ///
+    ////////////////////////////////////////////////////////////
+    void evict();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Area of the texture to update with RGBA pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Area
+    {
+        const Uint8* pixels; //!< Pixels to write, row by row without padding
+        Vector2u     size;   //!< Size of the area, in pixels
+        Vector2u     dest;   //!< Position of the area in the texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update several areas of the texture at once
+    ///
+    /// This is equivalent to calling update for each area, but
+    /// the texture is bound and OpenGL is flushed only once.
+    /// This function is mainly for internal use by Font.
+    ///
+    /// \param areas Areas to update, with their RGBA pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const std::vector<Area>& areas);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u     m_size;          //!< Public texture size
-    Vector2u     m_actualSize;    //!< Actual texture size (can be greater than public size because of padding)
-    unsigned int m_texture;       //!< Internal texture identifier
-    bool         m_isSmooth;      //!< Status of the smooth filter
-    bool         m_sRgb;          //!< Should the texture source be converted from sRGB?
-    bool         m_isRepeated;    //!< Is the texture in repeat mode?
-    mutable bool m_pixelsFlipped; //!< To work around the inconsistency in Y orientation
-    bool         m_fboAttachment; //!< Is this texture owned by a framebuffer object?
-    bool         m_hasMipmap;     //!< Has the mipmap been generated?
-    Uint64       m_cacheId;       //!< Unique number that identifies the texture to the render target's cache
+    Vector2u     m_size;           //!< Public texture size
+    Vector2u     m_actualSize;     //!< Actual texture size (can be greater than public size because of padding)
+    unsigned int m_texture;        //!< Internal texture identifier
+    bool         m_isSmooth;       //!< Status of the smooth filter
+    bool         m_sRgb;           //!< Should the texture source be converted from sRGB?
+    bool         m_isRepeated;     //!< Is the texture in repeat mode?
+    mutable bool m_pixelsFlipped;  //!< To work around the inconsistency in Y orientation
+    bool         m_fboAttachment;  //!< Is this texture owned by a framebuffer object?
+    bool         m_hasMipmap;      //!< Has the mipmap been generated?
+    Uint64       m_cacheId;        //!< Unique number that identifies the texture to the render target's cache
+    PixelFormat  m_format;         //!< Format in which the texture is stored
+    bool         m_isCompressed;   //!< Is the texture stored with block compression?
+    Uint64       m_compressedSize; //!< Size of the compressed mipmap levels, in bytes
+
+    std::shared_ptr<priv::PixelBufferPool>         m_uploadBuffers;   //!< Pixel buffers of the asynchronous updates
+    mutable std::shared_ptr<priv::PixelBufferPool> m_readbackBuffers; //!< Pixel buffers of the asynchronous readbacks
+    priv::TextureCacheEntry*                       m_cacheEntry;      //!< Entry in a texture cache, if any
 };
 
 } // namespace sf
@@ -663,10 +915,12 @@ private:
 /// store the collision information separately, for example in an array
 /// of booleans.
 ///
-/// Like sf::Image, sf::Texture can handle a unique internal
-/// representation of pixels, which is RGBA 32 bits. This means
-/// that a pixel must be composed of 8 bits red, green, blue and
-/// alpha channels -- just like a sf::Color.
+/// By default, sf::Texture stores pixels like sf::Image, as
+/// RGBA 32 bits: a pixel is composed of 8 bits red, green, blue
+/// and alpha channels -- just like a sf::Color. A more compact
+/// sf::PixelFormat can be chosen when creating the texture, for
+/// example sf::R8 for masks; the update functions convert the
+/// pixels that don't use the format of the texture.
 ///
 /// Usage example:
 /// \code
@@ -706,6 +960,12 @@ private:
 ///     sf::Uint8* pixels = ...; // get a fresh chunk of pixels (the next frame of a movie, for example)
 ///     texture.update(pixels);
 ///
+///     // or let a decoding thread write directly to the staging memory of an
+///     // asynchronous update, see sf::TextureUpload
+///     sf::TextureUpload upload = texture.prepareUpdate(texture.getSize());
+///     decoder.decodeFrame(upload.getPixels());
+///     texture.update(upload);
+///
 ///     // draw it
 ///     window.draw(sprite);
 ///
@@ -0,0 +1,242 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTUREATLAS_HPP
+#define SFML_TEXTUREATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+
+namespace sf
+{
+class Image;
+class Texture;
+
+namespace priv
+{
+struct TextureAtlasImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Packs images into shared textures at runtime
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureAtlas
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Location of an image in the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Region
+    {
+        const Texture* texture; //!< Page which contains the image
+        IntRect        rect;    //!< Area of the image in the page, in pixels
+        std::size_t    page;    //!< Index of the page which contains the image
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an empty atlas
+    ///
+    /// The padding is a transparent border which keeps images
+    /// apart, the extrusion repeats the edge pixels of the images
+    /// around them, so that smooth filtering doesn't blend them
+    /// with the padding.
+    ///
+    /// \param pageSize  Width and maximum height of the pages, in pixels
+    /// \param padding   Transparent border added around each image, in pixels
+    /// \param extrusion Number of times the edge pixels of each image are repeated around it
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextureAtlas(unsigned int pageSize = 2048, unsigned int padding = 1, unsigned int extrusion = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureAtlas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureAtlas(const TextureAtlas&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The pages keep their address, regions remain valid.
+    /// The moved-from atlas is left empty; if images are added
+    /// to it again, it uses the default settings.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureAtlas(TextureAtlas&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureAtlas& operator=(TextureAtlas&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image to the atlas
+    ///
+    /// The image is placed in the first page which has room for
+    /// it, a new page is created if none has. Only the pixels of
+    /// the image are uploaded: when a page has to grow, its
+    /// previous contents are copied by the graphics card if
+    /// framebuffer objects are supported. An error is written to
+    /// sf::err() if the image is empty, larger than a page, or if
+    /// the page texture can't be created.
+    ///
+    /// \param image Image to add
+    ///
+    /// \return Location of the image, or std::nullopt if it couldn't be added
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::optional<Region> add(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter of the pages
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter of the pages is enabled
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool isSmooth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of pages of the atlas
+    ///
+    /// \return Number of textures created so far
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::size_t getPageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a page of the atlas
+    ///
+    /// \param index Index of the page, must be lower than getPageCount()
+    ///
+    /// \return Texture of the page
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] const Texture& getPage(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the images and pages of the atlas
+    ///
+    /// The regions returned so far become invalid.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::unique_ptr<priv::TextureAtlasImpl> m_impl; //!< Settings, pages and their packers
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREATLAS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureAtlas
+/// \ingroup graphics
+///
+/// Each texture used for drawing has to be bound to the render
+/// target, which interrupts the batching of the draw calls. When
+/// many sprites use their own small textures, packing these into
+/// a few large textures lets consecutive sprites share the same
+/// texture, which is then bound only once.
+///
+/// sf::TextureAtlas places the images it is given into pages,
+/// with a skyline packer. Pages are as wide as the page size,
+/// they start small and get taller as images are added, until
+/// they reach the page size; another page is started when an
+/// image doesn't fit in the existing ones. Images are never
+/// moved: the regions returned by add() stay valid as long as
+/// the atlas lives, and can be given directly to sf::Sprite.
+///
+/// Images are stored unchanged. Keep at least 1 pixel of
+/// padding and of extrusion if the atlas is smooth, scaled or
+/// drawn at fractional positions; without mipmaps, this is
+/// enough to prevent neighbor images from bleeding.
+///
+/// Usage example:
+/// \code
+/// sf::TextureAtlas atlas;
+///
+/// std::vector<sf::Sprite> sprites;
+/// for (const std::filesystem::path& path : paths)
+/// {
+///     sf::Image image;
+///     if (!image.loadFromFile(path))
+///         return -1;
+///
+///     std::optional<sf::TextureAtlas::Region> region = atlas.add(image);
+///     if (!region)
+///         return -1;
+///
+///     sprites.emplace_back(*region->texture, region->rect);
+/// }
+///
+/// // Sprites of the same page are drawn without texture switches
+/// for (const sf::Sprite& sprite : sprites)
+///     window.draw(sprite);
+/// \endcode
+///
+/// \see sf::Texture, sf::Sprite
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,347 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTURECACHE_HPP
+#define SFML_TEXTURECACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+#include <SFML/Config.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+
+namespace sf
+{
+class Texture;
+
+namespace priv
+{
+struct TextureCacheImpl;
+struct TextureCacheEntry;
+} // namespace priv
+
+////////////////////////////////////////////////////////////
+/// \brief Keeps the video memory used by a set of textures
+///        under a budget
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureCache
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Function which reloads the contents of an evicted texture
+    ///
+    /// It is given the evicted texture, which it must load again
+    /// (with Texture::loadFromFile for example), and returns true
+    /// if the texture could be reloaded.
+    ///
+    ////////////////////////////////////////////////////////////
+    using ReloadFunction = std::function<bool(Texture&)>;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a cache without budget, which never evicts textures.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the cache with a budget
+    ///
+    /// \param budget Maximum video memory used by the textures, in bytes, 0 for no limit
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextureCache(Uint64 budget);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The textures which are still evicted are restored.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureCache(const TextureCache&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureCache(TextureCache&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureCache& operator=(TextureCache&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the budget of the cache
+    ///
+    /// If the textures use more video memory than the new budget,
+    /// the least recently used ones are evicted immediately.
+    ///
+    /// \param budget Maximum video memory used by the textures, in bytes, 0 for no limit
+    ///
+    /// \see getBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBudget(Uint64 budget);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the budget of the cache
+    ///
+    /// \return Maximum video memory used by the textures, in bytes, 0 for no limit
+    ///
+    /// \see setBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Uint64 getBudget() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a texture which is evicted to a copy in system memory
+    ///
+    /// When the texture is evicted, its pixels are read back to an
+    /// image which is uploaded again when the texture is restored.
+    /// Textures stored with block compression or in the sf::RGBA16F
+    /// format can't be copied without loss, they are only evicted
+    /// if they are added with a reload function.
+    ///
+    /// The texture counts as the most recently used one. If it
+    /// already belongs to a cache, it is moved to this one.
+    ///
+    /// \param texture Texture to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a texture which is evicted and reloaded from its source
+    ///
+    /// When the texture is evicted, its video memory is simply
+    /// released, \a reload is called to load it again when the
+    /// texture is restored.
+    ///
+    /// The texture counts as the most recently used one. If it
+    /// already belongs to a cache, it is moved to this one.
+    ///
+    /// \param texture Texture to add
+    /// \param reload  Function which reloads the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(Texture& texture, ReloadFunction reload);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a texture from the cache
+    ///
+    /// The texture is restored if it is evicted.
+    /// Nothing happens if it doesn't belong to this cache.
+    ///
+    /// \param texture Texture to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a texture belongs to the cache
+    ///
+    /// \param texture Texture to check
+    ///
+    /// \return True if the texture was added to this cache
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool contains(const Texture& texture) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a texture of the cache is in video memory
+    ///
+    /// \param texture Texture to check
+    ///
+    /// \return True if the texture belongs to this cache and is not evicted
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool isResident(const Texture& texture) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restore a texture of the cache if it is evicted
+    ///
+    /// Textures are restored automatically when they are bound,
+    /// this function restores a texture beforehand, to update or
+    /// copy it for example. The texture counts as the most
+    /// recently used one.
+    ///
+    /// \param texture Texture to restore
+    ///
+    /// \return True if the texture belongs to this cache and is in video memory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool restore(Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of textures of the cache
+    ///
+    /// \return Number of textures, evicted or not
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::size_t getCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the video memory used by the textures of the cache
+    ///
+    /// The usage of a texture is updated each time it is bound,
+    /// see Texture::getMemoryUsage.
+    ///
+    /// \return Estimated video memory used by the resident textures, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Uint64 getMemoryUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of evictions since the cache was created
+    ///
+    /// A number which keeps growing every frame means that the
+    /// textures used by a single frame don't fit in the budget.
+    ///
+    /// \return Number of times a texture was evicted
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Uint64 getEvictionCount() const;
+
+private:
+    friend class RenderTarget;
+    friend class Texture;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a texture as used, restoring it if needed
+    ///
+    /// This function is called by Texture::bind, and by render
+    /// targets when they skip binding a texture which is still
+    /// bound from the previous draw.
+    ///
+    /// \param entry Entry of the bound texture
+    ///
+    ////////////////////////////////////////////////////////////
+    static void touch(priv::TextureCacheEntry& entry);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a texture from its cache without restoring it
+    ///
+    /// This function is called by the destructor of the texture.
+    ///
+    /// \param entry Entry of the destroyed texture
+    ///
+    ////////////////////////////////////////////////////////////
+    static void detach(priv::TextureCacheEntry& entry);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Point an entry to another texture
+    ///
+    /// This function is called when textures are swapped, entries
+    /// follow the contents they describe.
+    ///
+    /// \param entry   Entry to update
+    /// \param texture New texture of the entry
+    ///
+    ////////////////////////////////////////////////////////////
+    static void retarget(priv::TextureCacheEntry& entry, Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::unique_ptr<priv::TextureCacheImpl> m_impl; //!< Budget and textures, most recently used first
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTURECACHE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureCache
+/// \ingroup graphics
+///
+/// sf::TextureCache manages the residency of a set of textures
+/// in video memory, for scenes whose textures don't fit in the
+/// memory of the graphics card all at once, like large maps
+/// streamed on low-end hardware.
+///
+/// The cache keeps its textures ordered by their last use: each
+/// time a texture is bound for drawing, it becomes the most
+/// recently used one. When the textures use more video memory
+/// than the budget of the cache, the least recently used ones
+/// are evicted: their OpenGL texture is destroyed, after their
+/// pixels were copied to system memory or, if a reload function
+/// was given, without keeping anything. An evicted texture is
+/// restored as soon as it is bound again, the textures in use
+/// are therefore never evicted for longer than necessary.
+///
+/// An evicted texture keeps its size, format and parameters
+/// (smooth, repeated, sRGB, mipmap), but behaves like an empty
+/// texture until it is restored: call restore() before updating
+/// or copying it outside of drawing.
+///
+/// The memory usage of textures is estimated from their size,
+/// format and mipmap levels, drivers may allocate more. Textures
+/// used as render targets (sf::RenderTexture) can't be evicted.
+/// The cache and its textures must be used by the same thread.
+///
+/// Usage example:
+/// \code
+/// // Keep the tiles under 256 MB of video memory
+/// sf::TextureCache cache(256 * 1024 * 1024);
+///
+/// std::vector<sf::Texture> tiles(paths.size());
+/// for (std::size_t i = 0; i < tiles.size(); ++i)
+/// {
+///     if (!tiles[i].loadFromFile(paths[i]))
+///         return -1;
+///
+///     cache.add(tiles[i], [path = paths[i]](sf::Texture& texture) { return texture.loadFromFile(path); });
+/// }
+///
+/// // Draw the tiles as usual, evicted tiles are reloaded when they are drawn
+/// window.draw(sf::Sprite(tiles[42]));
+/// \endcode
+///
+/// \see sf::Texture
+///
+////////////////////////////////////////////////////////////
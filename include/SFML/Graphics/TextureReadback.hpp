@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREREADBACK_HPP
+#define SFML_TEXTUREREADBACK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Window/GlResource.hpp>
+
+#include <cstddef>
+#include <memory>
+
+
+namespace sf
+{
+class Texture;
+
+namespace priv
+{
+class PixelBufferPool;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Pending asynchronous copy of a texture to an image
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureReadback : GlResource
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty readback, which is never ready.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureReadback();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The pixels of a readback which was not consumed are discarded.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureReadback();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureReadback(const TextureReadback&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureReadback& operator=(const TextureReadback&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureReadback(TextureReadback&& right) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureReadback& operator=(TextureReadback&& right) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the pixels can be read without blocking
+    ///
+    /// This function never blocks. When fences are not supported
+    /// by the system (see isAvailable), a pending readback is
+    /// always reported ready, and getImage may still wait for
+    /// the GPU.
+    ///
+    /// \return True if getImage won't wait for the GPU, false if it would or if the readback is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the pixels of the texture
+    ///
+    /// This function blocks until the GPU has copied the pixels,
+    /// then copies them to the returned image, cropping the
+    /// padding and flipping the rows of the texture if needed.
+    /// It can be called from any thread, for example by a worker
+    /// thread encoding the frames, so that this copy doesn't
+    /// happen on the rendering thread.
+    ///
+    /// The readback is empty afterwards.
+    ///
+    /// \return Image containing the pixels of the texture at the time of the readback
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Image getImage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether readbacks are asynchronous on the current system
+    ///
+    /// This requires pixel buffer objects (core since OpenGL 2.1)
+    /// and ARB_map_buffer_range (core since OpenGL 3.0), as well
+    /// as ARB_sync (core since OpenGL 3.2) to track completion.
+    /// When they are not available, or with OpenGL ES, the
+    /// texture is copied synchronously by Texture::copyToImageAsync.
+    ///
+    /// \return True if readbacks are asynchronous, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+    friend class Texture;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the pixel buffer back to its pool and delete the fence
+    ///
+    ////////////////////////////////////////////////////////////
+    void release();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::shared_ptr<priv::PixelBufferPool> m_pool;          //!< Pool the pixel buffer comes from
+    unsigned int                           m_buffer;        //!< Pixel buffer object receiving the pixels, 0 if none
+    std::size_t                            m_capacity;      //!< Size of the storage of the pixel buffer, in bytes
+    void*                                  m_fence;         //!< Fence signaled when the pixels are in the buffer
+    Vector2u                               m_size;          //!< Size of the texture
+    Vector2u                               m_actualSize;    //!< Size of the texture including its padding
+    bool                                   m_pixelsFlipped; //!< Are the rows of the texture stored bottom to top?
+    Image                                  m_image;         //!< Pixels copied synchronously, without buffers
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREREADBACK_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureReadback
+/// \ingroup graphics
+///
+/// Texture::copyToImage waits for the GPU to finish rendering to
+/// the texture and to transfer its pixels, which serializes the
+/// CPU and the GPU when it is called every frame, for example to
+/// record a video. Texture::copyToImageAsync instead queues the
+/// transfer to a pixel buffer object, taken from a set of buffers
+/// owned by the texture that rotate as readbacks are consumed,
+/// and returns an sf::TextureReadback right away.
+///
+/// One or two frames later, isReady() tells that the GPU has
+/// caught up, and getImage() maps the buffer and copies the
+/// pixels without stalling.
+///
+/// Like all texture functions, readbacks require an OpenGL
+/// context, which SFML activates automatically. The texture can
+/// be modified or destroyed once the readback has been started.
+///
+/// Usage example:
+/// \code
+/// std::deque<sf::TextureReadback> pending;
+///
+/// while (recording)
+/// {
+///     renderTexture.display();
+///     pending.push_back(renderTexture.getTexture().copyToImageAsync());
+///
+///     // Consume the frames which have arrived, without waiting for the latest ones
+///     while (!pending.empty() && pending.front().isReady())
+///     {
+///         encoder.push(pending.front().getImage());
+///         pending.pop_front();
+///     }
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::Image
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,260 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREUPLOAD_HPP
+#define SFML_TEXTUREUPLOAD_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+#include <SFML/Graphics/PixelFormat.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Window/GlResource.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+namespace priv
+{
+class PixelBufferPool;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Staging memory for an asynchronous update of a texture
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureUpload : GlResource
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty upload, which can't be submitted.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureUpload();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// An upload which was not submitted is discarded, the
+    /// texture is left unchanged.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureUpload();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureUpload(const TextureUpload&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureUpload& operator=(const TextureUpload&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureUpload(TextureUpload&& right) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureUpload& operator=(TextureUpload&& right) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the staging memory
+    ///
+    /// The memory holds getSize().x * getSize().y pixels of the
+    /// format returned by getPixelFormat, row by row without
+    /// padding. It can be written from any thread until the
+    /// upload is submitted with Texture::update, after which
+    /// this function returns a null pointer.
+    ///
+    /// \return Pointer to the pixels to write, or null
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Uint8* getPixels();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the updated area
+    ///
+    /// \return Size of the area to update, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of the updated area in the texture
+    ///
+    /// \return Offset of the area to update in the texture, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Vector2u getDestination() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the format of the pixels to write
+    ///
+    /// This is the format of the texture, pixels are not
+    /// converted.
+    ///
+    /// \return Pixel format of the staging memory
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] PixelFormat getPixelFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the upload has been submitted
+    ///
+    /// \return True if Texture::update was called with this upload
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool isSubmitted() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the GPU has finished the transfer
+    ///
+    /// This function never blocks. Once it returns true, the
+    /// texture can be sampled without waiting for the upload.
+    /// When fences are not supported by the system (see
+    /// isAvailable), a submitted upload is always complete.
+    ///
+    /// \return True if the upload has been submitted and completed
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool isComplete() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Block until the GPU has finished the transfer
+    ///
+    /// This function returns immediately if the upload has not
+    /// been submitted.
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether uploads are asynchronous on the current system
+    ///
+    /// This requires pixel buffer objects (core since OpenGL 2.1)
+    /// and ARB_map_buffer_range (core since OpenGL 3.0), as well
+    /// as ARB_sync (core since OpenGL 3.2) to track completion.
+    /// When they are not available, uploads are staged in system
+    /// memory and transferred synchronously when submitted.
+    ///
+    /// \return True if uploads are asynchronous, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+    friend class Texture;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the pixel buffer back to its pool and delete the fence
+    ///
+    ////////////////////////////////////////////////////////////
+    void release();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Texture*                         m_texture;      //!< Texture to update
+    std::shared_ptr<priv::PixelBufferPool> m_pool;         //!< Pool the pixel buffer comes from
+    unsigned int                           m_buffer;       //!< Pixel buffer object, 0 if staged in system memory
+    std::size_t                            m_capacity;     //!< Size of the storage of the pixel buffer, in bytes
+    Uint8*                                 m_pixels;       //!< Mapping of the pixel buffer, or system memory
+    std::vector<Uint8>                     m_systemPixels; //!< System memory used when pixel buffers are unavailable
+    Vector2u                               m_size;         //!< Size of the updated area
+    Vector2u                               m_destination;  //!< Position of the updated area in the texture
+    PixelFormat                            m_format;       //!< Format of the pixels
+    void*                                  m_fence;        //!< Fence signaled when the transfer is done
+    bool                                   m_submitted;    //!< Was the upload submitted?
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREUPLOAD_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureUpload
+/// \ingroup graphics
+///
+/// sf::Texture::update copies pixels from system memory to the
+/// texture before returning, which stalls the thread for large
+/// updates such as video frames. sf::TextureUpload splits such
+/// an update in three steps:
+/// \li Texture::prepareUpdate reserves staging memory, a mapped
+///     pixel buffer object taken from a pool owned by the texture
+/// \li the pixels are written to getPixels(), possibly from a
+///     worker thread
+/// \li Texture::update(TextureUpload&) starts the transfer from
+///     the pixel buffer to the texture and returns immediately
+///
+/// The GPU then copies the pixels in the background; isComplete()
+/// polls a fence inserted after the copy, so that the renderer
+/// can keep drawing the previous contents of another texture
+/// until the new ones are ready. Drawing the texture before
+/// completion is valid too, the driver waits for the copy.
+///
+/// Like all texture functions, preparing, submitting, polling
+/// and destroying uploads require an OpenGL context, which SFML
+/// activates automatically; only writing the pixels is free of
+/// OpenGL calls. The texture must outlive the upload until it
+/// is submitted.
+///
+/// Usage example:
+/// \code
+/// sf::TextureUpload upload = texture.prepareUpdate(texture.getSize());
+///
+/// // On a worker thread
+/// decoder.decodeFrame(upload.getPixels());
+///
+/// // Back on the render thread
+/// texture.update(upload);
+///
+/// // ... later frames
+/// if (upload.isComplete())
+///     sprite.setTexture(texture);
+/// \endcode
+///
+/// \see sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VERTEXARENA_HPP
+#define SFML_VERTEXARENA_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Contiguous vertex storage that can be filled
+///        concurrently from several threads
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API VertexArena : public Drawable
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty arena of points, with no capacity.
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexArena();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the arena with a type and a capacity
+    ///
+    /// \param type     Type of primitives
+    /// \param capacity Maximum number of vertices that can be allocated
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit VertexArena(PrimitiveType type, std::size_t capacity = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexArena(const VertexArena&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexArena& operator=(const VertexArena&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate a range of vertices
+    ///
+    /// This function is thread-safe and lock-free: several
+    /// threads can allocate ranges and fill them at the same
+    /// time. The returned range is exclusive to the caller, and
+    /// stays valid until the arena is cleared or its capacity
+    /// changes. Every allocated vertex must be written before
+    /// the arena is drawn.
+    ///
+    /// Ranges are laid out in the order in which they are
+    /// allocated, which is not deterministic across threads.
+    ///
+    /// \param vertexCount Number of vertices to allocate
+    ///
+    /// \return Pointer to the first allocated vertex, or a null
+    ///         pointer if the capacity would be exceeded
+    ///
+    ////////////////////////////////////////////////////////////
+    Vertex* allocate(std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of allocated vertices
+    ///
+    /// \return Number of vertices allocated so far
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVertexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the allocated vertices
+    ///
+    /// The vertices are contiguous, they can be uploaded to a
+    /// sf::VertexBuffer in a single call without any copy.
+    ///
+    /// \return Pointer to the first vertex of the arena
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vertex* getVertices() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the capacity of the arena
+    ///
+    /// The allocated vertices are preserved if they fit in the
+    /// new capacity, the others are removed. This function
+    /// invalidates the pointers returned by allocate, and
+    /// must not be called while other threads allocate.
+    ///
+    /// \param capacity Maximum number of vertices that can be allocated
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCapacity(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the capacity of the arena
+    ///
+    /// \return Maximum number of vertices that can be allocated
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the allocated vertices
+    ///
+    /// The capacity is kept, so that filling the arena again
+    /// for the next frame doesn't involve any allocation.
+    /// This function must not be called while other threads
+    /// allocate.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the type of primitives to draw
+    ///
+    /// \param type Type of primitive
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPrimitiveType(PrimitiveType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the type of primitives drawn by the arena
+    ///
+    /// \return Primitive type
+    ///
+    ////////////////////////////////////////////////////////////
+    PrimitiveType getPrimitiveType() const;
+
+private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the arena to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(RenderTarget& target, const RenderStates& states) const override;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Vertex>      m_vertices;      //!< Storage of the vertices, sized to the capacity
+    std::atomic<std::size_t> m_size;          //!< Number of allocated vertices
+    PrimitiveType            m_primitiveType; //!< Type of primitives to draw
+};
+
+} // namespace sf
+
+
+#endif // SFML_VERTEXARENA_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VertexArena
+/// \ingroup graphics
+///
+/// sf::VertexArena is a fixed-capacity array of vertices in which
+/// worker threads reserve ranges and fill them in parallel.
+/// Since all ranges live in the same contiguous storage, the
+/// result is consumed by a single draw call, or a single
+/// sf::VertexBuffer::update, without merging per-thread arrays.
+///
+/// Each worker typically allocates one range for the geometry
+/// it is going to generate (a chunk of terrain, a set of
+/// entities, ...) and writes it directly. The primitives of the
+/// arena are drawn in allocation order: this is suitable for
+/// geometry that shares the same render states and doesn't rely
+/// on a specific drawing order, like opaque or additive
+/// primitives. Strip and fan primitive types connect ranges
+/// together and should therefore not be used.
+///
+/// Usage example:
+/// \code
+/// sf::VertexArena arena(sf::PrimitiveType::Triangles, 1000000);
+///
+/// // On each worker thread
+/// sf::Vertex* vertices = arena.allocate(chunk.getVertexCount());
+/// if (vertices)
+///     chunk.buildGeometry(vertices);
+///
+/// // On the rendering thread, once the workers are done
+/// window.draw(arena, &tileset);
+/// arena.clear();
+/// \endcode
+///
+/// \see sf::VertexArray, sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
@@ -181,6 +181,14 @@ private:
     ////////////////////////////////////////////////////////////
     void draw(RenderTarget& target, const RenderStates& states) const override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds used to cull the vertex array
+    ///
+    /// \return Bounds of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    std::optional<FloatRect> getCullingBounds() const override;
+
 private:
     ////////////////////////////////////////////////////////////
     // Member data
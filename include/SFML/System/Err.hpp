@@ -41,6 +41,24 @@ namespace sf
 ////////////////////////////////////////////////////////////
 SFML_SYSTEM_API std::ostream& err();
 
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Redirect sf::err() to another stream on the calling thread
+///
+/// This lets worker threads collect the errors of a task, so
+/// that they are reported by the thread that consumes its
+/// result instead of being written concurrently to sf::err().
+///
+/// \param stream Stream returned by sf::err() on the calling thread, null to use the shared one again
+///
+/// \return Previous stream of the calling thread, null if it used the shared one
+///
+////////////////////////////////////////////////////////////
+SFML_SYSTEM_API std::ostream* setThreadErrStream(std::ostream* stream);
+
+} // namespace priv
+
 } // namespace sf
 
 
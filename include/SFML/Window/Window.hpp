@@ -255,9 +255,52 @@ public:
     /// it on screen.
     ///
     ////////////////////////////////////////////////////////////
-    void display();
+    virtual void display();
+
+protected:
+    ////////////////////////////////////////////////////////////
+    /// \brief Display on screen what has been rendered, telling which region changed
+    ///
+    /// This function behaves like display(), but allows the
+    /// windowing system to only update the damaged region of the
+    /// screen, when the platform supports it. The contents of the
+    /// window outside of this region must be identical to the
+    /// previously displayed frame.
+    ///
+    /// \param position Bottom-left corner of the damaged region, in pixels
+    /// \param size     Size of the damaged region, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void displayWithDamage(const Vector2i& position, const Vector2i& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the back buffer of the window
+    ///
+    /// The age is the number of frames since the current contents
+    /// of the back buffer were displayed: 1 if it contains the
+    /// previous frame, 2 if it contains the frame before, etc.
+    /// 0 means that its contents are undefined, which is also
+    /// returned when the platform can't tell.
+    ///
+    /// \return Age of the back buffer, in frames
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBackBufferAge() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called before the contents of the window are read back
+    ///
+    /// This function is called, for example by sf::Texture::update,
+    /// so that derived classes which defer their rendering can
+    /// submit it before the contents of the window are copied.
+    /// The default implementation does nothing.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onBeforeRead() const;
 
 private:
+    friend class Texture;
+
     ////////////////////////////////////////////////////////////
     /// \brief Processes an event before it is sent to the user
     ///
@@ -278,6 +321,12 @@ private:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait if needed to honor the framerate limit
+    ///
+    ////////////////////////////////////////////////////////////
+    void limitFramerate();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,1269 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompressedImage.hpp>
+#include <SFML/Graphics/ParallelFor.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/InputStream.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <ostream>
+#include <utility>
+
+
+namespace
+{
+// A nested named namespace is used here to allow unity builds of SFML.
+namespace CompressedImageImpl
+{
+// Number of blocks decoded by a thread, at least
+constexpr std::size_t minBlocksPerThread = 32 * 1024;
+
+// Largest width or height accepted in headers, way above what graphics cards support
+constexpr sf::Uint32 maximumSize = 65536;
+
+// Container signatures, the longest one is read to identify a file
+constexpr std::size_t signatureSize  = 12;
+constexpr sf::Uint8   ddsSignature[]  = {'D', 'D', 'S', ' '};
+constexpr sf::Uint8   ktxSignature[]  = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+constexpr sf::Uint8   ktx2Signature[] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+template <std::size_t N>
+bool hasSignature(const sf::Uint8* data, std::size_t dataSize, const sf::Uint8 (&signature)[N])
+{
+    return (dataSize >= N) && (std::memcmp(data, signature, N) == 0);
+}
+
+sf::Uint32 readUint32(const sf::Uint8* data)
+{
+    return static_cast<sf::Uint32>(data[0]) | (static_cast<sf::Uint32>(data[1]) << 8) |
+           (static_cast<sf::Uint32>(data[2]) << 16) | (static_cast<sf::Uint32>(data[3]) << 24);
+}
+
+sf::Uint64 readUint64(const sf::Uint8* data)
+{
+    return static_cast<sf::Uint64>(readUint32(data)) | (static_cast<sf::Uint64>(readUint32(data + 4)) << 32);
+}
+
+sf::Uint32 makeFourCC(char a, char b, char c, char d)
+{
+    return static_cast<sf::Uint32>(a) | (static_cast<sf::Uint32>(b) << 8) | (static_cast<sf::Uint32>(c) << 16) |
+           (static_cast<sf::Uint32>(d) << 24);
+}
+
+// Sizes of valid headers are limited, so that the size of their blocks can't overflow 64 bits
+sf::Uint64 getLevelDataSize(const sf::Vector2u& size, sf::priv::CompressedFormat format)
+{
+    const sf::Uint64 blocksX = (static_cast<sf::Uint64>(size.x) + 3) / 4;
+    const sf::Uint64 blocksY = (static_cast<sf::Uint64>(size.y) + 3) / 4;
+    return blocksX * blocksY * sf::priv::getCompressedBlockSize(format);
+}
+
+// Check the size read from a header, the base level must fit in memory once decompressed
+bool isValidSize(const sf::Vector2u& size)
+{
+    if ((size.x == 0) || (size.y == 0) || (size.x > maximumSize) || (size.y > maximumSize))
+        return false;
+
+    return static_cast<sf::Uint64>(size.x) * size.y * 4 <= std::numeric_limits<std::size_t>::max();
+}
+
+sf::Vector2u getLevelSize(const sf::Vector2u& size, std::size_t level)
+{
+    return {std::max(size.x >> level, 1u), std::max(size.y >> level, 1u)};
+}
+
+// Fill the levels of an image whose levels are stored contiguously, largest first
+bool fillContiguousLevels(const sf::Uint8*         data,
+                          std::size_t              dataSize,
+                          std::size_t              offset,
+                          const sf::Vector2u&      size,
+                          std::size_t              levelCount,
+                          sf::priv::CompressedImage& image)
+{
+    for (std::size_t i = 0; i < levelCount; ++i)
+    {
+        const sf::Vector2u levelSize     = getLevelSize(size, i);
+        const sf::Uint64   levelDataSize = getLevelDataSize(levelSize, image.format);
+
+        if (levelDataSize > dataSize - offset)
+            return false;
+
+        image.levels.push_back({levelSize, data + offset, static_cast<std::size_t>(levelDataSize)});
+        offset += static_cast<std::size_t>(levelDataSize);
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+bool parseDds(const sf::Uint8* data, std::size_t dataSize, sf::priv::CompressedImage& image)
+{
+    // Signature, then the 124 bytes DDS_HEADER
+    if (dataSize < 128 || readUint32(data + 4) != 124)
+    {
+        sf::err() << "Failed to load DDS image, invalid header" << std::endl;
+        return false;
+    }
+
+    const sf::Uint32 flags       = readUint32(data + 8);
+    const sf::Vector2u size      = {readUint32(data + 16), readUint32(data + 12)};
+    const sf::Uint32 mipmapCount = readUint32(data + 28);
+    const sf::Uint32 formatFlags = readUint32(data + 80);
+    const sf::Uint32 fourCC      = readUint32(data + 84);
+    const sf::Uint32 caps2       = readUint32(data + 112);
+    std::size_t      offset      = 128;
+
+    // DDPF_FOURCC, uncompressed formats are left to the regular image loaders
+    if (!(formatFlags & 0x4))
+    {
+        sf::err() << "Failed to load DDS image, only block compressed formats are supported" << std::endl;
+        return false;
+    }
+
+    // DDSCAPS2_CUBEMAP, DDSCAPS2_VOLUME
+    if (caps2 & (0x200 | 0x200000))
+    {
+        sf::err() << "Failed to load DDS image, cube maps and volume textures are not supported" << std::endl;
+        return false;
+    }
+
+    if (fourCC == makeFourCC('D', 'X', '1', '0'))
+    {
+        // DDS_HEADER_DXT10 follows the header
+        if (dataSize < 148)
+        {
+            sf::err() << "Failed to load DDS image, invalid header" << std::endl;
+            return false;
+        }
+
+        const sf::Uint32 dxgiFormat = readUint32(data + 128);
+        const sf::Uint32 dimension  = readUint32(data + 132);
+        const sf::Uint32 miscFlag   = readUint32(data + 136);
+        const sf::Uint32 arraySize  = readUint32(data + 140);
+        offset                      = 148;
+
+        // D3D10_RESOURCE_DIMENSION_TEXTURE2D, single non-cube texture
+        if ((dimension != 3) || (miscFlag & 0x4) || (arraySize > 1))
+        {
+            sf::err() << "Failed to load DDS image, only 2D textures are supported" << std::endl;
+            return false;
+        }
+
+        switch (dxgiFormat)
+        {
+            case 71: // DXGI_FORMAT_BC1_UNORM
+            case 72: // DXGI_FORMAT_BC1_UNORM_SRGB
+                image.format = sf::priv::BC1A;
+                break;
+            case 74: // DXGI_FORMAT_BC2_UNORM
+            case 75: // DXGI_FORMAT_BC2_UNORM_SRGB
+                image.format = sf::priv::BC2;
+                break;
+            case 77: // DXGI_FORMAT_BC3_UNORM
+            case 78: // DXGI_FORMAT_BC3_UNORM_SRGB
+                image.format = sf::priv::BC3;
+                break;
+            case 80: // DXGI_FORMAT_BC4_UNORM
+                image.format = sf::priv::BC4;
+                break;
+            case 83: // DXGI_FORMAT_BC5_UNORM
+                image.format = sf::priv::BC5;
+                break;
+            case 98: // DXGI_FORMAT_BC7_UNORM
+            case 99: // DXGI_FORMAT_BC7_UNORM_SRGB
+                image.format = sf::priv::BC7;
+                break;
+            default:
+                sf::err() << "Failed to load DDS image, unsupported DXGI format " << dxgiFormat << std::endl;
+                return false;
+        }
+    }
+    else if (fourCC == makeFourCC('D', 'X', 'T', '1'))
+    {
+        image.format = sf::priv::BC1A;
+    }
+    else if ((fourCC == makeFourCC('D', 'X', 'T', '2')) || (fourCC == makeFourCC('D', 'X', 'T', '3')))
+    {
+        image.format = sf::priv::BC2;
+    }
+    else if ((fourCC == makeFourCC('D', 'X', 'T', '4')) || (fourCC == makeFourCC('D', 'X', 'T', '5')))
+    {
+        image.format = sf::priv::BC3;
+    }
+    else if ((fourCC == makeFourCC('A', 'T', 'I', '1')) || (fourCC == makeFourCC('B', 'C', '4', 'U')))
+    {
+        image.format = sf::priv::BC4;
+    }
+    else if ((fourCC == makeFourCC('A', 'T', 'I', '2')) || (fourCC == makeFourCC('B', 'C', '5', 'U')))
+    {
+        image.format = sf::priv::BC5;
+    }
+    else
+    {
+        sf::err() << "Failed to load DDS image, unsupported compression format" << std::endl;
+        return false;
+    }
+
+    if (!isValidSize(size))
+    {
+        sf::err() << "Failed to load DDS image, invalid size (" << size.x << "x" << size.y << ")" << std::endl;
+        return false;
+    }
+
+    // DDSD_MIPMAPCOUNT
+    const std::size_t levelCount = ((flags & 0x20000) && (mipmapCount > 0)) ? mipmapCount : 1;
+
+    if (!fillContiguousLevels(data, dataSize, offset, size, std::min<std::size_t>(levelCount, 32), image))
+    {
+        sf::err() << "Failed to load DDS image, the file is truncated" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+bool getFormatFromGl(sf::Uint32 glInternalFormat, sf::priv::CompressedFormat& format)
+{
+    switch (glInternalFormat)
+    {
+        case 0x83F0: // GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+        case 0x8C4C: // GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+            format = sf::priv::BC1;
+            return true;
+        case 0x83F1: // GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+        case 0x8C4D: // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+            format = sf::priv::BC1A;
+            return true;
+        case 0x83F2: // GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+        case 0x8C4E: // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT
+            format = sf::priv::BC2;
+            return true;
+        case 0x83F3: // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+        case 0x8C4F: // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+            format = sf::priv::BC3;
+            return true;
+        case 0x8DBB: // GL_COMPRESSED_RED_RGTC1
+            format = sf::priv::BC4;
+            return true;
+        case 0x8DBD: // GL_COMPRESSED_RG_RGTC2
+            format = sf::priv::BC5;
+            return true;
+        case 0x8E8C: // GL_COMPRESSED_RGBA_BPTC_UNORM
+        case 0x8E8D: // GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+            format = sf::priv::BC7;
+            return true;
+        case 0x8D64: // GL_ETC1_RGB8_OES
+            format = sf::priv::ETC1;
+            return true;
+        case 0x9274: // GL_COMPRESSED_RGB8_ETC2
+        case 0x9275: // GL_COMPRESSED_SRGB8_ETC2
+            format = sf::priv::ETC2RGB;
+            return true;
+        case 0x9276: // GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2
+        case 0x9277: // GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2
+            format = sf::priv::ETC2RGBA1;
+            return true;
+        case 0x9278: // GL_COMPRESSED_RGBA8_ETC2_EAC
+        case 0x9279: // GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC
+            format = sf::priv::ETC2RGBA;
+            return true;
+        default:
+            return false;
+    }
+}
+
+////////////////////////////////////////////////////////////
+bool parseKtx(const sf::Uint8* data, std::size_t dataSize, sf::priv::CompressedImage& image)
+{
+    // Signature, then 13 32-bit fields
+    if (dataSize < 64)
+    {
+        sf::err() << "Failed to load KTX image, invalid header" << std::endl;
+        return false;
+    }
+
+    // KTX files may be written in either endianness, as indicated by their endianness field
+    bool swapBytes = false;
+    if (readUint32(data + 12) == 0x01020304)
+        swapBytes = true;
+    else if (readUint32(data + 12) != 0x04030201)
+    {
+        sf::err() << "Failed to load KTX image, invalid header" << std::endl;
+        return false;
+    }
+
+    auto readField = [&](std::size_t offset)
+    {
+        const sf::Uint32 value = readUint32(data + offset);
+        if (!swapBytes)
+            return value;
+
+        return (value >> 24) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24);
+    };
+
+    const sf::Uint32   glType           = readField(16);
+    const sf::Uint32   glInternalFormat = readField(28);
+    const sf::Vector2u size             = {readField(36), readField(40)};
+    const sf::Uint32   depth            = readField(44);
+    const sf::Uint32   arrayElements    = readField(48);
+    const sf::Uint32   faces            = readField(52);
+    const sf::Uint32   levelCount       = std::max(readField(56), sf::Uint32(1));
+    const sf::Uint32   keyValueSize     = readField(60);
+
+    if ((glType != 0) || !getFormatFromGl(glInternalFormat, image.format))
+    {
+        sf::err() << "Failed to load KTX image, unsupported format 0x" << std::hex << glInternalFormat << std::dec
+                  << std::endl;
+        return false;
+    }
+
+    if ((depth > 1) || (arrayElements > 0) || (faces != 1))
+    {
+        sf::err() << "Failed to load KTX image, only 2D textures are supported" << std::endl;
+        return false;
+    }
+
+    if (!isValidSize(size))
+    {
+        sf::err() << "Failed to load KTX image, invalid size (" << size.x << "x" << size.y << ")" << std::endl;
+        return false;
+    }
+
+    if (keyValueSize > dataSize - 64)
+    {
+        sf::err() << "Failed to load KTX image, the file is truncated" << std::endl;
+        return false;
+    }
+
+    // Each level is made of its size followed by its data, padded to 4 bytes
+    std::size_t offset = 64 + static_cast<std::size_t>(keyValueSize);
+    for (std::size_t i = 0; i < std::min<std::size_t>(levelCount, 32); ++i)
+    {
+        if ((offset > dataSize) || (dataSize - offset < 4))
+        {
+            sf::err() << "Failed to load KTX image, the file is truncated" << std::endl;
+            return false;
+        }
+
+        const std::size_t  levelDataSize = readField(offset);
+        const sf::Vector2u levelSize     = getLevelSize(size, i);
+        offset += 4;
+
+        if ((levelDataSize != getLevelDataSize(levelSize, image.format)) || (levelDataSize > dataSize - offset))
+        {
+            sf::err() << "Failed to load KTX image, the file is truncated" << std::endl;
+            return false;
+        }
+
+        image.levels.push_back({levelSize, data + offset, levelDataSize});
+        offset += (levelDataSize + 3) & ~std::size_t(3);
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+bool getFormatFromVk(sf::Uint32 vkFormat, sf::priv::CompressedFormat& format)
+{
+    switch (vkFormat)
+    {
+        case 131: // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+        case 132: // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+            format = sf::priv::BC1;
+            return true;
+        case 133: // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+        case 134: // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+            format = sf::priv::BC1A;
+            return true;
+        case 135: // VK_FORMAT_BC2_UNORM_BLOCK
+        case 136: // VK_FORMAT_BC2_SRGB_BLOCK
+            format = sf::priv::BC2;
+            return true;
+        case 137: // VK_FORMAT_BC3_UNORM_BLOCK
+        case 138: // VK_FORMAT_BC3_SRGB_BLOCK
+            format = sf::priv::BC3;
+            return true;
+        case 139: // VK_FORMAT_BC4_UNORM_BLOCK
+            format = sf::priv::BC4;
+            return true;
+        case 141: // VK_FORMAT_BC5_UNORM_BLOCK
+            format = sf::priv::BC5;
+            return true;
+        case 145: // VK_FORMAT_BC7_UNORM_BLOCK
+        case 146: // VK_FORMAT_BC7_SRGB_BLOCK
+            format = sf::priv::BC7;
+            return true;
+        case 147: // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+        case 148: // VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+            format = sf::priv::ETC2RGB;
+            return true;
+        case 149: // VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK
+        case 150: // VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK
+            format = sf::priv::ETC2RGBA1;
+            return true;
+        case 151: // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+        case 152: // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+            format = sf::priv::ETC2RGBA;
+            return true;
+        default:
+            return false;
+    }
+}
+
+////////////////////////////////////////////////////////////
+bool parseKtx2(const sf::Uint8* data, std::size_t dataSize, sf::priv::CompressedImage& image)
+{
+    // Signature, then 9 32-bit fields, then the index (4 32-bit and 2 64-bit fields)
+    if (dataSize < 80)
+    {
+        sf::err() << "Failed to load KTX2 image, invalid header" << std::endl;
+        return false;
+    }
+
+    const sf::Uint32   vkFormat         = readUint32(data + 12);
+    const sf::Vector2u size             = {readUint32(data + 20), readUint32(data + 24)};
+    const sf::Uint32   depth            = readUint32(data + 28);
+    const sf::Uint32   layers           = readUint32(data + 32);
+    const sf::Uint32   faces            = readUint32(data + 36);
+    const sf::Uint32   levelCount       = std::max(readUint32(data + 40), sf::Uint32(1));
+    const sf::Uint32   supercompression = readUint32(data + 44);
+
+    if (supercompression != 0)
+    {
+        sf::err() << "Failed to load KTX2 image, supercompressed images are not supported" << std::endl;
+        return false;
+    }
+
+    if (!getFormatFromVk(vkFormat, image.format))
+    {
+        sf::err() << "Failed to load KTX2 image, unsupported format " << vkFormat << std::endl;
+        return false;
+    }
+
+    if ((depth > 1) || (layers > 0) || (faces != 1))
+    {
+        sf::err() << "Failed to load KTX2 image, only 2D textures are supported" << std::endl;
+        return false;
+    }
+
+    if (!isValidSize(size))
+    {
+        sf::err() << "Failed to load KTX2 image, invalid size (" << size.x << "x" << size.y << ")" << std::endl;
+        return false;
+    }
+
+    // The level index follows the header, it gives the location of each level, starting with the base level
+    for (std::size_t i = 0; i < std::min<std::size_t>(levelCount, 32); ++i)
+    {
+        const std::size_t indexOffset = 80 + i * 24;
+        if (indexOffset + 24 > dataSize)
+        {
+            sf::err() << "Failed to load KTX2 image, the file is truncated" << std::endl;
+            return false;
+        }
+
+        const sf::Uint64   offset        = readUint64(data + indexOffset);
+        const sf::Uint64   levelDataSize = readUint64(data + indexOffset + 8);
+        const sf::Vector2u levelSize     = getLevelSize(size, i);
+
+        if ((levelDataSize != getLevelDataSize(levelSize, image.format)) || (offset > dataSize) ||
+            (levelDataSize > dataSize - offset))
+        {
+            sf::err() << "Failed to load KTX2 image, the file is truncated" << std::endl;
+            return false;
+        }
+
+        image.levels.push_back({levelSize, data + offset, static_cast<std::size_t>(levelDataSize)});
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+void setPixel(sf::Uint8* pixel, int r, int g, int b, int a)
+{
+    pixel[0] = static_cast<sf::Uint8>(std::clamp(r, 0, 255));
+    pixel[1] = static_cast<sf::Uint8>(std::clamp(g, 0, 255));
+    pixel[2] = static_cast<sf::Uint8>(std::clamp(b, 0, 255));
+    pixel[3] = static_cast<sf::Uint8>(std::clamp(a, 0, 255));
+}
+
+int extend(sf::Uint32 value, int bits)
+{
+    // Replicate the high bits into the low bits, so that 0 and the maximum map to 0 and 255
+    return static_cast<int>((value << (8 - bits)) | (value >> (2 * bits - 8)));
+}
+
+////////////////////////////////////////////////////////////
+// Decode the color part of a BC1, BC2 or BC3 block
+void decodeBc1(const sf::Uint8* block, sf::Uint8* pixels, bool alpha, bool alwaysFourColors)
+{
+    const sf::Uint32 color0  = static_cast<sf::Uint32>(block[0]) | (static_cast<sf::Uint32>(block[1]) << 8);
+    const sf::Uint32 color1  = static_cast<sf::Uint32>(block[2]) | (static_cast<sf::Uint32>(block[3]) << 8);
+    const sf::Uint32 indices = readUint32(block + 4);
+
+    int palette[4][4];
+    palette[0][0] = extend(color0 >> 11, 5);
+    palette[0][1] = extend((color0 >> 5) & 0x3F, 6);
+    palette[0][2] = extend(color0 & 0x1F, 5);
+    palette[1][0] = extend(color1 >> 11, 5);
+    palette[1][1] = extend((color1 >> 5) & 0x3F, 6);
+    palette[1][2] = extend(color1 & 0x1F, 5);
+    palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+
+    for (int c = 0; c < 3; ++c)
+    {
+        if ((color0 > color1) || alwaysFourColors)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        else
+        {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+
+    if ((color0 <= color1) && !alwaysFourColors && alpha)
+        palette[3][3] = 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const int* color = palette[(indices >> (2 * i)) & 3];
+        setPixel(pixels + i * 4, color[0], color[1], color[2], color[3]);
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Decode a BC4 block (also the alpha part of BC3 blocks) to one component of the pixels
+void decodeBc4(const sf::Uint8* block, sf::Uint8* pixels, int component)
+{
+    const int  value0  = block[0];
+    const int  value1  = block[1];
+    sf::Uint64 indices = 0;
+    for (int i = 0; i < 6; ++i)
+        indices |= static_cast<sf::Uint64>(block[2 + i]) << (8 * i);
+
+    int palette[8] = {value0, value1};
+    if (value0 > value1)
+    {
+        for (int i = 1; i < 7; ++i)
+            palette[i + 1] = ((7 - i) * value0 + i * value1) / 7;
+    }
+    else
+    {
+        for (int i = 1; i < 5; ++i)
+            palette[i + 1] = ((5 - i) * value0 + i * value1) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    for (int i = 0; i < 16; ++i)
+        pixels[i * 4 + component] = static_cast<sf::Uint8>(palette[(indices >> (3 * i)) & 7]);
+}
+
+////////////////////////////////////////////////////////////
+// Decode the explicit alpha part of a BC2 block
+void decodeBc2Alpha(const sf::Uint8* block, sf::Uint8* pixels)
+{
+    for (int i = 0; i < 16; ++i)
+        pixels[i * 4 + 3] = static_cast<sf::Uint8>(((block[i / 2] >> (4 * (i % 2))) & 0xF) * 17);
+}
+
+////////////////////////////////////////////////////////////
+// Reader of the bits of a BC7 block, starting with the least significant bit
+class Bc7Bits
+{
+public:
+    explicit Bc7Bits(const sf::Uint8* block) : m_low(readUint64(block)), m_high(readUint64(block + 8))
+    {
+    }
+
+    sf::Uint32 read(int count)
+    {
+        if (count == 0)
+            return 0;
+
+        const auto value = static_cast<sf::Uint32>(m_low & ((sf::Uint64(1) << count) - 1));
+        m_low            = (m_low >> count) | (m_high << (64 - count));
+        m_high >>= count;
+        return value;
+    }
+
+private:
+    sf::Uint64 m_low;
+    sf::Uint64 m_high;
+};
+
+struct Bc7Mode
+{
+    int subsets;
+    int partitionBits;
+    int rotationBits;
+    int indexSelectionBits;
+    int colorBits;
+    int alphaBits;
+    int endpointPBits;
+    int sharedPBits;
+    int indexBits;
+    int secondaryIndexBits;
+};
+
+// clang-format off
+constexpr Bc7Mode bc7Modes[8] = {
+    {3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+    {2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+    {3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+    {2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+    {1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+    {1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+    {1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+    {2, 6, 0, 0, 5, 5, 1, 0, 2, 0}
+};
+
+// Subset of each pixel for two subsets, one bit per pixel
+constexpr sf::Uint16 bc7Partitions2[64] = {
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22
+};
+
+// Subset of each pixel for three subsets, two bits per pixel
+constexpr sf::Uint32 bc7Partitions3[64] = {
+    0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+    0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+    0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+    0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+    0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+    0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+    0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+    0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254
+};
+
+// Anchor pixel of the second subset for two subsets
+constexpr sf::Uint8 bc7Anchors2[64] = {
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+    15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+     6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15
+};
+
+// Anchor pixels of the second and third subsets for three subsets
+constexpr sf::Uint8 bc7Anchors3[2][64] = {
+    { 3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+      3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+      8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+      3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3},
+    {15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+     15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+     15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+     15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8}
+};
+
+constexpr int bc7Weights2[4]  = {0, 21, 43, 64};
+constexpr int bc7Weights3[8]  = {0, 9, 18, 27, 37, 46, 55, 64};
+constexpr int bc7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+// clang-format on
+
+int interpolateBc7(int endpoint0, int endpoint1, sf::Uint32 index, int indexBits)
+{
+    const int weight = (indexBits == 2)   ? bc7Weights2[index]
+                       : (indexBits == 3) ? bc7Weights3[index]
+                                          : bc7Weights4[index];
+    return ((64 - weight) * endpoint0 + weight * endpoint1 + 32) >> 6;
+}
+
+////////////////////////////////////////////////////////////
+void decodeBc7(const sf::Uint8* block, sf::Uint8* pixels)
+{
+    Bc7Bits bits(block);
+
+    // The mode is given by the position of the first set bit
+    int mode = 0;
+    while ((mode < 8) && (bits.read(1) == 0))
+        ++mode;
+
+    // Reserved mode, decodes to transparent black
+    if (mode == 8)
+    {
+        std::fill(pixels, pixels + 64, sf::Uint8(0));
+        return;
+    }
+
+    const Bc7Mode&   info           = bc7Modes[mode];
+    const sf::Uint32 partition      = bits.read(info.partitionBits);
+    const sf::Uint32 rotation       = bits.read(info.rotationBits);
+    const sf::Uint32 indexSelection = bits.read(info.indexSelectionBits);
+    const int        endpointCount  = info.subsets * 2;
+
+    // Endpoints are stored component by component
+    sf::Uint32 endpoints[6][4];
+    for (int c = 0; c < 3; ++c)
+        for (int e = 0; e < endpointCount; ++e)
+            endpoints[e][c] = bits.read(info.colorBits);
+
+    for (int e = 0; e < endpointCount; ++e)
+        endpoints[e][3] = bits.read(info.alphaBits);
+
+    // P-bits add a shared least significant bit to the components of the endpoints
+    int colorBits = info.colorBits;
+    int alphaBits = info.alphaBits;
+    if (info.endpointPBits || info.sharedPBits)
+    {
+        sf::Uint32 pBits[6];
+        if (info.endpointPBits)
+        {
+            for (int e = 0; e < endpointCount; ++e)
+                pBits[e] = bits.read(1);
+        }
+        else
+        {
+            for (int s = 0; s < info.subsets; ++s)
+                pBits[s * 2] = pBits[s * 2 + 1] = bits.read(1);
+        }
+
+        for (int e = 0; e < endpointCount; ++e)
+            for (int c = 0; c < 4; ++c)
+                endpoints[e][c] = (endpoints[e][c] << 1) | pBits[e];
+
+        ++colorBits;
+        if (alphaBits)
+            ++alphaBits;
+    }
+
+    int expanded[6][4];
+    for (int e = 0; e < endpointCount; ++e)
+    {
+        for (int c = 0; c < 3; ++c)
+            expanded[e][c] = extend(endpoints[e][c], colorBits);
+        expanded[e][3] = alphaBits ? extend(endpoints[e][3], alphaBits) : 255;
+    }
+
+    // Anchor pixels store their index with one bit less, its most significant bit is always 0
+    auto getSubset = [&](int pixel) -> int
+    {
+        if (info.subsets == 2)
+            return (bc7Partitions2[partition] >> pixel) & 1;
+        else if (info.subsets == 3)
+            return (bc7Partitions3[partition] >> (2 * pixel)) & 3;
+        else
+            return 0;
+    };
+
+    auto isAnchor = [&](int pixel)
+    {
+        if (pixel == 0)
+            return true;
+        else if (info.subsets == 2)
+            return pixel == bc7Anchors2[partition];
+        else if (info.subsets == 3)
+            return (pixel == bc7Anchors3[0][partition]) || (pixel == bc7Anchors3[1][partition]);
+        else
+            return false;
+    };
+
+    sf::Uint32 indices[16];
+    sf::Uint32 secondaryIndices[16] = {};
+    for (int i = 0; i < 16; ++i)
+        indices[i] = bits.read(info.indexBits - (isAnchor(i) ? 1 : 0));
+
+    if (info.secondaryIndexBits)
+    {
+        for (int i = 0; i < 16; ++i)
+            secondaryIndices[i] = bits.read(info.secondaryIndexBits - (i == 0 ? 1 : 0));
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const int* endpoint0 = expanded[getSubset(i) * 2];
+        const int* endpoint1 = expanded[getSubset(i) * 2 + 1];
+
+        // Modes 4 and 5 have separate indices for color and alpha, mode 4 can swap them
+        sf::Uint32 colorIndex     = indices[i];
+        sf::Uint32 alphaIndex     = indices[i];
+        int        colorIndexBits = info.indexBits;
+        int        alphaIndexBits = info.indexBits;
+        if (info.secondaryIndexBits)
+        {
+            alphaIndex     = secondaryIndices[i];
+            alphaIndexBits = info.secondaryIndexBits;
+            if (indexSelection)
+            {
+                std::swap(colorIndex, alphaIndex);
+                std::swap(colorIndexBits, alphaIndexBits);
+            }
+        }
+
+        int color[4];
+        for (int c = 0; c < 3; ++c)
+            color[c] = interpolateBc7(endpoint0[c], endpoint1[c], colorIndex, colorIndexBits);
+        color[3] = interpolateBc7(endpoint0[3], endpoint1[3], alphaIndex, alphaIndexBits);
+
+        // The rotation swaps the alpha with one of the color components
+        if (rotation > 0)
+            std::swap(color[3], color[rotation - 1]);
+
+        setPixel(pixels + i * 4, color[0], color[1], color[2], color[3]);
+    }
+}
+
+////////////////////////////////////////////////////////////
+// ETC blocks are stored as big endian 64-bit values, and their pixels are indexed column by column
+sf::Uint64 readBigEndianUint64(const sf::Uint8* block)
+{
+    sf::Uint64 value = 0;
+    for (int i = 0; i < 8; ++i)
+        value = (value << 8) | block[i];
+    return value;
+}
+
+int getBits(sf::Uint64 value, int first, int count)
+{
+    return static_cast<int>((value >> first) & ((sf::Uint64(1) << count) - 1));
+}
+
+int signExtend3(int value)
+{
+    return (value & 4) ? value - 8 : value;
+}
+
+// clang-format off
+constexpr int etcModifiers[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+constexpr int etcDistances[8]    = {3, 6, 11, 16, 23, 32, 41, 64};
+
+constexpr int eacModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12}, {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12}, {-3, -6, -8, -12, 2, 5, 7, 11},  {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},  {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},  {-2, -4, -8, -10, 1, 3, 7, 9},   {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},  {-1, -2, -3, -10, 0, 1, 2, 9},   {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8}
+};
+// clang-format on
+
+// Index of an ETC pixel (column major) in a row major block
+int getEtcPixel(int index)
+{
+    return (index % 4) * 4 + index / 4;
+}
+
+// Get the 2-bit index of an ETC pixel, made of one bit of each half of the low 32 bits
+int getEtcIndex(sf::Uint64 block, int index)
+{
+    return (getBits(block, index + 16, 1) << 1) | getBits(block, index, 1);
+}
+
+////////////////////////////////////////////////////////////
+// Decode the T and H modes of ETC2, which select among 4 paint colors derived from two base colors
+void decodeEtc2Paint(sf::Uint64 block, sf::Uint8* pixels, bool hMode, bool punchthrough)
+{
+    int colors[2][3];
+    int distance = 0;
+
+    if (!hMode)
+    {
+        colors[0][0] = (getBits(block, 59, 2) << 2) | getBits(block, 56, 2);
+        colors[0][1] = getBits(block, 52, 4);
+        colors[0][2] = getBits(block, 48, 4);
+        colors[1][0] = getBits(block, 44, 4);
+        colors[1][1] = getBits(block, 40, 4);
+        colors[1][2] = getBits(block, 36, 4);
+        distance     = etcDistances[(getBits(block, 34, 2) << 1) | getBits(block, 32, 1)];
+    }
+    else
+    {
+        colors[0][0] = getBits(block, 59, 4);
+        colors[0][1] = (getBits(block, 56, 3) << 1) | getBits(block, 52, 1);
+        colors[0][2] = (getBits(block, 51, 1) << 3) | getBits(block, 47, 3);
+        colors[1][0] = getBits(block, 43, 4);
+        colors[1][1] = getBits(block, 39, 4);
+        colors[1][2] = getBits(block, 35, 4);
+
+        // The least significant bit of the distance is given by the order of the base colors
+        const int value0        = (colors[0][0] << 8) | (colors[0][1] << 4) | colors[0][2];
+        const int value1        = (colors[1][0] << 8) | (colors[1][1] << 4) | colors[1][2];
+        const int distanceIndex = (getBits(block, 34, 1) << 2) | (getBits(block, 32, 1) << 1) |
+                                  (value0 >= value1 ? 1 : 0);
+
+        distance = etcDistances[distanceIndex];
+    }
+
+    for (auto& color : colors)
+        for (int& component : color)
+            component *= 17;
+
+    int paint[4][3];
+    for (int c = 0; c < 3; ++c)
+    {
+        if (!hMode)
+        {
+            paint[0][c] = colors[0][c];
+            paint[1][c] = colors[1][c] + distance;
+            paint[2][c] = colors[1][c];
+            paint[3][c] = colors[1][c] - distance;
+        }
+        else
+        {
+            paint[0][c] = colors[0][c] + distance;
+            paint[1][c] = colors[0][c] - distance;
+            paint[2][c] = colors[1][c] + distance;
+            paint[3][c] = colors[1][c] - distance;
+        }
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const int  index = getEtcIndex(block, i);
+        sf::Uint8* pixel = pixels + getEtcPixel(i) * 4;
+
+        if (punchthrough && (index == 2))
+            setPixel(pixel, 0, 0, 0, 0);
+        else
+            setPixel(pixel, paint[index][0], paint[index][1], paint[index][2], 255);
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Decode the planar mode of ETC2, which interpolates three colors over the block
+void decodeEtc2Planar(sf::Uint64 block, sf::Uint8* pixels)
+{
+    const int origin[3]     = {extend(static_cast<sf::Uint32>(getBits(block, 57, 6)), 6),
+                               extend(static_cast<sf::Uint32>((getBits(block, 56, 1) << 6) | getBits(block, 49, 6)), 7),
+                               extend(static_cast<sf::Uint32>((getBits(block, 48, 1) << 5) | (getBits(block, 43, 2) << 3) |
+                                                              getBits(block, 39, 3)),
+                                      6)};
+    const int horizontal[3] = {extend(static_cast<sf::Uint32>((getBits(block, 34, 5) << 1) | getBits(block, 32, 1)), 6),
+                               extend(static_cast<sf::Uint32>(getBits(block, 25, 7)), 7),
+                               extend(static_cast<sf::Uint32>(getBits(block, 19, 6)), 6)};
+    const int vertical[3]   = {extend(static_cast<sf::Uint32>(getBits(block, 13, 6)), 6),
+                               extend(static_cast<sf::Uint32>(getBits(block, 6, 7)), 7),
+                               extend(static_cast<sf::Uint32>(getBits(block, 0, 6)), 6)};
+
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+        {
+            int color[3];
+            for (int c = 0; c < 3; ++c)
+                color[c] = (x * (horizontal[c] - origin[c]) + y * (vertical[c] - origin[c]) + 4 * origin[c] + 2) >> 2;
+
+            setPixel(pixels + (y * 4 + x) * 4, color[0], color[1], color[2], 255);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Decode the RGB part of an ETC1 or ETC2 block
+void decodeEtc(const sf::Uint8* data, sf::Uint8* pixels, bool etc2, bool punchthrough)
+{
+    const sf::Uint64 block = readBigEndianUint64(data);
+
+    // With punch-through alpha, the differential mode is implied and its bit tells whether the block is opaque
+    const bool differential = punchthrough || getBits(block, 33, 1);
+    const bool opaque       = !punchthrough || getBits(block, 33, 1);
+    const bool flip         = getBits(block, 32, 1);
+
+    int colors[2][3];
+    if (differential)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            const int base  = getBits(block, 59 - 8 * c, 5);
+            const int other = base + signExtend3(getBits(block, 56 - 8 * c, 3));
+
+            // In ETC2, overflowing colors select the additional modes
+            if (etc2 && ((other < 0) || (other > 31)))
+            {
+                if (c == 2)
+                    decodeEtc2Planar(block, pixels);
+                else
+                    decodeEtc2Paint(block, pixels, c == 1, !opaque);
+                return;
+            }
+
+            colors[0][c] = extend(static_cast<sf::Uint32>(base), 5);
+            colors[1][c] = extend(static_cast<sf::Uint32>(other & 0x1F), 5);
+        }
+    }
+    else
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            colors[0][c] = getBits(block, 60 - 8 * c, 4) * 17;
+            colors[1][c] = getBits(block, 56 - 8 * c, 4) * 17;
+        }
+    }
+
+    const int tables[2] = {getBits(block, 37, 3), getBits(block, 34, 3)};
+
+    for (int i = 0; i < 16; ++i)
+    {
+        // Sub-blocks are either 2x4 (side by side) or 4x2 (on top of each other) when flipped
+        const int  x        = i / 4;
+        const int  y        = i % 4;
+        const int  subBlock = flip ? (y >= 2) : (x >= 2);
+        const int  index    = getEtcIndex(block, i);
+        const int* color    = colors[subBlock];
+        sf::Uint8* pixel    = pixels + getEtcPixel(i) * 4;
+
+        // Index 0 is +small, 1 is +large, 2 is -small and 3 is -large;
+        // without the opaque bit, small is 0 or transparent
+        if (!opaque && (index == 2))
+        {
+            setPixel(pixel, 0, 0, 0, 0);
+            continue;
+        }
+
+        int modifier = etcModifiers[tables[subBlock]][index & 1];
+        if (!opaque && ((index & 1) == 0))
+            modifier = 0;
+        if (index & 2)
+            modifier = -modifier;
+
+        setPixel(pixel, color[0] + modifier, color[1] + modifier, color[2] + modifier, 255);
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Decode the EAC alpha part of an ETC2 RGBA block
+void decodeEacAlpha(const sf::Uint8* data, sf::Uint8* pixels)
+{
+    const sf::Uint64 block      = readBigEndianUint64(data);
+    const int        base       = getBits(block, 56, 8);
+    const int        multiplier = getBits(block, 52, 4);
+    const int*       modifiers  = eacModifiers[getBits(block, 48, 4)];
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const int alpha = base + modifiers[getBits(block, 45 - 3 * i, 3)] * multiplier;
+        pixels[getEtcPixel(i) * 4 + 3] = static_cast<sf::Uint8>(std::clamp(alpha, 0, 255));
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Decode a block of any format to 4x4 RGBA pixels, row by row
+void decodeBlock(const sf::Uint8* block, sf::priv::CompressedFormat format, sf::Uint8* pixels)
+{
+    switch (format)
+    {
+        case sf::priv::BC1:
+            decodeBc1(block, pixels, false, false);
+            break;
+        case sf::priv::BC1A:
+            decodeBc1(block, pixels, true, false);
+            break;
+        case sf::priv::BC2:
+            decodeBc1(block + 8, pixels, false, true);
+            decodeBc2Alpha(block, pixels);
+            break;
+        case sf::priv::BC3:
+            decodeBc1(block + 8, pixels, false, true);
+            decodeBc4(block, pixels, 3);
+            break;
+        case sf::priv::BC4:
+            for (int i = 0; i < 16; ++i)
+                setPixel(pixels + i * 4, 0, 0, 0, 255);
+            decodeBc4(block, pixels, 0);
+            break;
+        case sf::priv::BC5:
+            for (int i = 0; i < 16; ++i)
+                setPixel(pixels + i * 4, 0, 0, 0, 255);
+            decodeBc4(block, pixels, 0);
+            decodeBc4(block + 8, pixels, 1);
+            break;
+        case sf::priv::BC7:
+            decodeBc7(block, pixels);
+            break;
+        case sf::priv::ETC1:
+            decodeEtc(block, pixels, false, false);
+            break;
+        case sf::priv::ETC2RGB:
+            decodeEtc(block, pixels, true, false);
+            break;
+        case sf::priv::ETC2RGBA1:
+            decodeEtc(block, pixels, true, true);
+            break;
+        case sf::priv::ETC2RGBA:
+            decodeEtc(block + 8, pixels, true, false);
+            decodeEacAlpha(block, pixels);
+            break;
+    }
+}
+} // namespace CompressedImageImpl
+} // namespace
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool isCompressedImage(const void* data, std::size_t dataSize)
+{
+    const auto* bytes = static_cast<const Uint8*>(data);
+
+    return bytes && (CompressedImageImpl::hasSignature(bytes, dataSize, CompressedImageImpl::ddsSignature) ||
+                     CompressedImageImpl::hasSignature(bytes, dataSize, CompressedImageImpl::ktxSignature) ||
+                     CompressedImageImpl::hasSignature(bytes, dataSize, CompressedImageImpl::ktx2Signature));
+}
+
+
+////////////////////////////////////////////////////////////
+bool readCompressedImageFile(const std::filesystem::path& filename, std::vector<Uint8>& data)
+{
+    std::ifstream file(filename, std::ios_base::binary);
+    if (!file)
+        return false;
+
+    char signature[CompressedImageImpl::signatureSize];
+    file.read(signature, sizeof(signature));
+    if (!isCompressedImage(signature, static_cast<std::size_t>(file.gcount())))
+        return false;
+
+    // Failures to read the rest of the file result in empty data, which fails to be parsed
+    file.clear();
+    file.seekg(0, std::ios_base::end);
+    const std::streamoff size = file.tellg();
+    file.seekg(0, std::ios_base::beg);
+
+    data.resize(size > 0 ? static_cast<std::size_t>(size) : 0);
+    if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())))
+        data.clear();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool readCompressedImageStream(InputStream& stream, std::vector<Uint8>& data)
+{
+    Uint8 signature[CompressedImageImpl::signatureSize];
+    if (stream.seek(0) == -1)
+        return false;
+
+    const Int64 signatureRead = stream.read(signature, static_cast<Int64>(sizeof(signature)));
+    if ((signatureRead <= 0) || !isCompressedImage(signature, static_cast<std::size_t>(signatureRead)))
+        return false;
+
+    // Failures to read the rest of the stream result in empty data, which fails to be parsed
+    const Int64 size = stream.getSize();
+    data.resize(size > 0 ? static_cast<std::size_t>(size) : 0);
+    if ((stream.seek(0) == -1) || (stream.read(data.data(), static_cast<Int64>(data.size())) != size))
+        data.clear();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool parseCompressedImage(const void* data, std::size_t dataSize, CompressedImage& image)
+{
+    const auto* bytes = static_cast<const Uint8*>(data);
+
+    image.levels.clear();
+
+    if (bytes && CompressedImageImpl::hasSignature(bytes, dataSize, CompressedImageImpl::ddsSignature))
+        return CompressedImageImpl::parseDds(bytes, dataSize, image);
+
+    if (bytes && CompressedImageImpl::hasSignature(bytes, dataSize, CompressedImageImpl::ktxSignature))
+        return CompressedImageImpl::parseKtx(bytes, dataSize, image);
+
+    if (bytes && CompressedImageImpl::hasSignature(bytes, dataSize, CompressedImageImpl::ktx2Signature))
+        return CompressedImageImpl::parseKtx2(bytes, dataSize, image);
+
+    err() << "Failed to load compressed image, unknown container format" << std::endl;
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t getCompressedBlockSize(CompressedFormat format)
+{
+    switch (format)
+    {
+        case BC1:
+        case BC1A:
+        case BC4:
+        case ETC1:
+        case ETC2RGB:
+        case ETC2RGBA1:
+            return 8;
+        default:
+            return 16;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void decompressImage(const CompressedImage::Level& level, CompressedFormat format, Uint8* pixels)
+{
+    const std::size_t width       = level.size.x;
+    const std::size_t height      = level.size.y;
+    const std::size_t blocksX     = (width + 3) / 4;
+    const std::size_t blocksY     = (height + 3) / 4;
+    const std::size_t blockSize   = getCompressedBlockSize(format);
+    const std::size_t minRowCount = std::max<std::size_t>(CompressedImageImpl::minBlocksPerThread / blocksX, 1);
+
+    parallelFor(blocksY,
+                minRowCount,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    Uint8 blockPixels[16 * 4];
+
+                    for (std::size_t blockY = begin; blockY < end; ++blockY)
+                    {
+                        for (std::size_t blockX = 0; blockX < blocksX; ++blockX)
+                        {
+                            const Uint8* block = level.data + (blockY * blocksX + blockX) * blockSize;
+                            CompressedImageImpl::decodeBlock(block, format, blockPixels);
+
+                            // Blocks on the right and bottom edges may be partially outside of the image
+                            const std::size_t x     = blockX * 4;
+                            const std::size_t y     = blockY * 4;
+                            const std::size_t countX = std::min<std::size_t>(4, width - x);
+                            const std::size_t countY = std::min<std::size_t>(4, height - y);
+                            for (std::size_t row = 0; row < countY; ++row)
+                                std::memcpy(pixels + ((y + row) * width + x) * 4, blockPixels + row * 16, countX * 4);
+                        }
+                    }
+                });
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COMPRESSEDIMAGE_HPP
+#define SFML_COMPRESSEDIMAGE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Block compression formats of compressed images
+///
+/// All formats encode blocks of 4x4 pixels.
+///
+////////////////////////////////////////////////////////////
+enum CompressedFormat
+{
+    BC1,       //!< BC1 / DXT1, opaque RGB
+    BC1A,      //!< BC1 / DXT1 with 1-bit alpha
+    BC2,       //!< BC2 / DXT3, RGB with explicit 4-bit alpha
+    BC3,       //!< BC3 / DXT5, RGB with interpolated alpha
+    BC4,       //!< BC4 / RGTC1, single red component
+    BC5,       //!< BC5 / RGTC2, red and green components
+    BC7,       //!< BC7 / BPTC, high quality RGBA
+    ETC1,      //!< ETC1, opaque RGB
+    ETC2RGB,   //!< ETC2, opaque RGB
+    ETC2RGBA1, //!< ETC2 with 1-bit alpha
+    ETC2RGBA   //!< ETC2 with EAC alpha
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Compressed image stored in a KTX, KTX2 or DDS container
+///
+/// The levels point into the container data, which must stay
+/// alive as long as the compressed image is used.
+///
+////////////////////////////////////////////////////////////
+struct CompressedImage
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Single mipmap level of a compressed image
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Level
+    {
+        Vector2u     size;     //!< Size of the level, in pixels
+        const Uint8* data;     //!< Compressed blocks of the level
+        std::size_t  dataSize; //!< Size of the compressed blocks, in bytes
+    };
+
+    CompressedFormat   format; //!< Block compression format
+    std::vector<Level> levels; //!< Mipmap levels, starting with the full size image
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Tell whether some data starts like a compressed image container
+///
+/// Only the signature of the container is checked, the data
+/// may still fail to be parsed.
+///
+/// \param data     Pointer to the file data
+/// \param dataSize Size of the data, in bytes
+///
+/// \return True if the data is a KTX, KTX2 or DDS container
+///
+////////////////////////////////////////////////////////////
+[[nodiscard]] bool isCompressedImage(const void* data, std::size_t dataSize);
+
+////////////////////////////////////////////////////////////
+/// \brief Read a file entirely if it is a compressed image container
+///
+/// Only the signature is read from other files, so that they
+/// can be handed to the regular image loaders.
+///
+/// \param filename Path of the file to read
+/// \param data     Array to fill with the file data
+///
+/// \return True if the file is a KTX, KTX2 or DDS container
+///
+////////////////////////////////////////////////////////////
+[[nodiscard]] bool readCompressedImageFile(const std::filesystem::path& filename, std::vector<Uint8>& data);
+
+////////////////////////////////////////////////////////////
+/// \brief Read a stream entirely if it is a compressed image container
+///
+/// Only the signature is read from other streams, which are
+/// then rewound by the regular image loaders.
+///
+/// \param stream Stream to read
+/// \param data   Array to fill with the stream data
+///
+/// \return True if the stream is a KTX, KTX2 or DDS container
+///
+////////////////////////////////////////////////////////////
+[[nodiscard]] bool readCompressedImageStream(InputStream& stream, std::vector<Uint8>& data);
+
+////////////////////////////////////////////////////////////
+/// \brief Parse a KTX, KTX2 or DDS container
+///
+/// Only 2D textures (no array, cube map or volume) of the
+/// formats of sf::priv::CompressedFormat without supercompression
+/// are supported; an error is written to sf::err() otherwise.
+/// Images wider or taller than 65536 pixels are rejected, so
+/// that the base level can always be decompressed in memory.
+///
+/// \param data     Pointer to the file data
+/// \param dataSize Size of the data, in bytes
+/// \param image    Compressed image to fill, pointing into \a data
+///
+/// \return True if parsing was successful
+///
+////////////////////////////////////////////////////////////
+[[nodiscard]] bool parseCompressedImage(const void* data, std::size_t dataSize, CompressedImage& image);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the number of bytes of a block of a compressed format
+///
+/// \param format Block compression format
+///
+/// \return Size of a 4x4 block, in bytes
+///
+////////////////////////////////////////////////////////////
+[[nodiscard]] std::size_t getCompressedBlockSize(CompressedFormat format);
+
+////////////////////////////////////////////////////////////
+/// \brief Decompress a level of a compressed image to RGBA pixels
+///
+/// Formats without alpha decode to opaque pixels, and formats
+/// with only red (and green) components set the other color
+/// components to 0, like OpenGL does when sampling them.
+/// Large levels are decoded on several threads.
+///
+/// \param level  Level to decompress
+/// \param format Block compression format of the level
+/// \param pixels Destination of level.size.x * level.size.y RGBA pixels
+///
+////////////////////////////////////////////////////////////
+void decompressImage(const CompressedImage::Level& level, CompressedFormat format, Uint8* pixels);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDIMAGE_HPP
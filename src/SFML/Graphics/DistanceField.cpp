@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DistanceField.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+
+namespace
+{
+// A nested named namespace is used here to allow unity builds of SFML.
+namespace DistanceFieldImpl
+{
+// Squared distance of the pixels which are not seeds
+const float infinity = 1e20f;
+
+////////////////////////////////////////////////////////////
+// Squared Euclidean distance transform of a row or column of n samples
+// (Felzenszwalb and Huttenlocher), f is the input and d the output;
+// v and z are scratch buffers of at least n and n + 1 elements
+////////////////////////////////////////////////////////////
+void transform(const float* f, float* d, std::size_t n, std::size_t* v, float* z)
+{
+    // Lower envelope of the parabolas rooted at each sample
+    std::size_t k = 0;
+    v[0]          = 0;
+    z[0]          = -infinity;
+    z[1]          = infinity;
+
+    for (std::size_t q = 1; q < n; ++q)
+    {
+        const auto fq           = static_cast<float>(q);
+        const auto intersection = [&]
+        {
+            const auto fv = static_cast<float>(v[k]);
+            return ((f[q] + fq * fq) - (f[v[k]] + fv * fv)) / (2 * fq - 2 * fv);
+        };
+
+        // Remove the parabolas hidden by the new one, the first one is never removed as z[0] is -infinity
+        float s = intersection();
+        while (s <= z[k])
+        {
+            --k;
+            s = intersection();
+        }
+
+        ++k;
+        v[k]     = q;
+        z[k]     = s;
+        z[k + 1] = infinity;
+    }
+
+    // Evaluate the envelope at each sample
+    k = 0;
+    for (std::size_t q = 0; q < n; ++q)
+    {
+        while (z[k + 1] < static_cast<float>(q))
+            ++k;
+
+        const float delta = static_cast<float>(q) - static_cast<float>(v[k]);
+        d[q]              = delta * delta + f[v[k]];
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Squared Euclidean distance transform of a grid, in place: samples must be 0 for seeds and infinity elsewhere
+////////////////////////////////////////////////////////////
+void transform(std::vector<float>& grid, std::size_t width, std::size_t height)
+{
+    const std::size_t        length = std::max(width, height);
+    std::vector<float>       f(length);
+    std::vector<float>       d(length);
+    std::vector<std::size_t> v(length);
+    std::vector<float>       z(length + 1);
+
+    // Columns first
+    for (std::size_t x = 0; x < width; ++x)
+    {
+        for (std::size_t y = 0; y < height; ++y)
+            f[y] = grid[y * width + x];
+
+        transform(f.data(), d.data(), height, v.data(), z.data());
+
+        for (std::size_t y = 0; y < height; ++y)
+            grid[y * width + x] = d[y];
+    }
+
+    // Then rows, which are contiguous
+    for (std::size_t y = 0; y < height; ++y)
+    {
+        float* row = grid.data() + y * width;
+        std::copy(row, row + width, f.begin());
+        transform(f.data(), row, width, v.data(), z.data());
+    }
+}
+} // namespace DistanceFieldImpl
+} // namespace
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void computeDistanceField(Uint8* pixels, const Vector2u& size, float spread)
+{
+    using namespace DistanceFieldImpl;
+
+    const std::size_t width  = size.x;
+    const std::size_t height = size.y;
+    const std::size_t count  = width * height;
+    if (count == 0)
+        return;
+
+    // Distances from the outside pixels to the inside, and from the inside pixels to the outside
+    std::vector<float> toInside(count);
+    std::vector<float> toOutside(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const bool inside = pixels[i * 4 + 3] >= 128;
+        toInside[i]       = inside ? 0 : infinity;
+        toOutside[i]      = inside ? infinity : 0;
+    }
+
+    transform(toInside, width, height);
+    transform(toOutside, width, height);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Uint8&      alpha    = pixels[i * 4 + 3];
+        const float coverage = static_cast<float>(alpha) / 255.f;
+
+        // The edge lies halfway between an inside pixel and its nearest outside pixel; when it crosses
+        // the pixel, the coverage gives a better estimate of the distance
+        float distance = 0;
+        if ((alpha > 0) && (alpha < 255))
+            distance = coverage - 0.5f;
+        else if (alpha >= 128)
+            distance = (toOutside[i] < infinity) ? std::sqrt(toOutside[i]) - 0.5f : spread;
+        else
+            distance = (toInside[i] < infinity) ? 0.5f - std::sqrt(toInside[i]) : -spread;
+
+        const float value = std::clamp(0.5f + distance / (2 * spread), 0.f, 1.f);
+        alpha             = static_cast<Uint8>(value * 255.f + 0.5f);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
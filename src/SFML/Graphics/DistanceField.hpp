@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DISTANCEFIELD_HPP
+#define SFML_DISTANCEFIELD_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Replace the coverage of RGBA pixels by its signed distance field
+///
+/// On input, the alpha channel holds the coverage of a shape
+/// (0 outside, 255 inside). On output, it holds the distance
+/// of each pixel to the edge of the shape: 128 on the edge,
+/// increasing inside and decreasing outside, reaching 255 and
+/// 0 at \a spread pixels from the edge. The color channels
+/// are left unchanged.
+///
+/// Distances are computed exactly from the pixels covered by
+/// more than a half, and refined with the coverage of the
+/// pixels which are crossed by the edge.
+///
+/// \param pixels RGBA pixels to process, row by row without padding
+/// \param size   Size of the image, in pixels
+/// \param spread Distance mapped to the range of each side of the edge, in pixels
+///
+////////////////////////////////////////////////////////////
+void computeDistanceField(Uint8* pixels, const Vector2u& size, float spread);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_DISTANCEFIELD_HPP
@@ -25,27 +25,43 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DistanceField.hpp>
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/SkylinePacker.hpp>
 #ifdef SFML_SYSTEM_ANDROID
 #include <SFML/System/Android/ResourceStream.hpp>
 #endif
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Utils.hpp>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include FT_ADVANCES_H
 #include FT_GLYPH_H
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
 #include FT_STROKER_H
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <cmath>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
 #include <ostream>
+#include <thread>
 #include <type_traits>
+#include <unordered_set>
+#include <utility>
 
 
 namespace
@@ -84,6 +100,39 @@ sf::Uint64 combine(float outlineThickness, bool bold, sf::Uint32 index)
     return (static_cast<sf::Uint64>(reinterpret<sf::Uint32>(outlineThickness)) << 32) |
            (static_cast<sf::Uint64>(bold) << 31) | index;
 }
+
+// Small padding left around glyphs, so that filtering doesn't pollute them with pixels from neighbors
+const unsigned int glyphPadding = 2;
+
+// Number of glyphs rasterized by preloadGlyphs before they are written to the textures
+const std::size_t preloadBatchSize = 256;
+
+// 2x2 white square at the top-left corner of the first texture of a page, used to texture underlines
+const sf::Uint8 whiteSquare[2 * 2 * 4] =
+    {255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255};
+
+// Shader drawing distance field glyphs, with antialiasing adapted to the scale at which they are drawn
+const char* const distanceFieldVertexShader = R"(
+void main()
+{
+    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+    gl_TexCoord[0] = gl_TextureMatrix[0] * gl_MultiTexCoord0;
+    gl_FrontColor = gl_Color;
+}
+)";
+
+const char* const distanceFieldFragmentShader = R"(
+uniform sampler2D texture;
+uniform float threshold;
+
+void main()
+{
+    float distance = texture2D(texture, gl_TexCoord[0].xy).a;
+    float width = 0.7 * fwidth(distance);
+    float alpha = smoothstep(threshold - width, threshold + width, distance);
+    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);
+}
+)";
 } // namespace
 
 
@@ -115,11 +164,149 @@ public:
     std::unique_ptr<FT_StreamRec>                               streamRec; //< Pointer to the stream rec instance
     std::unique_ptr<std::remove_pointer_t<FT_Face>, Deleter>    face;      //< Pointer to the internal font face
     std::unique_ptr<std::remove_pointer_t<FT_Stroker>, Deleter> stroker;   //< Pointer to the stroker
+    std::mutex                                                  mutex;     //< Protects the FreeType objects
+};
+
+
+////////////////////////////////////////////////////////////
+struct Font::RasterizedGlyph
+{
+    Uint64             key{0};              //< Key of the glyph in the tables of its page
+    Uint32             codePoint{0};        //< Unicode code point of the character
+    unsigned int       characterSize{0};    //< Reference character size
+    bool               bold{false};         //< Bold version or regular one?
+    float              outlineThickness{0}; //< Thickness of the outline
+    bool               distanceField{false}; //< Distance field version or regular one?
+    unsigned int       padding{0};          //< Padding around the glyph's pixels
+    Glyph              glyph;               //< Metrics of the glyph, its texture rectangle is set when it is placed
+    Vector2u           size;                //< Size of the glyph's pixels, including padding
+    std::vector<Uint8> pixels;              //< RGBA pixels of the glyph, including padding
+    Time               time;                //< Time spent rasterizing the glyph
+};
+
+
+////////////////////////////////////////////////////////////
+class Font::GlyphLoader
+{
+public:
+    ////////////////////////////////////////////////////////////
+    explicit GlyphLoader(std::shared_ptr<FontHandles> fontHandles) : m_fontHandles(std::move(fontHandles))
+    {
+        try
+        {
+            m_thread = std::thread(&GlyphLoader::run, this);
+        }
+        catch (const std::exception&)
+        {
+            // The thread couldn't be created: requests are refused, and glyphs are loaded when requested
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    ~GlyphLoader()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_condition.notify_one();
+
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Queue a glyph for rasterization, returns false if the thread is not running
+    ////////////////////////////////////////////////////////////
+    bool push(RasterizedGlyph glyph)
+    {
+        if (!m_thread.joinable())
+            return false;
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_requests.push_back(std::move(glyph));
+            ++m_pendingCount;
+        }
+        m_condition.notify_one();
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Take the glyphs rasterized so far, returns false if there is none
+    ////////////////////////////////////////////////////////////
+    bool takeResults(std::vector<RasterizedGlyph>& glyphs)
+    {
+        // Checked without locking, as it is done every time a glyph is requested
+        if (!m_hasResults)
+            return false;
+
+        std::lock_guard lock(m_mutex);
+        glyphs.swap(m_results);
+        m_pendingCount -= glyphs.size();
+        m_hasResults = false;
+
+        return !glyphs.empty();
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_pendingCount;
+    }
+
+private:
+    ////////////////////////////////////////////////////////////
+    // Entry point of the loading thread
+    ////////////////////////////////////////////////////////////
+    void run()
+    {
+        for (;;)
+        {
+            RasterizedGlyph glyph;
+
+            {
+                std::unique_lock lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_stop || !m_requests.empty(); });
+                if (m_stop)
+                    return;
+
+                glyph = std::move(m_requests.front());
+                m_requests.pop_front();
+            }
+
+            rasterizeGlyph(*m_fontHandles, glyph);
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_results.push_back(std::move(glyph));
+                m_hasResults = true;
+            }
+        }
+    }
+
+    std::shared_ptr<FontHandles> m_fontHandles;       //< FreeType objects of the font
+    mutable std::mutex           m_mutex;             //< Protects the requests and the results
+    std::condition_variable      m_condition;         //< Signaled when a request is added or the thread must stop
+    std::deque<RasterizedGlyph>  m_requests;          //< Glyphs waiting to be rasterized
+    std::vector<RasterizedGlyph> m_results;           //< Rasterized glyphs not taken yet
+    std::atomic<bool>            m_hasResults{false}; //< Are there rasterized glyphs to take?
+    std::size_t                  m_pendingCount{0};   //< Number of glyphs requested and not taken yet
+    bool                         m_stop{false};       //< Tells the thread to stop
+    std::thread                  m_thread;            //< Loading thread
 };
 
 
 ////////////////////////////////////////////////////////////
-Font::Font() : m_fontHandles(), m_isSmooth(true), m_info()
+Font::Font() :
+m_fontHandles(),
+m_isSmooth(true),
+m_info(),
+m_isAsyncGlyphLoading(false),
+m_rasterizedGlyphCount(0),
+m_isDistanceFieldEnabled(false)
 {
 }
 
@@ -130,8 +317,19 @@ m_fontHandles(copy.m_fontHandles),
 m_isSmooth(copy.m_isSmooth),
 m_info(copy.m_info),
 m_pages(copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_pixelBuffer(copy.m_pixelBuffer),
+m_isAsyncGlyphLoading(copy.m_isAsyncGlyphLoading),
+m_rasterizedGlyphCount(copy.m_rasterizedGlyphCount),
+m_rasterizationTime(copy.m_rasterizationTime),
+m_isDistanceFieldEnabled(copy.m_isDistanceFieldEnabled),
+m_distanceFieldPage(copy.m_distanceFieldPage)
 {
+    // The glyphs queued by the loading thread of the copied font will not be written to our textures
+    for (auto& [characterSize, page] : m_pages)
+        page.placeholders.clear();
+
+    if (m_distanceFieldPage)
+        m_distanceFieldPage->placeholders.clear();
 }
 
 
@@ -352,55 +550,48 @@ const Font::Info& Font::getInfo() const
 ////////////////////////////////////////////////////////////
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
-    // Get the page corresponding to the character size
-    GlyphTable& glyphs = loadPage(characterSize).glyphs;
-
-    // Build the key by combining the glyph index (based on code point), bold flag, and outline thickness
-    Uint64 key = combine(outlineThickness,
-                         bold,
-                         FT_Get_Char_Index(m_fontHandles ? m_fontHandles->face.get() : nullptr, codePoint));
-
-    // Search the glyph into the cache
-    if (auto it = glyphs.find(key); it != glyphs.end())
-    {
-        // Found: just return it
-        return it->second;
-    }
-    else
-    {
-        // Not found: we have to load it
-        Glyph glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness);
-        return glyphs.emplace(key, glyph).first->second;
-    }
+    return getGlyph(codePoint, characterSize, bold, outlineThickness, false);
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Font::hasGlyph(Uint32 codePoint) const
 {
-    return FT_Get_Char_Index(m_fontHandles ? m_fontHandles->face.get() : nullptr, codePoint) != 0;
+    return getCharIndex(codePoint) != 0;
 }
 
 
 ////////////////////////////////////////////////////////////
 float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize, bool bold) const
+{
+    return getKerning(first, second, characterSize, bold, false);
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize, bool bold, bool distanceField) const
 {
     // Special case where first or second is 0 (null character)
     if (first == 0 || second == 0)
         return 0.f;
 
-    auto face = m_fontHandles ? m_fontHandles->face.get() : nullptr;
+    if (!m_fontHandles)
+        return 0.f;
+
+    // Retrieve position compensation deltas generated by FT_LOAD_FORCE_AUTOHINT flag
+    // (before locking the face, which loading the glyphs locks too)
+    auto firstRsbDelta  = static_cast<float>(getGlyph(first, characterSize, bold, 0, distanceField).rsbDelta);
+    auto secondLsbDelta = static_cast<float>(getGlyph(second, characterSize, bold, 0, distanceField).lsbDelta);
 
-    if (face && setCurrentSize(characterSize))
+    std::lock_guard lock(m_fontHandles->mutex);
+    auto            face = m_fontHandles->face.get();
+
+    if (face && setCurrentSize(*m_fontHandles, characterSize))
     {
         // Convert the characters to indices
         FT_UInt index1 = FT_Get_Char_Index(face, first);
         FT_UInt index2 = FT_Get_Char_Index(face, second);
 
-        // Retrieve position compensation deltas generated by FT_LOAD_FORCE_AUTOHINT flag
-        auto firstRsbDelta  = static_cast<float>(getGlyph(first, characterSize, bold).rsbDelta);
-        auto secondLsbDelta = static_cast<float>(getGlyph(second, characterSize, bold).lsbDelta);
-
         // Get the kerning vector if present
         FT_Vector kerning;
         kerning.x = kerning.y = 0;
@@ -427,9 +618,13 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize,
 ////////////////////////////////////////////////////////////
 float Font::getLineSpacing(unsigned int characterSize) const
 {
-    auto face = m_fontHandles ? m_fontHandles->face.get() : nullptr;
+    if (!m_fontHandles)
+        return 0.f;
+
+    std::lock_guard lock(m_fontHandles->mutex);
+    auto            face = m_fontHandles->face.get();
 
-    if (face && setCurrentSize(characterSize))
+    if (face && setCurrentSize(*m_fontHandles, characterSize))
     {
         return static_cast<float>(face->size->metrics.height) / static_cast<float>(1 << 6);
     }
@@ -443,9 +638,13 @@ float Font::getLineSpacing(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 float Font::getUnderlinePosition(unsigned int characterSize) const
 {
-    auto face = m_fontHandles ? m_fontHandles->face.get() : nullptr;
+    if (!m_fontHandles)
+        return 0.f;
+
+    std::lock_guard lock(m_fontHandles->mutex);
+    auto            face = m_fontHandles->face.get();
 
-    if (face && setCurrentSize(characterSize))
+    if (face && setCurrentSize(*m_fontHandles, characterSize))
     {
         // Return a fixed position if font is a bitmap font
         if (!FT_IS_SCALABLE(face))
@@ -464,9 +663,13 @@ float Font::getUnderlinePosition(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 float Font::getUnderlineThickness(unsigned int characterSize) const
 {
-    auto face = m_fontHandles ? m_fontHandles->face.get() : nullptr;
+    if (!m_fontHandles)
+        return 0.f;
+
+    std::lock_guard lock(m_fontHandles->mutex);
+    auto            face = m_fontHandles->face.get();
 
-    if (face && setCurrentSize(characterSize))
+    if (face && setCurrentSize(*m_fontHandles, characterSize))
     {
         // Return a fixed thickness if font is a bitmap font
         if (!FT_IS_SCALABLE(face))
@@ -483,9 +686,18 @@ float Font::getUnderlineThickness(unsigned int characterSize) const
 
 
 ////////////////////////////////////////////////////////////
-const Texture& Font::getTexture(unsigned int characterSize) const
+const Texture& Font::getTexture(unsigned int characterSize, unsigned int page) const
+{
+    return getTexture(characterSize, page, false);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::getTextureCount(unsigned int characterSize) const
 {
-    return loadPage(characterSize).texture;
+    processLoadedGlyphs();
+
+    return loadPage(characterSize).textures.size();
 }
 
 ////////////////////////////////////////////////////////////
@@ -497,7 +709,8 @@ void Font::setSmooth(bool smooth)
 
         for (auto& [key, page] : m_pages)
         {
-            page.texture.setSmooth(m_isSmooth);
+            for (Texture& texture : page.textures)
+                texture.setSmooth(m_isSmooth);
         }
     }
 }
@@ -509,6 +722,147 @@ bool Font::isSmooth() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Font::preloadGlyphs(Uint32 first, Uint32 last, unsigned int characterSize, bool bold, float outlineThickness)
+{
+    if (!m_fontHandles)
+        return;
+
+    processLoadedGlyphs();
+
+    // Texts drawing distance fields use the same glyphs whatever their character size and outline thickness
+    const bool distanceField = getDistanceFieldShader() != nullptr;
+    if (distanceField)
+    {
+        characterSize    = distanceFieldSize;
+        outlineThickness = 0;
+    }
+
+    Page& page = loadPage(characterSize, distanceField);
+
+    std::vector<RasterizedGlyph> glyphs;
+    std::unordered_set<Uint64>   keys;
+
+    for (Uint64 codePoint = first; codePoint <= last; ++codePoint)
+    {
+        // Characters missing from the font are skipped, they all share the same glyph which is loaded when requested
+        const unsigned int index = getCharIndex(static_cast<Uint32>(codePoint));
+        if (index == 0)
+            continue;
+
+        // Skip the glyphs which are loaded already, and the ones shared by several characters of the range
+        const Uint64 key = combine(outlineThickness, bold, index);
+        if ((page.glyphs.count(key) > 0) || !keys.insert(key).second)
+            continue;
+
+        if (m_isAsyncGlyphLoading &&
+            requestGlyph(page, key, static_cast<Uint32>(codePoint), characterSize, bold, outlineThickness,
+                         distanceField))
+            continue;
+
+        RasterizedGlyph& glyph = glyphs.emplace_back();
+        glyph.key              = key;
+        glyph.codePoint        = static_cast<Uint32>(codePoint);
+        glyph.characterSize    = characterSize;
+        glyph.bold             = bold;
+        glyph.outlineThickness = outlineThickness;
+        glyph.distanceField    = distanceField;
+        rasterizeGlyph(*m_fontHandles, glyph);
+
+        // Write the glyphs to the textures in batches, to bound the memory used by their pixels
+        if (glyphs.size() == preloadBatchSize)
+        {
+            insertGlyphs(glyphs);
+            glyphs.clear();
+        }
+    }
+
+    insertGlyphs(glyphs);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setAsyncGlyphLoading(bool async)
+{
+    if (async == m_isAsyncGlyphLoading)
+        return;
+
+    m_isAsyncGlyphLoading = async;
+
+    if (!async)
+    {
+        // Write the glyphs rasterized so far and stop the loading thread,
+        // the glyphs still queued will be loaded when they are requested
+        processLoadedGlyphs();
+        m_glyphLoader.reset();
+
+        const auto clearPlaceholders = [](Page& page)
+        {
+            if (page.placeholders.empty())
+                return;
+
+            page.placeholders.clear();
+
+            // Texts only rebuild their geometry, and request their glyphs again, when
+            // the first texture of their character size changes: make sure that it does
+            page.textures.front().update(whiteSquare, {2, 2}, {0, 0});
+        };
+
+        for (auto& [characterSize, page] : m_pages)
+            clearPlaceholders(page);
+
+        if (m_distanceFieldPage)
+            clearPlaceholders(*m_distanceFieldPage);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isAsyncGlyphLoading() const
+{
+    return m_isAsyncGlyphLoading;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::getPendingGlyphCount() const
+{
+    return m_glyphLoader ? m_glyphLoader->getPendingCount() : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::getRasterizedGlyphCount() const
+{
+    return m_rasterizedGlyphCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Time Font::getRasterizationTime() const
+{
+    return m_rasterizationTime;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setDistanceFieldEnabled(bool enabled)
+{
+    m_isDistanceFieldEnabled = enabled;
+
+    // Free the distance field glyphs, texts notice that the font texture changed and use the regular glyphs
+    if (!enabled)
+        m_distanceFieldPage.reset();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isDistanceFieldEnabled() const
+{
+    return m_isDistanceFieldEnabled;
+}
+
+
 ////////////////////////////////////////////////////////////
 Font& Font::operator=(const Font& right)
 {
@@ -519,6 +873,13 @@ Font& Font::operator=(const Font& right)
     std::swap(m_info, temp.m_info);
     std::swap(m_pages, temp.m_pages);
     std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    std::swap(m_isAsyncGlyphLoading, temp.m_isAsyncGlyphLoading);
+    std::swap(m_glyphLoader, temp.m_glyphLoader);
+    std::swap(m_rasterizedGlyphCount, temp.m_rasterizedGlyphCount);
+    std::swap(m_rasterizationTime, temp.m_rasterizationTime);
+    std::swap(m_isDistanceFieldEnabled, temp.m_isDistanceFieldEnabled);
+    std::swap(m_distanceFieldPage, temp.m_distanceFieldPage);
+    std::swap(m_distanceFieldShader, temp.m_distanceFieldShader);
 
 #ifdef SFML_SYSTEM_ANDROID
     std::swap(m_stream, temp.m_stream);
@@ -531,52 +892,294 @@ Font& Font::operator=(const Font& right)
 ////////////////////////////////////////////////////////////
 void Font::cleanup()
 {
+    // Stop the loading thread, its glyphs belong to the previous font
+    m_glyphLoader.reset();
+
     // Drop ownership of shared FreeType pointers
     m_fontHandles.reset();
 
     // Reset members
     m_pages.clear();
+    m_distanceFieldPage.reset();
     std::vector<Uint8>().swap(m_pixelBuffer);
+    m_rasterizedGlyphCount = 0;
+    m_rasterizationTime    = Time::Zero;
 }
 
 
 ////////////////////////////////////////////////////////////
-Font::Page& Font::loadPage(unsigned int characterSize) const
+const Glyph& Font::getGlyph(Uint32       codePoint,
+                            unsigned int characterSize,
+                            bool         bold,
+                            float        outlineThickness,
+                            bool         distanceField) const
 {
-    return m_pages.try_emplace(characterSize, m_isSmooth).first->second;
+    // Write the glyphs rasterized by the loading thread first, the requested one may be among them
+    processLoadedGlyphs();
+
+    // Get the page corresponding to the character size
+    Page&       page   = loadPage(characterSize, distanceField);
+    GlyphTable& glyphs = page.glyphs;
+
+    // Build the key by combining the glyph index (based on code point), bold flag, and outline thickness
+    Uint64 key = combine(outlineThickness, bold, getCharIndex(codePoint));
+
+    // Search the glyph into the cache
+    if (auto it = glyphs.find(key); it != glyphs.end())
+    {
+        // Found: just return it
+        return it->second;
+    }
+
+    // Not found: queue it for the loading thread if asynchronous loading is enabled
+    if (m_isAsyncGlyphLoading && m_fontHandles)
+    {
+        if (const Glyph* placeholder =
+                requestGlyph(page, key, codePoint, characterSize, bold, outlineThickness, distanceField))
+            return *placeholder;
+    }
+
+    // Otherwise we have to load it now
+    Glyph glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness, distanceField);
+    return glyphs.emplace(key, glyph).first->second;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& Font::getTexture(unsigned int characterSize, unsigned int page, bool distanceField) const
+{
+    processLoadedGlyphs();
+
+    const Page& glyphPage = loadPage(characterSize, distanceField);
+    assert(page < glyphPage.textures.size());
+    return glyphPage.textures[page];
+}
+
+
+////////////////////////////////////////////////////////////
+Shader* Font::getDistanceFieldShader() const
+{
+    if (!m_isDistanceFieldEnabled || !Shader::isAvailable())
+        return nullptr;
+
+    // Load the shader the first time it is needed, a failure is only reported once
+    if (!m_distanceFieldShader)
+    {
+        m_distanceFieldShader = std::make_unique<Shader>();
+        if (m_distanceFieldShader->loadFromMemory(distanceFieldVertexShader, distanceFieldFragmentShader))
+        {
+            // Texts only change the threshold to draw their outline, and restore it afterwards
+            m_distanceFieldShader->setUniform("texture", Shader::CurrentTexture);
+            m_distanceFieldShader->setUniform("threshold", 0.5f);
+        }
+        else
+        {
+            err() << "Failed to load the distance field shader, texts will draw regular glyphs" << std::endl;
+        }
+    }
+
+    return m_distanceFieldShader->getNativeHandle() != 0 ? m_distanceFieldShader.get() : nullptr;
 }
 
 
 ////////////////////////////////////////////////////////////
-Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
+Font::Page& Font::loadPage(unsigned int characterSize, bool distanceField) const
 {
-    // The glyph to return
-    Glyph glyph;
+    // Distance fields are always filtered, their edges are reconstructed between texels
+    if (distanceField)
+    {
+        if (!m_distanceFieldPage)
+            m_distanceFieldPage.emplace(true);
+
+        return *m_distanceFieldPage;
+    }
+
+    return m_pages.try_emplace(characterSize, m_isSmooth).first->second;
+}
+
 
+////////////////////////////////////////////////////////////
+Glyph Font::loadGlyph(Uint32       codePoint,
+                      unsigned int characterSize,
+                      bool         bold,
+                      float        outlineThickness,
+                      bool         distanceField) const
+{
     // Stop if no font is loaded
     if (!m_fontHandles)
-        return glyph;
+        return Glyph();
+
+    RasterizedGlyph rasterized;
+    rasterized.codePoint        = codePoint;
+    rasterized.characterSize    = characterSize;
+    rasterized.bold             = bold;
+    rasterized.outlineThickness = outlineThickness;
+    rasterized.distanceField    = distanceField;
+
+    // Reuse the pixel buffer of the previous glyph
+    rasterized.pixels.swap(m_pixelBuffer);
+    rasterizeGlyph(*m_fontHandles, rasterized);
+
+    ++m_rasterizedGlyphCount;
+    m_rasterizationTime += rasterized.time;
+
+    if ((rasterized.size.x > 0) && (rasterized.size.y > 0))
+    {
+        // Find a good position for the new glyph into the textures, and write its pixels there
+        Page&         page = loadPage(characterSize, distanceField);
+        const IntRect rect = placeGlyph(page, rasterized);
+        page.textures[rasterized.glyph.page].update(rasterized.pixels.data(),
+                                                    Vector2u(rect.getSize()),
+                                                    Vector2u(rect.getPosition()));
+    }
+
+    m_pixelBuffer.swap(rasterized.pixels);
+
+    return rasterized.glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph* Font::requestGlyph(Page&        page,
+                                Uint64       key,
+                                Uint32       codePoint,
+                                unsigned int characterSize,
+                                bool         bold,
+                                float        outlineThickness,
+                                bool         distanceField) const
+{
+    // Already requested: return the same placeholder
+    if (auto it = page.placeholders.find(key); it != page.placeholders.end())
+        return &it->second;
+
+    if (!m_glyphLoader)
+        m_glyphLoader = std::make_unique<GlyphLoader>(m_fontHandles);
+
+    RasterizedGlyph request;
+    request.key              = key;
+    request.codePoint        = codePoint;
+    request.characterSize    = characterSize;
+    request.bold             = bold;
+    request.outlineThickness = outlineThickness;
+    request.distanceField    = distanceField;
+
+    if (!m_glyphLoader->push(std::move(request)))
+        return nullptr;
+
+    // The placeholder has no pixels, but it has the advance of the glyph so that the layout of the texts
+    // doesn't change when it is replaced; reading it without hinting is much faster than loading the glyph,
+    // but the result may be off by a pixel
+    Glyph placeholder;
+
+    {
+        std::lock_guard lock(m_fontHandles->mutex);
+        auto            face = m_fontHandles->face.get();
+
+        FT_Fixed advance = 0;
+        if (face && setCurrentSize(*m_fontHandles, characterSize) &&
+            (FT_Get_Advance(face, FT_Get_Char_Index(face, codePoint), FT_LOAD_NO_HINTING, &advance) == 0))
+            placeholder.advance = static_cast<float>(advance >> 16);
+    }
+
+    // Bold glyphs are one pixel wider, see rasterizeGlyph
+    if (bold)
+        placeholder.advance += 1.f;
+
+    return &page.placeholders.emplace(key, placeholder).first->second;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::processLoadedGlyphs() const
+{
+    std::vector<RasterizedGlyph> glyphs;
+    if (m_glyphLoader && m_glyphLoader->takeResults(glyphs))
+        insertGlyphs(glyphs);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::insertGlyphs(std::vector<RasterizedGlyph>& glyphs) const
+{
+    // Place all the glyphs first, then write their pixels with a single update per texture
+    std::map<Texture*, std::vector<Texture::Area>> areas;
+
+    for (RasterizedGlyph& rasterized : glyphs)
+    {
+        ++m_rasterizedGlyphCount;
+        m_rasterizationTime += rasterized.time;
+
+        // The distance field glyphs are dropped if distance field rendering was disabled in the meantime
+        if (rasterized.distanceField && !m_isDistanceFieldEnabled)
+            continue;
+
+        Page& page = loadPage(rasterized.characterSize, rasterized.distanceField);
+
+        // The glyph may have been loaded when it was requested, while asynchronous loading was disabled
+        if (page.glyphs.count(rasterized.key) > 0)
+            continue;
+
+        if ((rasterized.size.x > 0) && (rasterized.size.y > 0))
+        {
+            const IntRect rect = placeGlyph(page, rasterized);
+            areas[&page.textures[rasterized.glyph.page]].push_back(
+                {rasterized.pixels.data(), Vector2u(rect.getSize()), Vector2u(rect.getPosition())});
+        }
+
+        // Texts only rebuild their geometry, and replace the placeholders they use, when
+        // the first texture of their character size changes: make sure that it does
+        if (page.placeholders.count(rasterized.key) > 0)
+        {
+            std::vector<Texture::Area>& firstAreas = areas[&page.textures.front()];
+            if (firstAreas.empty())
+                firstAreas.push_back({whiteSquare, {2, 2}, {0, 0}});
+
+            // The real glyph is found first from now on, the placeholder is not needed anymore
+            page.placeholders.erase(rasterized.key);
+        }
+
+        page.glyphs.emplace(rasterized.key, rasterized.glyph);
+    }
+
+    for (auto& [texture, textureAreas] : areas)
+        texture->update(textureAreas);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::rasterizeGlyph(FontHandles& fontHandles, RasterizedGlyph& rasterized)
+{
+    const Clock clock;
+
+    const Uint32        codePoint        = rasterized.codePoint;
+    const bool          bold             = rasterized.bold;
+    const float         outlineThickness = rasterized.outlineThickness;
+    Glyph&              glyph            = rasterized.glyph;
+    std::vector<Uint8>& pixelBuffer      = rasterized.pixels;
+
+    // The FreeType objects are shared with the other loading threads
+    std::lock_guard lock(fontHandles.mutex);
 
     // Get our FT_Face
-    auto face = m_fontHandles->face.get();
+    auto face = fontHandles.face.get();
     if (!face)
-        return glyph;
+        return;
 
     // Set the character size
-    if (!setCurrentSize(characterSize))
-        return glyph;
+    if (!setCurrentSize(fontHandles, rasterized.characterSize))
+        return;
 
     // Load the glyph corresponding to the code point
     FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
     if (outlineThickness != 0)
         flags |= FT_LOAD_NO_BITMAP;
     if (FT_Load_Char(face, codePoint, flags) != 0)
-        return glyph;
+        return;
 
     // Retrieve the glyph
     FT_Glyph glyphDesc;
     if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
-        return glyph;
+        return;
 
     // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
     FT_Pos weight  = 1 << 6;
@@ -591,7 +1194,7 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
 
         if (outlineThickness != 0)
         {
-            auto stroker = m_fontHandles->stroker.get();
+            auto stroker = fontHandles.stroker.get();
 
             FT_Stroker_Set(stroker,
                            static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)),
@@ -613,7 +1216,7 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
     if (!outline)
     {
         if (bold)
-            FT_Bitmap_Embolden(m_fontHandles->library.get(), &bitmap, weight, weight);
+            FT_Bitmap_Embolden(fontHandles.library.get(), &bitmap, weight, weight);
 
         if (outlineThickness != 0)
             err() << "Failed to outline glyph (no fallback available)" << std::endl;
@@ -633,24 +1236,14 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
     if ((width > 0) && (height > 0))
     {
         // Leave a small padding around characters, so that filtering doesn't
-        // pollute them with pixels from neighbors
-        const unsigned int padding = 2;
+        // pollute them with pixels from neighbors; distance fields also
+        // extend over the padding, so that outlines can be drawn there
+        const unsigned int padding = rasterized.distanceField ? distanceFieldSpread + 1 : glyphPadding;
+        rasterized.padding         = padding;
 
         width += 2 * padding;
         height += 2 * padding;
-
-        // Get the glyphs page corresponding to the character size
-        Page& page = loadPage(characterSize);
-
-        // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, {width, height});
-
-        // Make sure the texture data is positioned in the center
-        // of the allocated texture rectangle
-        glyph.textureRect.left += static_cast<int>(padding);
-        glyph.textureRect.top += static_cast<int>(padding);
-        glyph.textureRect.width -= static_cast<int>(2 * padding);
-        glyph.textureRect.height -= static_cast<int>(2 * padding);
+        rasterized.size = Vector2u(width, height);
 
         // Compute the glyph's bounding box
         glyph.bounds.left   = static_cast<float>(bitmapGlyph->left);
@@ -659,9 +1252,9 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
         glyph.bounds.height = static_cast<float>(bitmap.rows);
 
         // Resize the pixel buffer to the new size and fill it with transparent white pixels
-        m_pixelBuffer.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4);
+        pixelBuffer.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4);
 
-        Uint8* current = m_pixelBuffer.data();
+        Uint8* current = pixelBuffer.data();
         Uint8* end     = current + width * height * 4;
 
         while (current != end)
@@ -682,8 +1275,8 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
                 for (unsigned int x = padding; x < width - padding; ++x)
                 {
                     // The color channels remain white, just fill the alpha channel
-                    std::size_t index            = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
+                    std::size_t index          = x + y * width;
+                    pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
                 }
                 pixels += bitmap.pitch;
             }
@@ -696,111 +1289,108 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
                 for (unsigned int x = padding; x < width - padding; ++x)
                 {
                     // The color channels remain white, just fill the alpha channel
-                    std::size_t index            = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = pixels[x - padding];
+                    std::size_t index          = x + y * width;
+                    pixelBuffer[index * 4 + 3] = pixels[x - padding];
                 }
                 pixels += bitmap.pitch;
             }
         }
 
-        // Write the pixels to the texture
-        unsigned int x = static_cast<unsigned int>(glyph.textureRect.left) - padding;
-        unsigned int y = static_cast<unsigned int>(glyph.textureRect.top) - padding;
-        unsigned int w = static_cast<unsigned int>(glyph.textureRect.width) + 2 * padding;
-        unsigned int h = static_cast<unsigned int>(glyph.textureRect.height) + 2 * padding;
-        page.texture.update(m_pixelBuffer.data(), {w, h}, {x, y});
+        // Replace the coverage of the pixels by its distance to the edges of the glyph
+        if (rasterized.distanceField)
+            priv::computeDistanceField(pixelBuffer.data(), rasterized.size, static_cast<float>(distanceFieldSpread));
     }
 
     // Delete the FT glyph
     FT_Done_Glyph(glyphDesc);
 
-    // Done :)
-    return glyph;
+    rasterized.time = clock.getElapsedTime();
 }
 
 
 ////////////////////////////////////////////////////////////
-IntRect Font::findGlyphRect(Page& page, const Vector2u& size) const
+IntRect Font::findGlyphRect(Page& page, const Vector2u& size, unsigned int& textureIndex) const
 {
-    // Find the line that fits well the glyph
-    Row*  row       = nullptr;
-    float bestRatio = 0;
-    for (auto it = page.rows.begin(); it != page.rows.end() && !row; ++it)
+    // Look for room in the existing textures, the first ones are the most likely to be filled already
+    for (std::size_t i = 0; i < page.packers.size(); ++i)
     {
-        float ratio = static_cast<float>(size.y) / static_cast<float>(it->height);
-
-        // Ignore rows that are either too small or too high
-        if ((ratio < 0.7f) || (ratio > 1.f))
-            continue;
-
-        // Check if there's enough horizontal space left in the row
-        if (size.x > page.texture.getSize().x - it->width)
-            continue;
-
-        // Make sure that this new row is the best found so far
-        if (ratio < bestRatio)
-            continue;
-
-        // The current row passed all the tests: we can select it
-        row       = &*it;
-        bestRatio = ratio;
+        if (const std::optional<Vector2u> position = page.packers[i].insert(size))
+        {
+            textureIndex = static_cast<unsigned int>(i);
+            return IntRect(Vector2i(*position), Vector2i(size));
+        }
     }
 
-    // If we didn't find a matching row, create a new one (10% taller than the glyph)
-    if (!row)
+    // Not enough space: rather than resizing a texture, which would copy all of its glyphs,
+    // add a new one twice as large as the previous one (up to 2048), or large enough for the glyph
+    const unsigned int maximumSize = Texture::getMaximumSize();
+    if ((size.x > maximumSize) || (size.y > maximumSize))
     {
-        unsigned int rowHeight = size.y + size.y / 10;
-        while ((page.nextRow + rowHeight >= page.texture.getSize().y) || (size.x >= page.texture.getSize().x))
-        {
-            // Not enough space: resize the texture if possible
-            Vector2u textureSize = page.texture.getSize();
-            if ((textureSize.x * 2 <= Texture::getMaximumSize()) && (textureSize.y * 2 <= Texture::getMaximumSize()))
-            {
-                // Make the texture 2 times bigger
-                Texture newTexture;
-                if (!newTexture.create(textureSize * 2u))
-                {
-                    err() << "Failed to create new page texture" << std::endl;
-                    return IntRect({0, 0}, {2, 2});
-                }
+        // Oops, the glyph is larger than the maximum texture size...
+        err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
+        textureIndex = 0;
+        return IntRect({0, 0}, {2, 2});
+    }
 
-                newTexture.setSmooth(m_isSmooth);
-                newTexture.update(page.texture);
-                page.texture.swap(newTexture);
-            }
-            else
-            {
-                // Oops, we've reached the maximum texture size...
-                err() << "Failed to add a new character to the font: the maximum texture size has been reached"
-                      << std::endl;
-                return IntRect({0, 0}, {2, 2});
-            }
-        }
+    unsigned int newSize = page.textures.empty() ? 128 : page.textures.back().getSize().x * 2;
+    newSize              = std::clamp(newSize, std::min(128u, maximumSize), std::min(2048u, maximumSize));
+    while ((newSize < size.x) || (newSize < size.y))
+        newSize = std::min(newSize * 2, maximumSize);
 
-        // We can now create the new row
-        page.rows.emplace_back(page.nextRow, rowHeight);
-        page.nextRow += rowHeight;
-        row = &page.rows.back();
+    // The new texture is filtered like the first one, which is always smooth for distance fields
+    if (!page.addTexture(newSize, page.textures.front().isSmooth()))
+    {
+        err() << "Failed to create new page texture" << std::endl;
+        textureIndex = 0;
+        return IntRect({0, 0}, {2, 2});
     }
 
-    // Find the glyph's rectangle on the selected row
-    IntRect rect(Rect<unsigned int>({row->width, row->top}, size));
+    const std::optional<Vector2u> position = page.packers.back().insert(size);
+    assert(position);
+
+    textureIndex = static_cast<unsigned int>(page.packers.size() - 1);
+    return IntRect(Vector2i(*position), Vector2i(size));
+}
+
 
-    // Update the row informations
-    row->width += size.x;
+////////////////////////////////////////////////////////////
+IntRect Font::placeGlyph(Page& page, RasterizedGlyph& glyph) const
+{
+    // Find a good position for the new glyph into the textures
+    const IntRect rect = findGlyphRect(page, glyph.size, glyph.glyph.page);
+
+    // Make sure the texture data is positioned in the center
+    // of the allocated texture rectangle
+    const auto padding      = static_cast<int>(glyph.padding);
+    glyph.glyph.textureRect = rect;
+    glyph.glyph.textureRect.left += padding;
+    glyph.glyph.textureRect.top += padding;
+    glyph.glyph.textureRect.width -= 2 * padding;
+    glyph.glyph.textureRect.height -= 2 * padding;
 
     return rect;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Font::setCurrentSize(unsigned int characterSize) const
+unsigned int Font::getCharIndex(Uint32 codePoint) const
+{
+    if (!m_fontHandles)
+        return 0;
+
+    std::lock_guard lock(m_fontHandles->mutex);
+    return FT_Get_Char_Index(m_fontHandles->face.get(), codePoint);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::setCurrentSize(FontHandles& fontHandles, unsigned int characterSize)
 {
     // FT_Set_Pixel_Sizes is an expensive function, so we must call it
     // only when necessary to avoid killing performances
 
-    // m_fontHandles and m_fontHandles->face are checked to be non-null before calling this method
-    auto      face        = m_fontHandles->face.get();
+    // fontHandles.face is checked to be non-null before calling this method
+    auto      face        = fontHandles.face.get();
     FT_UShort currentSize = face->size->metrics.x_ppem;
 
     if (currentSize != characterSize)
@@ -836,24 +1426,44 @@ bool Font::setCurrentSize(unsigned int characterSize) const
 
 
 ////////////////////////////////////////////////////////////
-Font::Page::Page(bool smooth) : nextRow(3)
+Font::Page::Page(bool smooth)
 {
-    // Make sure that the texture is initialized by default
-    sf::Image image;
-    image.create({128, 128}, Color(255, 255, 255, 0));
+    if (!addTexture(128, smooth))
+    {
+        err() << "Failed to load font page texture" << std::endl;
+
+        // Keep an empty texture, which has no room for glyphs
+        textures.emplace_back();
+        packers.emplace_back();
+        return;
+    }
+
+    // Reserve a 2x2 white square for texturing underlines, in the top-left corner of the first texture
+    [[maybe_unused]] const std::optional<Vector2u> underlinePosition = packers.front().insert({3, 3});
+    assert(underlinePosition == Vector2u(0, 0));
 
-    // Reserve a 2x2 white square for texturing underlines
-    for (unsigned int x = 0; x < 2; ++x)
-        for (unsigned int y = 0; y < 2; ++y)
-            image.setPixel({x, y}, Color(255, 255, 255, 255));
+    textures.front().update(whiteSquare, {2, 2}, {0, 0});
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::Page::addTexture(unsigned int size, bool smooth)
+{
+    // Make sure that the texture is initialized by default
+    Image image;
+    image.create({size, size}, Color(255, 255, 255, 0));
 
-    // Create the texture
+    Texture& texture = textures.emplace_back();
     if (!texture.loadFromImage(image))
     {
-        err() << "Failed to load font page texture" << std::endl;
+        textures.pop_back();
+        return false;
     }
 
     texture.setSmooth(smooth);
+    packers.emplace_back(Vector2u(size, size));
+
+    return true;
 }
 
 } // namespace sf
@@ -59,6 +59,7 @@
 #define GLEXT_GL_DYNAMIC_DRAW      GL_DYNAMIC_DRAW
 #define GLEXT_GL_STATIC_DRAW       GL_STATIC_DRAW
 #define GLEXT_GL_STREAM_DRAW       GL_DYNAMIC_DRAW
+#define GLEXT_GL_STREAM_READ       GL_DYNAMIC_DRAW
 #define GLEXT_glBindBuffer         glBindBuffer
 #define GLEXT_glBufferData         glBufferData
 #define GLEXT_glBufferSubData      glBufferSubData
@@ -148,6 +149,84 @@
 #define GLEXT_GL_MIN       GL_MIN_EXT
 #define GLEXT_GL_MAX       GL_MAX_EXT
 
+// Core since 3.0 - EXT_map_buffer_range
+#define GLEXT_map_buffer_range false
+#define GLEXT_glMapBufferRange \
+    glMapBufferRange // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+#define GLEXT_glUnmapBuffer \
+    glUnmapBuffer // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+#define GLEXT_GL_MAP_READ_BIT               0
+#define GLEXT_GL_MAP_WRITE_BIT              0
+#define GLEXT_GL_MAP_INVALIDATE_RANGE_BIT   0
+#define GLEXT_GL_MAP_INVALIDATE_BUFFER_BIT  0
+#define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT     0
+
+// Core since 3.0 - APPLE_sync
+#define GLEXT_sync false
+#define GLEXT_glFenceSync \
+    glFenceSync // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+#define GLEXT_glClientWaitSync \
+    glClientWaitSync // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+#define GLEXT_glDeleteSync \
+    glDeleteSync // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+#define GLEXT_GLsync                        GLsync
+#define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE 0
+#define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT    0
+#define GLEXT_GL_TIMEOUT_EXPIRED            0
+#define GLEXT_GL_ALREADY_SIGNALED           0
+#define GLEXT_GL_CONDITION_SATISFIED        0
+
+// Core since 3.0 - EXT_disjoint_timer_query
+#define GLEXT_timer_query false
+#define GLEXT_glGenQueries \
+    glGenQueries // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+#define GLEXT_glDeleteQueries \
+    glDeleteQueries // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+#define GLEXT_glQueryCounter \
+    glQueryCounter // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+#define GLEXT_glGetQueryObjectiv \
+    glGetQueryObjectiv // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+#define GLEXT_glGetQueryObjectui64v \
+    glGetQueryObjectui64v // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+#define GLEXT_GL_TIMESTAMP              0
+#define GLEXT_GL_QUERY_RESULT           0
+#define GLEXT_GL_QUERY_RESULT_AVAILABLE 0
+
+// Core since 3.2 - EXT_buffer_storage
+#define GLEXT_buffer_storage false
+#define GLEXT_glBufferStorage \
+    glBufferStorage // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+#define GLEXT_GL_MAP_PERSISTENT_BIT 0
+#define GLEXT_GL_MAP_COHERENT_BIT   0
+
+// Core since 1.0 - packed pixel types, the internal format must match the pixel format
+#define GLEXT_packed_pixels             true
+#define GLEXT_GL_RGB565                 GL_RGB
+#define GLEXT_GL_RGBA4                  GL_RGBA
+#define GLEXT_GL_UNSIGNED_SHORT_5_6_5   GL_UNSIGNED_SHORT_5_6_5
+#define GLEXT_GL_UNSIGNED_SHORT_4_4_4_4 GL_UNSIGNED_SHORT_4_4_4_4
+
+// Core since 3.0 - EXT_texture_rg
+#define GLEXT_texture_rg false
+#define GLEXT_GL_RED     0
+#define GLEXT_GL_RG      0
+#define GLEXT_GL_R8      0
+#define GLEXT_GL_RG8     0
+
+// Core since 3.0 - OES_texture_half_float
+#define GLEXT_texture_half_float false
+#define GLEXT_GL_RGBA16F         0
+#define GLEXT_GL_HALF_FLOAT      0
+
+// Core since 1.0 - compressed texture images
+#define GLEXT_texture_compression    true
+#define GLEXT_glCompressedTexImage2D glCompressedTexImage2D
+
+// Core since 3.0 - NV_pixel_buffer_object
+#define GLEXT_pixel_buffer_object    false
+#define GLEXT_GL_PIXEL_PACK_BUFFER   0
+#define GLEXT_GL_PIXEL_UNPACK_BUFFER 0
+
 #else
 
 // SFML requires at a bare minimum OpenGL 1.1 capability
@@ -197,6 +276,7 @@
 #define GLEXT_GL_READ_ONLY                        GL_READ_ONLY_ARB
 #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW_ARB
 #define GLEXT_GL_STREAM_DRAW                      GL_STREAM_DRAW_ARB
+#define GLEXT_GL_STREAM_READ                      GL_STREAM_READ_ARB
 #define GLEXT_GL_WRITE_ONLY                       GL_WRITE_ONLY_ARB
 #define GLEXT_glBindBuffer                        glBindBufferARB
 #define GLEXT_glBufferData                        glBufferDataARB
@@ -302,6 +382,15 @@
 #define GLEXT_glRenderbufferStorageMultisample    glRenderbufferStorageMultisampleEXT
 #define GLEXT_GL_MAX_SAMPLES                      GL_MAX_SAMPLES_EXT
 
+// Core since 3.0 - ARB_map_buffer_range
+#define GLEXT_map_buffer_range                    SF_GLAD_GL_ARB_map_buffer_range
+#define GLEXT_glMapBufferRange                    glMapBufferRange
+#define GLEXT_GL_MAP_READ_BIT                     GL_MAP_READ_BIT
+#define GLEXT_GL_MAP_WRITE_BIT                    GL_MAP_WRITE_BIT
+#define GLEXT_GL_MAP_INVALIDATE_RANGE_BIT         GL_MAP_INVALIDATE_RANGE_BIT
+#define GLEXT_GL_MAP_INVALIDATE_BUFFER_BIT        GL_MAP_INVALIDATE_BUFFER_BIT
+#define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT           GL_MAP_UNSYNCHRONIZED_BIT
+
 // Core since 3.1 - ARB_copy_buffer
 #define GLEXT_copy_buffer                         SF_GLAD_GL_ARB_copy_buffer
 #define GLEXT_GL_COPY_READ_BUFFER                 GL_COPY_READ_BUFFER
@@ -312,8 +401,95 @@
 #define GLEXT_geometry_shader4                    SF_GLAD_GL_ARB_geometry_shader4
 #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
 
+// Core since 3.2 - ARB_sync
+#define GLEXT_sync                                SF_GLAD_GL_ARB_sync
+#define GLEXT_glFenceSync                         glFenceSync
+#define GLEXT_glClientWaitSync                    glClientWaitSync
+#define GLEXT_glDeleteSync                        glDeleteSync
+#define GLEXT_GLsync                              GLsync
+#define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          GL_SYNC_FLUSH_COMMANDS_BIT
+#define GLEXT_GL_TIMEOUT_EXPIRED                  GL_TIMEOUT_EXPIRED
+#define GLEXT_GL_ALREADY_SIGNALED                 GL_ALREADY_SIGNALED
+#define GLEXT_GL_CONDITION_SATISFIED              GL_CONDITION_SATISFIED
+
+// Core since 3.3 - ARB_timer_query
+#define GLEXT_timer_query                         SF_GLAD_GL_ARB_timer_query
+#define GLEXT_glGenQueries                        glGenQueries
+#define GLEXT_glDeleteQueries                     glDeleteQueries
+#define GLEXT_glQueryCounter                      glQueryCounter
+#define GLEXT_glGetQueryObjectiv                  glGetQueryObjectiv
+#define GLEXT_glGetQueryObjectui64v               glGetQueryObjectui64v
+#define GLEXT_GL_TIMESTAMP                        GL_TIMESTAMP
+#define GLEXT_GL_QUERY_RESULT                     GL_QUERY_RESULT
+#define GLEXT_GL_QUERY_RESULT_AVAILABLE           GL_QUERY_RESULT_AVAILABLE
+
+// Core since 4.4 - ARB_buffer_storage
+#define GLEXT_buffer_storage                      SF_GLAD_GL_ARB_buffer_storage
+#define GLEXT_glBufferStorage                     glBufferStorage
+#define GLEXT_GL_MAP_PERSISTENT_BIT               GL_MAP_PERSISTENT_BIT
+#define GLEXT_GL_MAP_COHERENT_BIT                 GL_MAP_COHERENT_BIT
+
+// Core since 1.2 - packed pixel types
+#define GLEXT_packed_pixels                       SF_GLAD_GL_VERSION_1_2
+#define GLEXT_GL_RGB565                           GL_RGB5
+#define GLEXT_GL_RGBA4                            GL_RGBA4
+#define GLEXT_GL_UNSIGNED_SHORT_5_6_5             GL_UNSIGNED_SHORT_5_6_5
+#define GLEXT_GL_UNSIGNED_SHORT_4_4_4_4           GL_UNSIGNED_SHORT_4_4_4_4
+
+// Core since 3.0 - ARB_texture_rg
+#define GLEXT_texture_rg                          SF_GLAD_GL_VERSION_3_0
+#define GLEXT_GL_RED                              GL_RED
+#define GLEXT_GL_RG                               GL_RG
+#define GLEXT_GL_R8                               GL_R8
+#define GLEXT_GL_RG8                              GL_RG8
+
+// Core since 3.0 - ARB_texture_float, ARB_half_float_pixel
+#define GLEXT_texture_half_float                  SF_GLAD_GL_VERSION_3_0
+#define GLEXT_GL_RGBA16F                          GL_RGBA16F
+#define GLEXT_GL_HALF_FLOAT                       GL_HALF_FLOAT
+
+// Core since 1.3 - ARB_texture_compression
+#define GLEXT_texture_compression                 SF_GLAD_GL_VERSION_1_3
+#define GLEXT_glCompressedTexImage2D              glCompressedTexImage2D
+
+// Core since 2.1 - ARB_pixel_buffer_object
+#define GLEXT_pixel_buffer_object                 SF_GLAD_GL_VERSION_2_1
+#define GLEXT_GL_PIXEL_PACK_BUFFER                GL_PIXEL_PACK_BUFFER
+#define GLEXT_GL_PIXEL_UNPACK_BUFFER              GL_PIXEL_UNPACK_BUFFER
+
 #endif
 
+// Block compressed texture formats, their availability is checked through the extension strings
+// EXT_texture_compression_s3tc / EXT_texture_sRGB / EXT_texture_compression_s3tc_srgb
+#define GLEXT_GL_COMPRESSED_RGB_S3TC_DXT1                  0x83F0
+#define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1                 0x83F1
+#define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3                 0x83F2
+#define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5                 0x83F3
+#define GLEXT_GL_COMPRESSED_SRGB_S3TC_DXT1                 0x8C4C
+#define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1           0x8C4D
+#define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3           0x8C4E
+#define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5           0x8C4F
+
+// Core since 3.0 - ARB_texture_compression_rgtc / EXT_texture_compression_rgtc
+#define GLEXT_GL_COMPRESSED_RED_RGTC1                      0x8DBB
+#define GLEXT_GL_COMPRESSED_RG_RGTC2                       0x8DBD
+
+// Core since 4.2 - ARB_texture_compression_bptc / EXT_texture_compression_bptc
+#define GLEXT_GL_COMPRESSED_RGBA_BPTC_UNORM                0x8E8C
+#define GLEXT_GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM          0x8E8D
+
+// OES_compressed_ETC1_RGB8_texture
+#define GLEXT_GL_ETC1_RGB8                                 0x8D64
+
+// Core since 4.3 - ARB_ES3_compatibility
+#define GLEXT_GL_COMPRESSED_RGB8_ETC2                      0x9274
+#define GLEXT_GL_COMPRESSED_SRGB8_ETC2                     0x9275
+#define GLEXT_GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2  0x9276
+#define GLEXT_GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9277
+#define GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC                 0x9278
+#define GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC          0x9279
+
 // OpenGL Versions
 #define GLEXT_GL_VERSION_1_0 SF_GLAD_GL_VERSION_1_0
 #define GLEXT_GL_VERSION_1_1 SF_GLAD_GL_VERSION_1_1
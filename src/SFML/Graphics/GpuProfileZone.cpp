@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GpuProfileZone.hpp>
+#include <SFML/Graphics/GpuProfiler.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GpuProfileZone::Result::Result() : name(), depth(0), cpuTime(), gpuTime(), hasGpuTime(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GpuProfileZone::GpuProfileZone(RenderTarget& target, const std::string& name) :
+m_target(target),
+m_zone(target.beginProfileZone(name))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GpuProfileZone::~GpuProfileZone()
+{
+    m_target.endProfileZone(m_zone);
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<GpuProfileZone::Result>& GpuProfileZone::getResults(const RenderTarget& target)
+{
+    return target.getProfileResults();
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuProfileZone::isGpuTimingAvailable()
+{
+    return priv::GpuProfiler::isAvailable();
+}
+
+} // namespace sf
@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GpuProfiler.hpp>
+#include <SFML/Window/Context.hpp>
+
+#include <mutex>
+
+
+namespace
+{
+// A nested named namespace is used here to allow unity builds of SFML.
+namespace GpuProfilerImpl
+{
+std::recursive_mutex isAvailableMutex;
+
+// Number of frames after which pending queries are given up on,
+// in case the GPU lags that far behind or the driver never reports them
+constexpr std::size_t maxPendingFrames = 8;
+} // namespace GpuProfilerImpl
+} // namespace
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+GpuProfiler::GpuProfiler() :
+m_contextId(Context::getActiveContextId()),
+m_gpuTiming(isAvailable()),
+m_firstZone(0),
+m_depth(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GpuProfiler::~GpuProfiler()
+{
+    // Query objects are not shared between contexts, they can only be
+    // deleted from the context they were created in; otherwise they
+    // are destroyed along with that context
+    if (!m_queries.empty() && (Context::getActiveContextId() == m_contextId))
+        glCheck(GLEXT_glDeleteQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data()));
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuProfiler::isAvailable()
+{
+    std::scoped_lock lock(GpuProfilerImpl::isAvailableMutex);
+
+    static bool checked   = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = GLEXT_timer_query;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t GpuProfiler::beginZone(const std::string& name)
+{
+    Zone zone;
+    zone.result.name  = name;
+    zone.result.depth = m_depth;
+    zone.cpuStart     = m_clock.getElapsedTime();
+    zone.beginQuery   = issueTimestamp();
+    zone.endQuery     = 0;
+    zone.open         = true;
+
+    m_zones.push_back(zone);
+    ++m_depth;
+
+    return m_firstZone + m_zones.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::endZone(std::size_t zone)
+{
+    // Ignore zones of a previous frame, they have been discarded already
+    if ((zone < m_firstZone) || (zone - m_firstZone >= m_zones.size()))
+        return;
+
+    Zone& current = m_zones[zone - m_firstZone];
+    if (!current.open)
+        return;
+
+    current.endQuery       = current.beginQuery ? issueTimestamp() : 0;
+    current.result.cpuTime = m_clock.getElapsedTime() - current.cpuStart;
+    current.open           = false;
+    --m_depth;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::endFrame()
+{
+    // Zones spanning several frames cannot be measured, discard them
+    std::vector<Zone> zones;
+    std::vector<Zone> discarded;
+    for (const Zone& zone : m_zones)
+        (zone.open ? discarded : zones).push_back(zone);
+
+    releaseQueries(discarded);
+
+    m_firstZone += m_zones.size();
+    m_zones.clear();
+    m_depth = 0;
+
+    if (!zones.empty())
+        m_pendingFrames.push_back(zones);
+
+    // Resolve the frames that the GPU has completed, in order
+    while (!m_pendingFrames.empty() && isFrameAvailable(m_pendingFrames.front()))
+    {
+        resolveFrame(m_pendingFrames.front());
+        releaseQueries(m_pendingFrames.front());
+        m_pendingFrames.pop_front();
+    }
+
+    // Don't let pending frames accumulate forever
+    while (m_pendingFrames.size() > GpuProfilerImpl::maxPendingFrames)
+    {
+        releaseQueries(m_pendingFrames.front());
+        m_pendingFrames.pop_front();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<GpuProfileZone::Result>& GpuProfiler::getResults() const
+{
+    return m_results;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int GpuProfiler::issueTimestamp()
+{
+    // Queries can't be used in another context than the one that created them
+    if (!m_gpuTiming || (Context::getActiveContextId() != m_contextId))
+        return 0;
+
+    GLuint query = 0;
+
+    if (m_freeQueries.empty())
+    {
+        glCheck(GLEXT_glGenQueries(1, &query));
+        m_queries.push_back(query);
+    }
+    else
+    {
+        query = m_freeQueries.back();
+        m_freeQueries.pop_back();
+    }
+
+    glCheck(GLEXT_glQueryCounter(query, GLEXT_GL_TIMESTAMP));
+
+    return query;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuProfiler::isFrameAvailable(const std::vector<Zone>& zones) const
+{
+    if (Context::getActiveContextId() != m_contextId)
+        return false;
+
+    // Checking availability never blocks, unlike reading the results
+    for (const Zone& zone : zones)
+    {
+        if (zone.endQuery)
+        {
+            GLint available = GL_FALSE;
+            glCheck(GLEXT_glGetQueryObjectiv(zone.endQuery, GLEXT_GL_QUERY_RESULT_AVAILABLE, &available));
+
+            if (available != GL_TRUE)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::resolveFrame(const std::vector<Zone>& zones)
+{
+    m_results.clear();
+
+    for (const Zone& zone : zones)
+    {
+        GpuProfileZone::Result result = zone.result;
+
+        if (zone.beginQuery && zone.endQuery)
+        {
+            GLuint64 begin = 0;
+            GLuint64 end   = 0;
+            glCheck(GLEXT_glGetQueryObjectui64v(zone.beginQuery, GLEXT_GL_QUERY_RESULT, &begin));
+            glCheck(GLEXT_glGetQueryObjectui64v(zone.endQuery, GLEXT_GL_QUERY_RESULT, &end));
+
+            // Timestamps are in nanoseconds
+            result.gpuTime    = microseconds(static_cast<Int64>((end - begin) / 1000));
+            result.hasGpuTime = true;
+        }
+
+        m_results.push_back(result);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuProfiler::releaseQueries(const std::vector<Zone>& zones)
+{
+    for (const Zone& zone : zones)
+    {
+        if (zone.beginQuery)
+            m_freeQueries.push_back(zone.beginQuery);
+
+        if (zone.endQuery)
+            m_freeQueries.push_back(zone.endQuery);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
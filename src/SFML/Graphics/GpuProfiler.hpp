@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GPUPROFILER_HPP
+#define SFML_GPUPROFILER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GpuProfileZone.hpp>
+
+#include <SFML/Window/GlResource.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Collects and resolves the profile zones of a render target
+///
+/// All the functions must be called with the context of the
+/// render target active.
+///
+////////////////////////////////////////////////////////////
+class GpuProfiler : GlResource
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    GpuProfiler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GpuProfiler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    GpuProfiler(const GpuProfiler&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether timer queries are available on the system
+    ///
+    /// \return True if timer queries are supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Begin a new zone in the current frame
+    ///
+    /// \param name Name of the zone
+    ///
+    /// \return Identifier of the zone, to pass to endZone
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t beginZone(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End a zone
+    ///
+    /// Zones that don't belong to the current frame are ignored.
+    ///
+    /// \param zone Identifier of the zone returned by beginZone
+    ///
+    ////////////////////////////////////////////////////////////
+    void endZone(std::size_t zone);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End the current frame and resolve the frames whose queries are available
+    ///
+    ////////////////////////////////////////////////////////////
+    void endFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timings of the latest resolved frame
+    ///
+    /// \return Timings of the zones of the frame
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<GpuProfileZone::Result>& getResults() const;
+
+private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Zone recorded during a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Zone
+    {
+        GpuProfileZone::Result result;     //!< Timings of the zone, filled once resolved
+        Time                   cpuStart;   //!< CPU time at the beginning of the zone
+        unsigned int           beginQuery; //!< Timestamp query issued at the beginning of the zone, 0 if none
+        unsigned int           endQuery;   //!< Timestamp query issued at the end of the zone, 0 if none
+        bool                   open;       //!< Is the zone still open?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Issue a timestamp query
+    ///
+    /// \return Query that was issued, 0 if GPU timing is not possible
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int issueTimestamp();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the results of all the queries of a frame are available
+    ///
+    /// \param zones Zones of the frame
+    ///
+    /// \return True if the frame can be resolved without waiting
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isFrameAvailable(const std::vector<Zone>& zones) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the results of a frame and make them the latest results
+    ///
+    /// \param zones Zones of the frame
+    ///
+    ////////////////////////////////////////////////////////////
+    void resolveFrame(const std::vector<Zone>& zones);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the queries of a frame to the pool
+    ///
+    /// \param zones Zones of the frame
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseQueries(const std::vector<Zone>& zones);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint64                              m_contextId;     //!< Context the queries were created in
+    bool                                m_gpuTiming;     //!< Are timer queries available?
+    Clock                               m_clock;         //!< Clock used for CPU timings
+    std::vector<Zone>                   m_zones;         //!< Zones of the current frame
+    std::size_t                         m_firstZone;     //!< Identifier of the first zone of the current frame
+    unsigned int                        m_depth;         //!< Number of zones currently open
+    std::deque<std::vector<Zone>>       m_pendingFrames; //!< Completed frames waiting for their queries, oldest first
+    std::vector<unsigned int>           m_queries;       //!< All the queries created by the profiler
+    std::vector<unsigned int>           m_freeQueries;   //!< Queries available for reuse
+    std::vector<GpuProfileZone::Result> m_results;       //!< Timings of the latest resolved frame
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GPUPROFILER_HPP
@@ -26,14 +26,208 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ParallelFor.hpp>
 #include <SFML/System/Err.hpp>
 #ifdef SFML_SYSTEM_ANDROID
 #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <ostream>
+#include <utility>
+
+
+namespace
+{
+// A nested named namespace is used here to allow unity builds of SFML.
+namespace ImageImpl
+{
+// Minimum number of pixels processed by each thread; smaller images are processed on the calling thread only
+constexpr std::size_t minPixelsPerThread = 512 * 1024;
+
+// Minimum number of rows of the given width processed by each thread
+std::size_t getMinRowsPerThread(std::size_t width)
+{
+    return std::max<std::size_t>(minPixelsPerThread / std::max<std::size_t>(width, 1), 1);
+}
+
+// Source samples contributing to each destination sample of a resampling pass
+struct ResampleWeights
+{
+    std::size_t              taps;    //!< Number of source samples per destination sample
+    std::vector<std::size_t> first;   //!< Index of the first source sample of each destination sample
+    std::vector<float>       weights; //!< Normalized weights, taps per destination sample
+};
+
+// Half-width of the filters, in source samples when not downscaling
+double getFilterSupport(sf::Image::ResizeFilter filter)
+{
+    switch (filter)
+    {
+        case sf::Image::Box:
+            return 0.5;
+        case sf::Image::Lanczos:
+            return 3.0;
+        default:
+            return 1.0;
+    }
+}
+
+// Value of the filters at a distance from the center of the destination sample
+double evaluateFilter(sf::Image::ResizeFilter filter, double x)
+{
+    const double pi = 3.14159265358979323846;
+
+    switch (filter)
+    {
+        case sf::Image::Box:
+            return ((x > -0.5) && (x <= 0.5)) ? 1.0 : 0.0;
+        case sf::Image::Lanczos:
+        {
+            if (x == 0.0)
+                return 1.0;
+            if ((x <= -3.0) || (x >= 3.0))
+                return 0.0;
+            return 3.0 * std::sin(pi * x) * std::sin(pi * x / 3.0) / (pi * pi * x * x);
+        }
+        default:
+            return std::max(1.0 - std::abs(x), 0.0);
+    }
+}
+
+// Compute the weights of a resampling pass along one dimension
+ResampleWeights computeWeights(std::size_t srcSize, std::size_t dstSize, sf::Image::ResizeFilter filter)
+{
+    // When downscaling, the filter is stretched to cover all the source samples
+    const double scale       = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+    const double filterScale = std::max(scale, 1.0);
+    const double support     = getFilterSupport(filter) * filterScale;
+
+    ResampleWeights result;
+    result.taps = std::min(static_cast<std::size_t>(std::ceil(support)) * 2 + 1, srcSize);
+    result.first.resize(dstSize);
+    result.weights.resize(dstSize * result.taps, 0.f);
+
+    for (std::size_t i = 0; i < dstSize; ++i)
+    {
+        const double center = (static_cast<double>(i) + 0.5) * scale;
+        const auto   begin  = static_cast<std::size_t>(std::max(center - support + 0.5, 0.0));
+        const auto   end    = std::min(static_cast<std::size_t>(std::max(center + support + 0.5, 0.0)), srcSize);
+
+        // All destination samples use the same number of taps, windows are shifted to stay within the source
+        const std::size_t first   = std::min(begin, srcSize - result.taps);
+        float*            weights = &result.weights[i * result.taps];
+
+        double total = 0.0;
+        for (std::size_t j = begin; j < end; ++j)
+            total += evaluateFilter(filter, (static_cast<double>(j) - center + 0.5) / filterScale);
+
+        if (total != 0.0)
+        {
+            for (std::size_t j = begin; j < end; ++j)
+                weights[j - first] = static_cast<float>(
+                    evaluateFilter(filter, (static_cast<double>(j) - center + 0.5) / filterScale) / total);
+        }
+
+        result.first[i] = first;
+    }
+
+    return result;
+}
+
+// Resample RGBA pixels with a nearest filter
+void resampleNearest(const sf::Uint8* src, const sf::Vector2u& srcSize, sf::Uint8* dst, const sf::Vector2u& dstSize)
+{
+    const std::size_t srcWidth = srcSize.x;
+    const std::size_t dstWidth = dstSize.x;
+    const auto        srcPixel = [](std::size_t i, std::size_t srcLength, std::size_t dstLength)
+    { return std::min((2 * i + 1) * srcLength / (2 * dstLength), srcLength - 1); };
+
+    std::vector<std::size_t> columns(dstWidth);
+    for (std::size_t x = 0; x < dstWidth; ++x)
+        columns[x] = srcPixel(x, srcWidth, dstWidth);
+
+    sf::priv::parallelFor(dstSize.y,
+                          getMinRowsPerThread(dstWidth),
+                          [&](std::size_t begin, std::size_t end)
+                          {
+                              for (std::size_t y = begin; y < end; ++y)
+                              {
+                                  const sf::Uint8* srcRow = src + srcPixel(y, srcSize.y, dstSize.y) * srcWidth * 4;
+                                  sf::Uint8*       dstRow = dst + y * dstWidth * 4;
+                                  for (std::size_t x = 0; x < dstWidth; ++x)
+                                      std::memcpy(dstRow + x * 4, srcRow + columns[x] * 4, 4);
+                              }
+                          });
+}
+
+// Resample RGBA pixels with a separable filter, in premultiplied alpha
+void resampleSeparable(const sf::Uint8*        src,
+                       const sf::Vector2u&     srcSize,
+                       sf::Uint8*              dst,
+                       const sf::Vector2u&     dstSize,
+                       sf::Image::ResizeFilter filter)
+{
+    const ResampleWeights horizontal = computeWeights(srcSize.x, dstSize.x, filter);
+    const ResampleWeights vertical   = computeWeights(srcSize.y, dstSize.y, filter);
+
+    const std::size_t srcWidth = srcSize.x;
+    const std::size_t dstWidth = dstSize.x;
+    const std::size_t taps     = vertical.taps;
+
+    // The cost of a destination row grows with the widths and the number of source rows it combines
+    const std::size_t rowCost = std::max(srcWidth, dstWidth) * taps;
+
+    sf::priv::parallelFor(
+        dstSize.y,
+        getMinRowsPerThread(rowCost),
+        [&](std::size_t begin, std::size_t end)
+        {
+            // Source rows resampled horizontally are kept in a ring buffer: since the windows of consecutive
+            // destination rows overlap, each source row is converted and resampled only once per thread
+            std::vector<float>        sourceRow(srcWidth * 4);
+            std::vector<float>        ring(taps * dstWidth * 4);
+            std::vector<std::size_t>  ringRows(taps, srcSize.y);
+            std::vector<const float*> rows(taps);
+            std::vector<float>        destinationRow(dstWidth * 4);
+
+            for (std::size_t y = begin; y < end; ++y)
+            {
+                for (std::size_t k = 0; k < taps; ++k)
+                {
+                    const std::size_t row  = vertical.first[y] + k;
+                    const std::size_t slot = row % taps;
+                    float*            data = &ring[slot * dstWidth * 4];
+
+                    if (ringRows[slot] != row)
+                    {
+                        sf::priv::premultiplyPixels(src + row * srcWidth * 4, sourceRow.data(), srcWidth);
+                        sf::priv::resampleHorizontally(sourceRow.data(),
+                                                       data,
+                                                       dstWidth,
+                                                       horizontal.first.data(),
+                                                       horizontal.weights.data(),
+                                                       horizontal.taps);
+                        ringRows[slot] = row;
+                    }
+
+                    rows[k] = data;
+                }
+
+                sf::priv::resampleVertically(rows.data(),
+                                             &vertical.weights[y * taps],
+                                             taps,
+                                             destinationRow.data(),
+                                             dstWidth * 4);
+                sf::priv::unpremultiplyPixels(destinationRow.data(), dst + y * dstWidth * 4, dstWidth);
+            }
+        });
+}
+} // namespace ImageImpl
+} // namespace
 
 
 namespace sf
@@ -47,15 +241,12 @@ void Image::create(const Vector2u& size, const Color& color)
         std::vector<Uint8> newPixels(static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * 4);
 
         // Fill it with the specified color
-        Uint8* ptr = newPixels.data();
-        Uint8* end = ptr + newPixels.size();
-        while (ptr < end)
-        {
-            *ptr++ = color.r;
-            *ptr++ = color.g;
-            *ptr++ = color.b;
-            *ptr++ = color.a;
-        }
+        const Uint8 components[] = {color.r, color.g, color.b, color.a};
+        Uint8*      data         = newPixels.data();
+        priv::parallelFor(newPixels.size() / 4,
+                          ImageImpl::minPixelsPerThread,
+                          [data, &components](std::size_t begin, std::size_t end)
+                          { priv::fillPixels(data + begin * 4, end - begin, components); });
 
         // Commit the new pixel buffer
         m_pixels.swap(newPixels);
@@ -101,6 +292,55 @@ void Image::create(const Vector2u& size, const Uint8* pixels)
 }
 
 
+////////////////////////////////////////////////////////////
+void Image::create(const Vector2u& size, const void* pixels, PixelFormat format)
+{
+    if (pixels && size.x && size.y)
+    {
+        // Create a new pixel buffer first for exception safety's sake
+        const std::size_t  pixelCount = static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y);
+        std::vector<Uint8> newPixels(pixelCount * 4);
+
+        // Convert the pixels to RGBA8
+        priv::convertPixels(static_cast<const Uint8*>(pixels), format, newPixels.data(), RGBA8, pixelCount);
+
+        // Commit the new pixel buffer
+        m_pixels.swap(newPixels);
+
+        // Assign the new size
+        m_size = size;
+    }
+    else
+    {
+        create(size, static_cast<const Uint8*>(nullptr));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::create(const Vector2u& size, std::vector<Uint8>&& pixels)
+{
+    const std::size_t expectedSize = static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * 4;
+
+    if (size.x && size.y && (pixels.size() == expectedSize))
+    {
+        // Take over the pixel buffer
+        m_pixels = std::move(pixels);
+
+        // Assign the new size
+        m_size = size;
+    }
+    else
+    {
+        if (pixels.size() != expectedSize)
+            err() << "Failed to create image, the array of " << pixels.size() << " bytes doesn't match the size "
+                  << size.x << "x" << size.y << std::endl;
+
+        create(size, static_cast<const Uint8*>(nullptr));
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Image::loadFromFile(const std::filesystem::path& filename)
 {
@@ -132,15 +372,29 @@ bool Image::loadFromStream(InputStream& stream)
 
 
 ////////////////////////////////////////////////////////////
-bool Image::saveToFile(const std::filesystem::path& filename) const
+bool Image::saveToFile(const std::filesystem::path& filename, const SaveSettings& settings) const
 {
-    return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size);
+    return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size, settings);
 }
 
 ////////////////////////////////////////////////////////////
-bool Image::saveToMemory(std::vector<sf::Uint8>& output, const std::string& format) const
+bool Image::saveToMemory(std::vector<sf::Uint8>& output, const std::string& format, const SaveSettings& settings) const
 {
-    return priv::ImageLoader::getInstance().saveImageToMemory(format, output, m_pixels, m_size);
+    return priv::ImageLoader::getInstance().saveImageToMemory(format, output, m_pixels, m_size, settings);
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<std::size_t> Image::saveToMemory(void*               output,
+                                               std::size_t         capacity,
+                                               const std::string&  format,
+                                               const SaveSettings& settings) const
+{
+    std::size_t size = 0;
+    if (!priv::ImageLoader::getInstance().saveImageToMemory(format, output, capacity, size, m_pixels, m_size, settings))
+        return std::nullopt;
+
+    return size;
 }
 
 
@@ -158,14 +412,12 @@ void Image::createMaskFromColor(const Color& color, Uint8 alpha)
     if (!m_pixels.empty())
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = m_pixels.data();
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        const Uint8 components[] = {color.r, color.g, color.b, color.a};
+        Uint8*      data         = m_pixels.data();
+        priv::parallelFor(m_pixels.size() / 4,
+                          ImageImpl::minPixelsPerThread,
+                          [data, &components, alpha](std::size_t begin, std::size_t end)
+                          { priv::maskPixels(data + begin * 4, end - begin, components, alpha); });
     }
 }
 
@@ -215,29 +467,10 @@ void Image::createMaskFromColor(const Color& color, Uint8 alpha)
     // Copy the pixels
     if (applyAlpha)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
+        // Interpolation using alpha values, row by row with the vectorized kernel of the CPU
         for (unsigned int i = 0; i < dstSize.y; ++i)
         {
-            for (unsigned int j = 0; j < dstSize.x; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha values of the destination and source pixels
-                Uint8 src_alpha = src[3];
-                Uint8 dst_alpha = dst[3];
-                Uint8 out_alpha = static_cast<Uint8>(src_alpha + dst_alpha - src_alpha * dst_alpha / 255);
-
-                dst[3] = out_alpha;
-
-                if (out_alpha)
-                    for (int k = 0; k < 3; k++)
-                        dst[k] = static_cast<Uint8>((src[k] * src_alpha + dst[k] * (out_alpha - src_alpha)) / out_alpha);
-                else
-                    for (int k = 0; k < 3; k++)
-                        dst[k] = src[k];
-            }
+            priv::blendPixels(dstPixels, srcPixels, dstSize.x);
 
             srcPixels += srcStride;
             dstPixels += dstStride;
@@ -293,26 +526,34 @@ const Uint8* Image::getPixelsPtr() const
 
 
 ////////////////////////////////////////////////////////////
-void Image::flipHorizontally()
+std::vector<Uint8> Image::convertPixels(PixelFormat format) const
 {
-    if (!m_pixels.empty())
-    {
-        std::size_t rowSize = m_size.x * 4;
+    const std::size_t  pixelCount = m_pixels.size() / 4;
+    std::vector<Uint8> pixels(pixelCount * getPixelSize(format));
 
-        for (std::size_t y = 0; y < m_size.y; ++y)
-        {
-            auto left  = m_pixels.begin() + static_cast<std::vector<Uint8>::iterator::difference_type>(y * rowSize);
-            auto right = m_pixels.begin() +
-                         static_cast<std::vector<Uint8>::iterator::difference_type>((y + 1) * rowSize - 4);
+    if (pixelCount > 0)
+        priv::convertPixels(m_pixels.data(), RGBA8, pixels.data(), format, pixelCount);
 
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
-            {
-                std::swap_ranges(left, left + 4, right);
+    return pixels;
+}
 
-                left += 4;
-                right -= 4;
-            }
-        }
+
+////////////////////////////////////////////////////////////
+void Image::flipHorizontally()
+{
+    if (!m_pixels.empty())
+    {
+        const std::size_t width = m_size.x;
+        Uint8*            data  = m_pixels.data();
+
+        // Rows are independent, large images are split into bands of rows processed in parallel
+        priv::parallelFor(m_size.y,
+                          ImageImpl::getMinRowsPerThread(width),
+                          [data, width](std::size_t begin, std::size_t end)
+                          {
+                              for (std::size_t y = begin; y < end; ++y)
+                                  priv::reversePixels(data + y * width * 4, width);
+                          });
     }
 }
 
@@ -322,19 +563,87 @@ void Image::flipVertically()
 {
     if (!m_pixels.empty())
     {
-        auto rowSize = static_cast<std::vector<Uint8>::iterator::difference_type>(m_size.x * 4);
+        const std::size_t width  = m_size.x;
+        const std::size_t height = m_size.y;
+        Uint8*            data   = m_pixels.data();
+
+        // Each pair of rows is independent, large images are split into bands of pairs processed in parallel
+        priv::parallelFor(height / 2,
+                          ImageImpl::getMinRowsPerThread(width * 2),
+                          [data, width, height](std::size_t begin, std::size_t end)
+                          {
+                              for (std::size_t y = begin; y < end; ++y)
+                                  priv::swapPixels(data + y * width * 4, data + (height - 1 - y) * width * 4, width);
+                          });
+    }
+}
 
-        auto top    = m_pixels.begin();
-        auto bottom = m_pixels.end() - rowSize;
 
-        for (std::size_t y = 0; y < m_size.y / 2; ++y)
-        {
-            std::swap_ranges(top, top + rowSize, bottom);
+////////////////////////////////////////////////////////////
+void Image::resize(const Vector2u& size, ResizeFilter filter)
+{
+    *this = scaled(size, filter);
+}
 
-            top += rowSize;
-            bottom -= rowSize;
-        }
+
+////////////////////////////////////////////////////////////
+Image Image::scaled(const Vector2u& size, ResizeFilter filter) const
+{
+    Image result;
+
+    // Nothing to resample?
+    if (m_pixels.empty() || !size.x || !size.y)
+        return result;
+
+    if (size == m_size)
+        return *this;
+
+    result.m_pixels.resize(static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * 4);
+    result.m_size = size;
+
+    if (filter == Nearest)
+        ImageImpl::resampleNearest(m_pixels.data(), m_size, result.m_pixels.data(), size);
+    else
+        ImageImpl::resampleSeparable(m_pixels.data(), m_size, result.m_pixels.data(), size, filter);
+
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<Image> Image::generateMipmaps(ResizeFilter filter) const
+{
+    std::vector<Image> levels;
+
+    if (m_pixels.empty())
+        return levels;
+
+    // Each level is computed from the previous one
+    Vector2u size = m_size;
+    while ((size.x > 1) || (size.y > 1))
+    {
+        size.x = std::max(size.x / 2, 1u);
+        size.y = std::max(size.y / 2, 1u);
+
+        const Image& previous = levels.empty() ? *this : levels.back();
+        levels.push_back(previous.scaled(size, filter));
     }
+
+    return levels;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::setMaximumThreadCount(unsigned int count)
+{
+    priv::setMaximumThreadCount(count);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Image::getMaximumThreadCount()
+{
+    return priv::getMaximumThreadCount();
 }
 
 } // namespace sf
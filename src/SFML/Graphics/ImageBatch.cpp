@@ -0,0 +1,245 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageBatch.hpp>
+
+#include <SFML/System/Err.hpp>
+#include <SFML/System/InputStream.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+struct ImageBatchImpl
+{
+    ////////////////////////////////////////////////////////////
+    std::size_t count() const
+    {
+        return filenames.empty() ? streams.size() : filenames.size();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Load the next source which has not been started yet, returns false if there is none
+    ////////////////////////////////////////////////////////////
+    bool loadNext()
+    {
+        if (stop)
+            return false;
+
+        const std::size_t index = next++;
+        if (index >= count())
+            return false;
+
+        ImageBatch::Result result{index, false, Image(), std::string()};
+
+        // Several images are loaded at the same time, their errors must not be written to sf::err() concurrently
+        std::ostringstream  errors;
+        std::ostream* const previous = setThreadErrStream(&errors);
+        result.success = filenames.empty() ? result.image.loadFromStream(*streams[index])
+                                           : result.image.loadFromFile(filenames[index]);
+        setThreadErrStream(previous);
+        result.error = errors.str();
+
+        {
+            std::lock_guard lock(mutex);
+            results.push_back(std::move(result));
+        }
+        condition.notify_one();
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Entry point of the worker threads
+    ////////////////////////////////////////////////////////////
+    void run()
+    {
+        while (loadNext())
+        {
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void start(unsigned int threadCount)
+    {
+        if (threadCount == 0)
+            threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+        const std::size_t workerCount = std::min<std::size_t>(threadCount, count());
+
+        try
+        {
+            threads.reserve(workerCount);
+            for (std::size_t i = 0; i < workerCount; ++i)
+                threads.emplace_back(&ImageBatchImpl::run, this);
+        }
+        catch (const std::exception&)
+        {
+            // Threads couldn't be created: the remaining sources are loaded by poll and wait
+        }
+    }
+
+    std::vector<std::filesystem::path> filenames;   //!< Source files, empty when loading from streams
+    std::vector<InputStream*>          streams;     //!< Source streams, empty when loading from files
+    std::atomic<std::size_t>           next{0};     //!< Index of the next source to load
+    std::atomic<bool>                  stop{false}; //!< Tells the workers to stop starting new sources
+    std::mutex                         mutex;       //!< Protects the results
+    std::condition_variable            condition;   //!< Signaled when a result is added
+    std::deque<ImageBatch::Result>     results;     //!< Loaded images not returned yet
+    std::size_t                        returned{0}; //!< Number of results returned so far
+    std::vector<std::thread>           threads;     //!< Worker threads
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+ImageBatch::ImageBatch(std::vector<std::filesystem::path> filenames, unsigned int threadCount) :
+m_impl(std::make_unique<priv::ImageBatchImpl>())
+{
+    m_impl->filenames = std::move(filenames);
+    m_impl->start(threadCount);
+}
+
+
+////////////////////////////////////////////////////////////
+ImageBatch::ImageBatch(std::vector<InputStream*> streams, unsigned int threadCount) :
+m_impl(std::make_unique<priv::ImageBatchImpl>())
+{
+    m_impl->streams = std::move(streams);
+    m_impl->start(threadCount);
+}
+
+
+////////////////////////////////////////////////////////////
+ImageBatch::~ImageBatch()
+{
+    if (!m_impl)
+        return;
+
+    m_impl->stop = true;
+    for (std::thread& thread : m_impl->threads)
+        thread.join();
+}
+
+
+////////////////////////////////////////////////////////////
+ImageBatch::ImageBatch(ImageBatch&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+ImageBatch& ImageBatch::operator=(ImageBatch&& right) noexcept
+{
+    if (this != &right)
+    {
+        ImageBatch temp(std::move(*this));
+        m_impl = std::move(right.m_impl);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageBatch::getCount() const
+{
+    return m_impl ? m_impl->count() : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageBatch::getRemainingCount() const
+{
+    return m_impl ? m_impl->count() - m_impl->returned : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageBatch::poll(Result& result)
+{
+    if (!m_impl)
+        return false;
+
+    // Without worker threads, load the next source here
+    if (m_impl->threads.empty())
+        m_impl->loadNext();
+
+    std::lock_guard lock(m_impl->mutex);
+    if (m_impl->results.empty())
+        return false;
+
+    result = std::move(m_impl->results.front());
+    m_impl->results.pop_front();
+    ++m_impl->returned;
+
+    // The errors of the image are written by the thread which consumes it
+    if (!result.error.empty())
+        err() << result.error << std::flush;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageBatch::wait(Result& result)
+{
+    if (!m_impl || (m_impl->returned == m_impl->count()))
+        return false;
+
+    // Without worker threads, load the next source here
+    if (m_impl->threads.empty())
+        m_impl->loadNext();
+
+    std::unique_lock lock(m_impl->mutex);
+    m_impl->condition.wait(lock, [this] { return !m_impl->results.empty(); });
+
+    result = std::move(m_impl->results.front());
+    m_impl->results.pop_front();
+    ++m_impl->returned;
+
+    // The errors of the image are written by the thread which consumes it
+    if (!result.error.empty())
+        err() << result.error << std::flush;
+
+    return true;
+}
+
+} // namespace sf
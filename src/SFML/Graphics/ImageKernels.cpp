@@ -0,0 +1,883 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageKernels.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define SFML_IMAGEKERNELS_SSE2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define SFML_IMAGEKERNELS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SFML_IMAGEKERNELS_TARGET_AVX2
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SFML_IMAGEKERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+
+namespace
+{
+// A nested named namespace is used here to allow unity builds of SFML.
+namespace ImageKernelsImpl
+{
+////////////////////////////////////////////////////////////
+// Reference implementation, also used for the pixels left over by the vectorized ones
+void blendPixelsScalar(sf::Uint8* dst, const sf::Uint8* src, std::size_t pixelCount)
+{
+    for (std::size_t i = 0; i < pixelCount; ++i, src += 4, dst += 4)
+    {
+        // Interpolate RGBA components using the alpha values of the destination and source pixels
+        sf::Uint8 src_alpha = src[3];
+        sf::Uint8 dst_alpha = dst[3];
+        sf::Uint8 out_alpha = static_cast<sf::Uint8>(src_alpha + dst_alpha - src_alpha * dst_alpha / 255);
+
+        dst[3] = out_alpha;
+
+        if (out_alpha)
+            for (int k = 0; k < 3; k++)
+                dst[k] = static_cast<sf::Uint8>((src[k] * src_alpha + dst[k] * (out_alpha - src_alpha)) / out_alpha);
+        else
+            for (int k = 0; k < 3; k++)
+                dst[k] = src[k];
+    }
+}
+
+// The vectorized implementations evaluate the scalar formula in single precision:
+// all the intermediate values are integers lower than 2^24, so they are exact, and
+// the quotients are far enough from the next integer for their truncation to match
+// the integer divisions.
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+
+////////////////////////////////////////////////////////////
+// Select the lanes of a where mask is set, and the lanes of b elsewhere
+inline __m128i select(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+
+////////////////////////////////////////////////////////////
+// Blend one pixel, with one 32-bit channel per lane
+inline __m128i blendPixelSse2(__m128i source, __m128i destination)
+{
+    const __m128i alphaLane = _mm_set_epi32(-1, 0, 0, 0);
+
+    const __m128 src      = _mm_cvtepi32_ps(source);
+    const __m128 dst      = _mm_cvtepi32_ps(destination);
+    const __m128 srcAlpha = _mm_shuffle_ps(src, src, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128 dstAlpha = _mm_shuffle_ps(dst, dst, _MM_SHUFFLE(3, 3, 3, 3));
+
+    // out_alpha = src_alpha + dst_alpha - src_alpha * dst_alpha / 255
+    const __m128i product  = _mm_cvttps_epi32(_mm_div_ps(_mm_mul_ps(srcAlpha, dstAlpha), _mm_set1_ps(255.f)));
+    const __m128  outAlpha = _mm_sub_ps(_mm_add_ps(srcAlpha, dstAlpha), _mm_cvtepi32_ps(product));
+
+    // color = (src * src_alpha + dst * (out_alpha - src_alpha)) / out_alpha
+    const __m128 numerator = _mm_add_ps(_mm_mul_ps(src, srcAlpha), _mm_mul_ps(dst, _mm_sub_ps(outAlpha, srcAlpha)));
+    __m128i      color     = _mm_cvttps_epi32(_mm_div_ps(numerator, outAlpha));
+
+    // A null output alpha means that both pixels are fully transparent, the source color is kept
+    const __m128i transparent = _mm_castps_si128(_mm_cmpeq_ps(outAlpha, _mm_setzero_ps()));
+    color                     = select(transparent, source, color);
+
+    return select(alphaLane, _mm_cvttps_epi32(outAlpha), color);
+}
+
+
+////////////////////////////////////////////////////////////
+void blendPixelsSse2(sf::Uint8* dst, const sf::Uint8* src, std::size_t pixelCount)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    std::size_t i = 0;
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        const __m128i source      = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        const __m128i destination = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+
+        // Widen the channels to 32 bits, one pixel per register
+        const __m128i sourceLow       = _mm_unpacklo_epi8(source, zero);
+        const __m128i sourceHigh      = _mm_unpackhi_epi8(source, zero);
+        const __m128i destinationLow  = _mm_unpacklo_epi8(destination, zero);
+        const __m128i destinationHigh = _mm_unpackhi_epi8(destination, zero);
+
+        const __m128i pixel0 = blendPixelSse2(_mm_unpacklo_epi16(sourceLow, zero), _mm_unpacklo_epi16(destinationLow, zero));
+        const __m128i pixel1 = blendPixelSse2(_mm_unpackhi_epi16(sourceLow, zero), _mm_unpackhi_epi16(destinationLow, zero));
+        const __m128i pixel2 = blendPixelSse2(_mm_unpacklo_epi16(sourceHigh, zero),
+                                              _mm_unpacklo_epi16(destinationHigh, zero));
+        const __m128i pixel3 = blendPixelSse2(_mm_unpackhi_epi16(sourceHigh, zero),
+                                              _mm_unpackhi_epi16(destinationHigh, zero));
+
+        // Narrow the channels back to 8 bits, all values are in [0, 255]
+        const __m128i result = _mm_packus_epi16(_mm_packs_epi32(pixel0, pixel1), _mm_packs_epi32(pixel2, pixel3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), result);
+    }
+
+    blendPixelsScalar(dst + i * 4, src + i * 4, pixelCount - i);
+}
+
+
+////////////////////////////////////////////////////////////
+// Blend two pixels, with one 32-bit channel per lane
+SFML_IMAGEKERNELS_TARGET_AVX2 inline __m256i blendPixelPairAvx2(__m256i source, __m256i destination)
+{
+    const __m256i alphaLanes = _mm256_set_epi32(-1, 0, 0, 0, -1, 0, 0, 0);
+
+    const __m256 src      = _mm256_cvtepi32_ps(source);
+    const __m256 dst      = _mm256_cvtepi32_ps(destination);
+    const __m256 srcAlpha = _mm256_shuffle_ps(src, src, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m256 dstAlpha = _mm256_shuffle_ps(dst, dst, _MM_SHUFFLE(3, 3, 3, 3));
+
+    // out_alpha = src_alpha + dst_alpha - src_alpha * dst_alpha / 255
+    const __m256i product  = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_mul_ps(srcAlpha, dstAlpha), _mm256_set1_ps(255.f)));
+    const __m256  outAlpha = _mm256_sub_ps(_mm256_add_ps(srcAlpha, dstAlpha), _mm256_cvtepi32_ps(product));
+
+    // color = (src * src_alpha + dst * (out_alpha - src_alpha)) / out_alpha
+    const __m256 numerator = _mm256_add_ps(_mm256_mul_ps(src, srcAlpha),
+                                           _mm256_mul_ps(dst, _mm256_sub_ps(outAlpha, srcAlpha)));
+    __m256i      color     = _mm256_cvttps_epi32(_mm256_div_ps(numerator, outAlpha));
+
+    // A null output alpha means that both pixels are fully transparent, the source color is kept
+    const __m256 transparent = _mm256_cmp_ps(outAlpha, _mm256_setzero_ps(), _CMP_EQ_OQ);
+    color                    = _mm256_blendv_epi8(color, source, _mm256_castps_si256(transparent));
+
+    return _mm256_blendv_epi8(color, _mm256_cvttps_epi32(outAlpha), alphaLanes);
+}
+
+
+////////////////////////////////////////////////////////////
+SFML_IMAGEKERNELS_TARGET_AVX2 void blendPixelsAvx2(sf::Uint8* dst, const sf::Uint8* src, std::size_t pixelCount)
+{
+    // Packing works within 128-bit lanes, this puts the pixels back in order
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    std::size_t i = 0;
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        __m256i pixels[4];
+
+        for (std::size_t j = 0; j < 4; ++j)
+        {
+            // Widen the channels of two pixels to 32 bits
+            const __m128i source      = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + (i + 2 * j) * 4));
+            const __m128i destination = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(dst + (i + 2 * j) * 4));
+            pixels[j] = blendPixelPairAvx2(_mm256_cvtepu8_epi32(source), _mm256_cvtepu8_epi32(destination));
+        }
+
+        // Narrow the channels back to 8 bits, all values are in [0, 255]
+        const __m256i result = _mm256_packus_epi16(_mm256_packs_epi32(pixels[0], pixels[1]),
+                                                   _mm256_packs_epi32(pixels[2], pixels[3]));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_permutevar8x32_epi32(result, order));
+    }
+
+    blendPixelsSse2(dst + i * 4, src + i * 4, pixelCount - i);
+}
+
+
+////////////////////////////////////////////////////////////
+bool isAvx2Supported()
+{
+#if defined(_MSC_VER)
+    int info[4];
+
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // The OS must save the AVX registers, in addition to the CPU supporting the instructions
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || ((_xgetbv(0) & 6) != 6))
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#elif defined(SFML_IMAGEKERNELS_NEON)
+
+////////////////////////////////////////////////////////////
+// Blend one pixel, with one 32-bit channel per lane
+inline uint32x4_t blendPixelNeon(uint32x4_t source, uint32x4_t destination)
+{
+    const uint32x4_t alphaLane = vsetq_lane_u32(0xFFFFFFFF, vdupq_n_u32(0), 3);
+
+    const float32x4_t src      = vcvtq_f32_u32(source);
+    const float32x4_t dst      = vcvtq_f32_u32(destination);
+    const float32x4_t srcAlpha = vdupq_laneq_f32(src, 3);
+    const float32x4_t dstAlpha = vdupq_laneq_f32(dst, 3);
+
+    // out_alpha = src_alpha + dst_alpha - src_alpha * dst_alpha / 255
+    const uint32x4_t  product  = vcvtq_u32_f32(vdivq_f32(vmulq_f32(srcAlpha, dstAlpha), vdupq_n_f32(255.f)));
+    const float32x4_t outAlpha = vsubq_f32(vaddq_f32(srcAlpha, dstAlpha), vcvtq_f32_u32(product));
+
+    // color = (src * src_alpha + dst * (out_alpha - src_alpha)) / out_alpha
+    const float32x4_t numerator = vaddq_f32(vmulq_f32(src, srcAlpha), vmulq_f32(dst, vsubq_f32(outAlpha, srcAlpha)));
+    uint32x4_t        color     = vcvtq_u32_f32(vdivq_f32(numerator, outAlpha));
+
+    // A null output alpha means that both pixels are fully transparent, the source color is kept
+    color = vbslq_u32(vceqq_f32(outAlpha, vdupq_n_f32(0.f)), source, color);
+
+    return vbslq_u32(alphaLane, vcvtq_u32_f32(outAlpha), color);
+}
+
+
+////////////////////////////////////////////////////////////
+void blendPixelsNeon(sf::Uint8* dst, const sf::Uint8* src, std::size_t pixelCount)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        const uint8x16_t source      = vld1q_u8(src + i * 4);
+        const uint8x16_t destination = vld1q_u8(dst + i * 4);
+
+        // Widen the channels to 32 bits, one pixel per register
+        const uint16x8_t sourceLow       = vmovl_u8(vget_low_u8(source));
+        const uint16x8_t sourceHigh      = vmovl_high_u8(source);
+        const uint16x8_t destinationLow  = vmovl_u8(vget_low_u8(destination));
+        const uint16x8_t destinationHigh = vmovl_high_u8(destination);
+
+        const uint32x4_t pixel0 = blendPixelNeon(vmovl_u16(vget_low_u16(sourceLow)), vmovl_u16(vget_low_u16(destinationLow)));
+        const uint32x4_t pixel1 = blendPixelNeon(vmovl_high_u16(sourceLow), vmovl_high_u16(destinationLow));
+        const uint32x4_t pixel2 = blendPixelNeon(vmovl_u16(vget_low_u16(sourceHigh)),
+                                                 vmovl_u16(vget_low_u16(destinationHigh)));
+        const uint32x4_t pixel3 = blendPixelNeon(vmovl_high_u16(sourceHigh), vmovl_high_u16(destinationHigh));
+
+        // Narrow the channels back to 8 bits, all values are in [0, 255]
+        const uint16x8_t low  = vcombine_u16(vmovn_u32(pixel0), vmovn_u32(pixel1));
+        const uint16x8_t high = vcombine_u16(vmovn_u32(pixel2), vmovn_u32(pixel3));
+        vst1q_u8(dst + i * 4, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+    }
+
+    blendPixelsScalar(dst + i * 4, src + i * 4, pixelCount - i);
+}
+
+#endif
+
+
+////////////////////////////////////////////////////////////
+// Get the 4 components of a pixel as a single value, in memory order
+sf::Uint32 loadPixel(const sf::Uint8* pixel)
+{
+    sf::Uint32 value;
+    std::memcpy(&value, pixel, sizeof(value));
+    return value;
+}
+
+
+////////////////////////////////////////////////////////////
+// Round a float component to the nearest integer (ties to even, like SIMD conversions) in [0, 255]
+sf::Uint8 toComponent(float value)
+{
+    return static_cast<sf::Uint8>(std::nearbyint(std::clamp(value, 0.f, 255.f)));
+}
+
+
+////////////////////////////////////////////////////////////
+// Convert a float to IEEE half precision, rounding to nearest even
+sf::Uint16 toHalf(float value)
+{
+    sf::Uint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const auto sign     = static_cast<sf::Uint16>((bits >> 16) & 0x8000);
+    const int  exponent = static_cast<int>((bits >> 23) & 0xFF) - 127 + 15;
+    sf::Uint32 mantissa = bits & 0x7FFFFF;
+
+    // Infinity and NaN
+    if (((bits >> 23) & 0xFF) == 0xFF)
+        return static_cast<sf::Uint16>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+
+    // Too large: infinity
+    if (exponent >= 31)
+        return static_cast<sf::Uint16>(sign | 0x7C00);
+
+    // Too small: zero
+    if (exponent < -10)
+        return sign;
+
+    // Subnormals keep the implicit leading bit in their mantissa
+    const unsigned int shift = (exponent > 0) ? 13u : static_cast<unsigned int>(14 - exponent);
+    if (exponent <= 0)
+        mantissa |= 0x800000;
+
+    auto half = static_cast<sf::Uint32>(sign | ((exponent > 0 ? static_cast<sf::Uint32>(exponent) : 0u) << 10) |
+                                        (mantissa >> shift));
+
+    // A carry from the mantissa correctly increments the exponent
+    const sf::Uint32 remainder = mantissa & ((1u << shift) - 1);
+    const sf::Uint32 halfway   = 1u << (shift - 1);
+    if ((remainder > halfway) || ((remainder == halfway) && (half & 1)))
+        ++half;
+
+    return static_cast<sf::Uint16>(half);
+}
+
+
+////////////////////////////////////////////////////////////
+// Convert an IEEE half precision number to a float
+float fromHalf(sf::Uint16 half)
+{
+    const sf::Uint32 sign     = static_cast<sf::Uint32>(half & 0x8000) << 16;
+    const sf::Uint32 exponent = (half >> 10) & 0x1F;
+    const sf::Uint32 mantissa = half & 0x3FF;
+
+    // Zero and subnormals
+    if (exponent == 0)
+    {
+        const float value = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -value : value;
+    }
+
+    // Infinity and NaN keep their all-ones exponent
+    const sf::Uint32 bits = sign | ((exponent == 31 ? 255u : exponent - 15 + 127) << 23) | (mantissa << 13);
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+////////////////////////////////////////////////////////////
+// Read and write the 16-bit values of packed formats, in native endianness
+sf::Uint16 loadUint16(const sf::Uint8* data)
+{
+    sf::Uint16 value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+void storeUint16(sf::Uint8* data, sf::Uint16 value)
+{
+    std::memcpy(data, &value, sizeof(value));
+}
+
+
+////////////////////////////////////////////////////////////
+// Scale a component between 8 bits and fewer bits, rounding to nearest
+sf::Uint16 reduceComponent(sf::Uint8 value, unsigned int max)
+{
+    return static_cast<sf::Uint16>((value * max + 127) / 255);
+}
+
+sf::Uint8 expandComponent(unsigned int value, unsigned int max)
+{
+    return static_cast<sf::Uint8>((value * 255 + max / 2) / max);
+}
+
+
+////////////////////////////////////////////////////////////
+// Convert pixels of any format to RGBA8
+void convertToRgba8(const sf::Uint8* src, sf::PixelFormat format, sf::Uint8* dst, std::size_t pixelCount)
+{
+    switch (format)
+    {
+        case sf::R8:
+            for (std::size_t i = 0; i < pixelCount; ++i, dst += 4)
+            {
+                dst[0] = src[i];
+                dst[1] = 0;
+                dst[2] = 0;
+                dst[3] = 255;
+            }
+            break;
+
+        case sf::RG8:
+            for (std::size_t i = 0; i < pixelCount; ++i, src += 2, dst += 4)
+            {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = 0;
+                dst[3] = 255;
+            }
+            break;
+
+        case sf::RGB565:
+            for (std::size_t i = 0; i < pixelCount; ++i, src += 2, dst += 4)
+            {
+                const sf::Uint16 value = loadUint16(src);
+                dst[0]                 = expandComponent((value >> 11) & 0x1F, 31);
+                dst[1]                 = expandComponent((value >> 5) & 0x3F, 63);
+                dst[2]                 = expandComponent(value & 0x1F, 31);
+                dst[3]                 = 255;
+            }
+            break;
+
+        case sf::RGBA4444:
+            for (std::size_t i = 0; i < pixelCount; ++i, src += 2, dst += 4)
+            {
+                const sf::Uint16 value = loadUint16(src);
+                for (unsigned int k = 0; k < 4; ++k)
+                    dst[k] = expandComponent((value >> (12 - 4 * k)) & 0xF, 15);
+            }
+            break;
+
+        case sf::RGBA16F:
+            for (std::size_t i = 0; i < pixelCount * 4; ++i, src += 2)
+                dst[i] = toComponent(fromHalf(loadUint16(src)) * 255.f);
+            break;
+
+        default:
+            std::memcpy(dst, src, pixelCount * 4);
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+// Convert RGBA8 pixels to any format
+void convertFromRgba8(const sf::Uint8* src, sf::Uint8* dst, sf::PixelFormat format, std::size_t pixelCount)
+{
+    switch (format)
+    {
+        case sf::R8:
+            for (std::size_t i = 0; i < pixelCount; ++i, src += 4)
+                dst[i] = src[0];
+            break;
+
+        case sf::RG8:
+            for (std::size_t i = 0; i < pixelCount; ++i, src += 4, dst += 2)
+            {
+                dst[0] = src[0];
+                dst[1] = src[1];
+            }
+            break;
+
+        case sf::RGB565:
+            for (std::size_t i = 0; i < pixelCount; ++i, src += 4, dst += 2)
+            {
+                storeUint16(dst,
+                            static_cast<sf::Uint16>((reduceComponent(src[0], 31) << 11) |
+                                                    (reduceComponent(src[1], 63) << 5) | reduceComponent(src[2], 31)));
+            }
+            break;
+
+        case sf::RGBA4444:
+            for (std::size_t i = 0; i < pixelCount; ++i, src += 4, dst += 2)
+            {
+                storeUint16(dst,
+                            static_cast<sf::Uint16>((reduceComponent(src[0], 15) << 12) |
+                                                    (reduceComponent(src[1], 15) << 8) |
+                                                    (reduceComponent(src[2], 15) << 4) | reduceComponent(src[3], 15)));
+            }
+            break;
+
+        case sf::RGBA16F:
+            for (std::size_t i = 0; i < pixelCount * 4; ++i, dst += 2)
+                storeUint16(dst, toHalf(static_cast<float>(src[i]) / 255.f));
+            break;
+
+        default:
+            std::memcpy(dst, src, pixelCount * 4);
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+using BlendFunction = void (*)(sf::Uint8*, const sf::Uint8*, std::size_t);
+
+BlendFunction selectBlendFunction()
+{
+#if defined(SFML_IMAGEKERNELS_SSE2)
+    return isAvx2Supported() ? blendPixelsAvx2 : blendPixelsSse2;
+#elif defined(SFML_IMAGEKERNELS_NEON)
+    return blendPixelsNeon;
+#else
+    return blendPixelsScalar;
+#endif
+}
+} // namespace ImageKernelsImpl
+} // namespace
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void blendPixels(Uint8* dst, const Uint8* src, std::size_t pixelCount)
+{
+    // Select the implementation once, based on the CPU features
+    static const ImageKernelsImpl::BlendFunction blend = ImageKernelsImpl::selectBlendFunction();
+
+    blend(dst, src, pixelCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void fillPixels(Uint8* pixels, std::size_t pixelCount, const Uint8* color)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+    const __m128i value = _mm_set1_epi32(static_cast<int>(ImageKernelsImpl::loadPixel(color)));
+    for (; i + 4 <= pixelCount; i += 4)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), value);
+#elif defined(SFML_IMAGEKERNELS_NEON)
+    const uint8x16_t value = vreinterpretq_u8_u32(vdupq_n_u32(ImageKernelsImpl::loadPixel(color)));
+    for (; i + 4 <= pixelCount; i += 4)
+        vst1q_u8(pixels + i * 4, value);
+#endif
+
+    for (; i < pixelCount; ++i)
+        std::memcpy(pixels + i * 4, color, 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t pixelCount, const Uint8* color, Uint8 alpha)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGEKERNELS_SSE2) || defined(SFML_IMAGEKERNELS_NEON)
+    // Compare whole pixels at once, and only replace the alpha component of the matching ones
+    const Uint8 alphaComponent[] = {0, 0, 0, 255};
+    const Uint8 newAlpha[]       = {0, 0, 0, alpha};
+#endif
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+    const __m128i key       = _mm_set1_epi32(static_cast<int>(ImageKernelsImpl::loadPixel(color)));
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(ImageKernelsImpl::loadPixel(alphaComponent)));
+    const __m128i alphaBits = _mm_set1_epi32(static_cast<int>(ImageKernelsImpl::loadPixel(newAlpha)));
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        __m128i*      ptr   = reinterpret_cast<__m128i*>(pixels + i * 4);
+        const __m128i value = _mm_loadu_si128(ptr);
+        const __m128i mask  = _mm_and_si128(_mm_cmpeq_epi32(value, key), alphaMask);
+        _mm_storeu_si128(ptr, _mm_or_si128(_mm_andnot_si128(mask, value), _mm_and_si128(mask, alphaBits)));
+    }
+#elif defined(SFML_IMAGEKERNELS_NEON)
+    const uint32x4_t key       = vdupq_n_u32(ImageKernelsImpl::loadPixel(color));
+    const uint32x4_t alphaMask = vdupq_n_u32(ImageKernelsImpl::loadPixel(alphaComponent));
+    const uint32x4_t alphaBits = vdupq_n_u32(ImageKernelsImpl::loadPixel(newAlpha));
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        const uint32x4_t value = vreinterpretq_u32_u8(vld1q_u8(pixels + i * 4));
+        const uint32x4_t mask  = vandq_u32(vceqq_u32(value, key), alphaMask);
+        vst1q_u8(pixels + i * 4, vreinterpretq_u8_u32(vbslq_u32(mask, alphaBits, value)));
+    }
+#endif
+
+    for (Uint8* ptr = pixels + i * 4; i < pixelCount; ++i, ptr += 4)
+    {
+        if ((ptr[0] == color[0]) && (ptr[1] == color[1]) && (ptr[2] == color[2]) && (ptr[3] == color[3]))
+            ptr[3] = alpha;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t pixelCount)
+{
+    Uint8* left  = pixels;
+    Uint8* right = pixels + pixelCount * 4;
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+    // Exchange blocks of 4 pixels from both ends, reversed, as long as they don't overlap
+    while (right - left >= 32)
+    {
+        right -= 16;
+        const __m128i first  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(left), _mm_shuffle_epi32(second, _MM_SHUFFLE(0, 1, 2, 3)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(right), _mm_shuffle_epi32(first, _MM_SHUFFLE(0, 1, 2, 3)));
+        left += 16;
+    }
+#elif defined(SFML_IMAGEKERNELS_NEON)
+    // Exchange blocks of 4 pixels from both ends, reversed, as long as they don't overlap
+    const auto reverse = [](uint32x4_t value)
+    {
+        value = vrev64q_u32(value);
+        return vcombine_u32(vget_high_u32(value), vget_low_u32(value));
+    };
+
+    while (right - left >= 32)
+    {
+        right -= 16;
+        const uint32x4_t first  = vreinterpretq_u32_u8(vld1q_u8(left));
+        const uint32x4_t second = vreinterpretq_u32_u8(vld1q_u8(right));
+        vst1q_u8(left, vreinterpretq_u8_u32(reverse(second)));
+        vst1q_u8(right, vreinterpretq_u8_u32(reverse(first)));
+        left += 16;
+    }
+#endif
+
+    // Pixels left in the middle
+    while (right - left >= 8)
+    {
+        right -= 4;
+        std::swap_ranges(left, left + 4, right);
+        left += 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void swapPixels(Uint8* first, Uint8* second, std::size_t pixelCount)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        __m128i*      firstPtr    = reinterpret_cast<__m128i*>(first + i * 4);
+        __m128i*      secondPtr   = reinterpret_cast<__m128i*>(second + i * 4);
+        const __m128i firstValue  = _mm_loadu_si128(firstPtr);
+        const __m128i secondValue = _mm_loadu_si128(secondPtr);
+        _mm_storeu_si128(firstPtr, secondValue);
+        _mm_storeu_si128(secondPtr, firstValue);
+    }
+#elif defined(SFML_IMAGEKERNELS_NEON)
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        const uint8x16_t firstValue  = vld1q_u8(first + i * 4);
+        const uint8x16_t secondValue = vld1q_u8(second + i * 4);
+        vst1q_u8(first + i * 4, secondValue);
+        vst1q_u8(second + i * 4, firstValue);
+    }
+#endif
+
+    std::swap_ranges(first + i * 4, first + pixelCount * 4, second + i * 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void premultiplyPixels(const Uint8* src, float* dst, std::size_t pixelCount)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+    const __m128  rgbMask  = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    const __m128  alphaOne = _mm_set_ps(1.f, 0.f, 0.f, 0.f);
+    const __m128  inv255   = _mm_set1_ps(1.f / 255.f);
+    const __m128i zero     = _mm_setzero_si128();
+    for (; i < pixelCount; ++i)
+    {
+        __m128i pixel = _mm_cvtsi32_si128(static_cast<int>(ImageKernelsImpl::loadPixel(src + i * 4)));
+        pixel         = _mm_unpacklo_epi16(_mm_unpacklo_epi8(pixel, zero), zero);
+
+        const __m128 value  = _mm_cvtepi32_ps(pixel);
+        const __m128 alpha  = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128 factor = _mm_or_ps(_mm_and_ps(_mm_mul_ps(alpha, inv255), rgbMask), alphaOne);
+        _mm_storeu_ps(dst + i * 4, _mm_mul_ps(value, factor));
+    }
+#elif defined(SFML_IMAGEKERNELS_NEON)
+    for (; i < pixelCount; ++i)
+    {
+        const uint8x8_t   pixel  = vreinterpret_u8_u32(vdup_n_u32(ImageKernelsImpl::loadPixel(src + i * 4)));
+        const float32x4_t value  = vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(pixel))));
+        const float32x4_t factor = vsetq_lane_f32(1.f, vdupq_n_f32(vgetq_lane_f32(value, 3) * (1.f / 255.f)), 3);
+        vst1q_f32(dst + i * 4, vmulq_f32(value, factor));
+    }
+#endif
+
+    for (; i < pixelCount; ++i)
+    {
+        const float factor = static_cast<float>(src[i * 4 + 3]) * (1.f / 255.f);
+        for (std::size_t k = 0; k < 3; ++k)
+            dst[i * 4 + k] = static_cast<float>(src[i * 4 + k]) * factor;
+        dst[i * 4 + 3] = static_cast<float>(src[i * 4 + 3]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void unpremultiplyPixels(const float* src, Uint8* dst, std::size_t pixelCount)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+    const __m128 rgbMask  = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    const __m128 alphaOne = _mm_set_ps(1.f, 0.f, 0.f, 0.f);
+    const __m128 zero     = _mm_setzero_ps();
+    const __m128 maxValue = _mm_set1_ps(255.f);
+    for (; i < pixelCount; ++i)
+    {
+        const __m128 value  = _mm_loadu_ps(src + i * 4);
+        const __m128 alpha  = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128 factor = _mm_or_ps(_mm_and_ps(_mm_div_ps(maxValue, alpha), rgbMask), alphaOne);
+
+        // Pixels without a positive alpha are discarded, which also gets rid of the divisions by zero
+        __m128 result = _mm_and_ps(_mm_mul_ps(value, factor), _mm_cmpgt_ps(alpha, zero));
+        result        = _mm_min_ps(_mm_max_ps(result, zero), maxValue);
+
+        __m128i pixel = _mm_cvtps_epi32(result);
+        pixel         = _mm_packus_epi16(_mm_packs_epi32(pixel, pixel), pixel);
+
+        const int bytes = _mm_cvtsi128_si32(pixel);
+        std::memcpy(dst + i * 4, &bytes, 4);
+    }
+#elif defined(SFML_IMAGEKERNELS_NEON)
+    const float32x4_t zero     = vdupq_n_f32(0.f);
+    const float32x4_t maxValue = vdupq_n_f32(255.f);
+    for (; i < pixelCount; ++i)
+    {
+        const float32x4_t value = vld1q_f32(src + i * 4);
+        const float       alpha = vgetq_lane_f32(value, 3);
+
+        // Pixels without a positive alpha are discarded
+        const float32x4_t factor = vsetq_lane_f32(1.f, vdupq_n_f32(alpha > 0.f ? 255.f / alpha : 0.f), 3);
+        const float32x4_t result = vminq_f32(vmaxq_f32(vmulq_f32(value, factor), zero), maxValue);
+
+        const uint16x4_t halves = vmovn_u32(vcvtnq_u32_f32(result));
+        const uint32_t   bytes  = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(halves, halves))), 0);
+        std::memcpy(dst + i * 4, &bytes, 4);
+    }
+#endif
+
+    for (; i < pixelCount; ++i)
+    {
+        const float alpha = src[i * 4 + 3];
+        for (std::size_t k = 0; k < 3; ++k)
+            dst[i * 4 + k] = (alpha > 0.f) ? ImageKernelsImpl::toComponent(src[i * 4 + k] * (255.f / alpha)) : 0;
+        dst[i * 4 + 3] = ImageKernelsImpl::toComponent(alpha);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void resampleHorizontally(const float*       src,
+                          float*             dst,
+                          std::size_t        dstCount,
+                          const std::size_t* first,
+                          const float*       weights,
+                          std::size_t        taps)
+{
+    // Pixels are made of 4 floats, which map to a single SIMD register
+    for (std::size_t x = 0; x < dstCount; ++x, dst += 4, weights += taps)
+    {
+        const float* pixels = src + first[x] * 4;
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+        __m128 sum = _mm_setzero_ps();
+        for (std::size_t k = 0; k < taps; ++k)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(pixels + k * 4), _mm_set1_ps(weights[k])));
+        _mm_storeu_ps(dst, sum);
+#elif defined(SFML_IMAGEKERNELS_NEON)
+        float32x4_t sum = vdupq_n_f32(0.f);
+        for (std::size_t k = 0; k < taps; ++k)
+            sum = vmlaq_n_f32(sum, vld1q_f32(pixels + k * 4), weights[k]);
+        vst1q_f32(dst, sum);
+#else
+        float sum[4] = {0.f, 0.f, 0.f, 0.f};
+        for (std::size_t k = 0; k < taps; ++k)
+            for (std::size_t c = 0; c < 4; ++c)
+                sum[c] += pixels[k * 4 + c] * weights[k];
+        std::memcpy(dst, sum, sizeof(sum));
+#endif
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void resampleVertically(const float* const* rows,
+                        const float*        weights,
+                        std::size_t         taps,
+                        float*              dst,
+                        std::size_t         count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGEKERNELS_SSE2)
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 sum = _mm_setzero_ps();
+        for (std::size_t k = 0; k < taps; ++k)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(rows[k] + i), _mm_set1_ps(weights[k])));
+        _mm_storeu_ps(dst + i, sum);
+    }
+#elif defined(SFML_IMAGEKERNELS_NEON)
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t sum = vdupq_n_f32(0.f);
+        for (std::size_t k = 0; k < taps; ++k)
+            sum = vmlaq_n_f32(sum, vld1q_f32(rows[k] + i), weights[k]);
+        vst1q_f32(dst + i, sum);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        float sum = 0.f;
+        for (std::size_t k = 0; k < taps; ++k)
+            sum += rows[k][i] * weights[k];
+        dst[i] = sum;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void convertPixels(const Uint8* src, PixelFormat srcFormat, Uint8* dst, PixelFormat dstFormat, std::size_t pixelCount)
+{
+    if (srcFormat == dstFormat)
+    {
+        std::memcpy(dst, src, pixelCount * getPixelSize(srcFormat));
+    }
+    else if (srcFormat == RGBA8)
+    {
+        ImageKernelsImpl::convertFromRgba8(src, dst, dstFormat, pixelCount);
+    }
+    else if (dstFormat == RGBA8)
+    {
+        ImageKernelsImpl::convertToRgba8(src, srcFormat, dst, pixelCount);
+    }
+    else
+    {
+        // Go through RGBA8, by chunks small enough to stay in the cache
+        constexpr std::size_t chunkSize = 256;
+        Uint8                 rgba[chunkSize * 4];
+
+        const std::size_t srcPixelSize = getPixelSize(srcFormat);
+        const std::size_t dstPixelSize = getPixelSize(dstFormat);
+
+        for (std::size_t i = 0; i < pixelCount; i += chunkSize)
+        {
+            const std::size_t count = std::min(chunkSize, pixelCount - i);
+            ImageKernelsImpl::convertToRgba8(src + i * srcPixelSize, srcFormat, rgba, count);
+            ImageKernelsImpl::convertFromRgba8(rgba, dst + i * dstPixelSize, dstFormat, count);
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAGEKERNELS_HPP
+#define SFML_IMAGEKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PixelFormat.hpp>
+
+#include <SFML/Config.hpp>
+
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Blend a row of RGBA pixels over another one
+///
+/// Each destination pixel is replaced by the source pixel
+/// composited over it. The results are identical to the
+/// scalar integer formula, whatever the implementation
+/// selected at runtime for the CPU (AVX2, SSE2, NEON or
+/// scalar).
+///
+/// \param dst        Destination pixels
+/// \param src        Source pixels
+/// \param pixelCount Number of pixels to blend
+///
+////////////////////////////////////////////////////////////
+void blendPixels(Uint8* dst, const Uint8* src, std::size_t pixelCount);
+
+////////////////////////////////////////////////////////////
+/// \brief Fill RGBA pixels with a single color
+///
+/// \param pixels     Pixels to fill
+/// \param pixelCount Number of pixels to fill
+/// \param color      Pointer to the 4 components of the color
+///
+////////////////////////////////////////////////////////////
+void fillPixels(Uint8* pixels, std::size_t pixelCount, const Uint8* color);
+
+////////////////////////////////////////////////////////////
+/// \brief Replace the alpha of the RGBA pixels that match a color
+///
+/// \param pixels     Pixels to process
+/// \param pixelCount Number of pixels to process
+/// \param color      Pointer to the 4 components of the color to match
+/// \param alpha      Alpha value to assign to the matching pixels
+///
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t pixelCount, const Uint8* color, Uint8 alpha);
+
+////////////////////////////////////////////////////////////
+/// \brief Reverse the order of a row of RGBA pixels
+///
+/// \param pixels     Pixels to reverse
+/// \param pixelCount Number of pixels in the row
+///
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t pixelCount);
+
+////////////////////////////////////////////////////////////
+/// \brief Exchange two non-overlapping ranges of RGBA pixels
+///
+/// \param first      First range of pixels
+/// \param second     Second range of pixels
+/// \param pixelCount Number of pixels in each range
+///
+////////////////////////////////////////////////////////////
+void swapPixels(Uint8* first, Uint8* second, std::size_t pixelCount);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert RGBA pixels to premultiplied floating point pixels
+///
+/// The color components are multiplied by alpha / 255,
+/// the range of all components stays [0, 255].
+///
+/// \param src        Pixels to convert
+/// \param dst        Destination of the 4 floats of each pixel
+/// \param pixelCount Number of pixels to convert
+///
+////////////////////////////////////////////////////////////
+void premultiplyPixels(const Uint8* src, float* dst, std::size_t pixelCount);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert premultiplied floating point pixels back to RGBA pixels
+///
+/// Components are rounded to the nearest integer and clamped
+/// to [0, 255]. Pixels with a null or negative alpha become
+/// transparent black.
+///
+/// \param src        Premultiplied pixels to convert
+/// \param dst        Destination RGBA pixels
+/// \param pixelCount Number of pixels to convert
+///
+////////////////////////////////////////////////////////////
+void unpremultiplyPixels(const float* src, Uint8* dst, std::size_t pixelCount);
+
+////////////////////////////////////////////////////////////
+/// \brief Resample a row of floating point pixels horizontally
+///
+/// Each destination pixel is the weighted sum of \a taps
+/// consecutive source pixels, starting at the index given
+/// by \a first.
+///
+/// \param src      Source pixels, 4 floats each
+/// \param dst      Destination pixels, 4 floats each
+/// \param dstCount Number of destination pixels
+/// \param first    Index of the first source pixel of each destination pixel
+/// \param weights  Weights of the source pixels, \a taps per destination pixel
+/// \param taps     Number of source pixels contributing to each destination pixel
+///
+////////////////////////////////////////////////////////////
+void resampleHorizontally(const float*       src,
+                          float*             dst,
+                          std::size_t        dstCount,
+                          const std::size_t* first,
+                          const float*       weights,
+                          std::size_t        taps);
+
+////////////////////////////////////////////////////////////
+/// \brief Compute the weighted sum of several rows of floats
+///
+/// \param rows    Rows to combine
+/// \param weights Weight of each row
+/// \param taps    Number of rows to combine
+/// \param dst     Destination row
+/// \param count   Number of floats in each row
+///
+////////////////////////////////////////////////////////////
+void resampleVertically(const float* const* rows,
+                        const float*        weights,
+                        std::size_t         taps,
+                        float*              dst,
+                        std::size_t         count);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert pixels from a format to another
+///
+/// Conversions between two formats other than RGBA8 go
+/// through RGBA8. The source and destination must not overlap.
+///
+/// \param src        Source pixels
+/// \param srcFormat  Format of the source pixels
+/// \param dst        Destination pixels
+/// \param dstFormat  Format of the destination pixels
+/// \param pixelCount Number of pixels to convert
+///
+////////////////////////////////////////////////////////////
+void convertPixels(const Uint8* src, PixelFormat srcFormat, Uint8* dst, PixelFormat dstFormat, std::size_t pixelCount);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEKERNELS_HPP
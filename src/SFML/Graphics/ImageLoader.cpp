@@ -25,7 +25,10 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompressedImage.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/MappedFile.hpp>
+#include <SFML/Graphics/PngEncoder.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Utils.hpp>
@@ -34,9 +37,11 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
 
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <iomanip>
-#include <iterator>
+#include <limits>
 #include <ostream>
 
 
@@ -66,7 +71,89 @@ void bufferFromCallback(void* context, void* data, int size)
 {
     auto* source = static_cast<sf::Uint8*>(data);
     auto* dest   = static_cast<std::vector<sf::Uint8>*>(context);
-    std::copy(source, source + size, std::back_inserter(*dest));
+    dest->insert(dest->end(), source, source + size);
+}
+
+// Caller provided buffer, filled by fixedBufferFromCallback
+struct FixedBuffer
+{
+    sf::Uint8*  data;
+    std::size_t capacity;
+    std::size_t size;
+    bool        overflow;
+};
+
+// stb_image callback for filling a caller provided buffer
+void fixedBufferFromCallback(void* context, void* data, int size)
+{
+    auto* dest = static_cast<FixedBuffer*>(context);
+    if (dest->overflow || (static_cast<std::size_t>(size) > dest->capacity - dest->size))
+    {
+        dest->overflow = true;
+        return;
+    }
+
+    std::memcpy(dest->data + dest->size, data, static_cast<std::size_t>(size));
+    dest->size += static_cast<std::size_t>(size);
+}
+
+// stb_image callback for writing to a file stream
+void fileFromCallback(void* context, void* data, int size)
+{
+    static_cast<std::ofstream*>(context)->write(static_cast<const char*>(data), size);
+}
+
+// Encode pixels in the given format, handing the encoded data to a callback
+bool encodeImage(const std::string&             format,
+                 stbi_write_func*               function,
+                 void*                          context,
+                 const std::vector<sf::Uint8>&  pixels,
+                 const sf::Vector2u&            size,
+                 const sf::Image::SaveSettings& settings)
+{
+    // Make sure the image is not empty
+    if (pixels.empty() || (size.x == 0) || (size.y == 0))
+        return false;
+
+    // Choose function based on format
+    const std::string  specified     = sf::toLower(format);
+    const sf::Vector2i convertedSize = sf::Vector2i(size);
+
+    if (specified == "bmp")
+        return stbi_write_bmp_to_func(function, context, convertedSize.x, convertedSize.y, 4, pixels.data());
+
+    if (specified == "tga")
+        return stbi_write_tga_to_func(function, context, convertedSize.x, convertedSize.y, 4, pixels.data());
+
+    if (specified == "png")
+    {
+        const int level = settings.compressionLevel;
+        return sf::priv::encodePng(function, context, pixels.data(), size, level, settings.pngFilter);
+    }
+
+    if (specified == "jpg" || specified == "jpeg")
+    {
+        const int quality = settings.jpegQuality;
+        return stbi_write_jpg_to_func(function, context, convertedSize.x, convertedSize.y, 4, pixels.data(), quality);
+    }
+
+    return false;
+}
+
+// Block compressed containers (KTX, KTX2, DDS) are not supported by stb_image, their base level is decompressed instead
+bool loadCompressedImage(const void* data, std::size_t dataSize, std::vector<sf::Uint8>& pixels, sf::Vector2u& size)
+{
+    sf::priv::CompressedImage image;
+    if (!sf::priv::parseCompressedImage(data, dataSize, image))
+        return false;
+
+    const sf::priv::CompressedImage::Level& level = image.levels.front();
+
+    size = level.size;
+    pixels.resize(static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * 4);
+    sf::priv::decompressImage(level, image.format, pixels.data());
+
+    return true;
 }
 } // namespace
 
@@ -97,11 +184,43 @@ bool ImageLoader::loadImageFromFile(const std::filesystem::path& filename, std::
     // Clear the array (just in case)
     pixels.clear();
 
-    // Load the image and get a pointer to the pixels in memory
     int            width    = 0;
     int            height   = 0;
     int            channels = 0;
-    unsigned char* ptr      = stbi_load(filename.string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    unsigned char* ptr      = nullptr;
+
+    // Decode straight from a mapping of the file when possible, so that it isn't first copied to an intermediate buffer
+    MappedFile file;
+    if (file.open(filename) && (file.getSize() <= static_cast<std::size_t>(std::numeric_limits<int>::max())))
+    {
+        if (isCompressedImage(file.getData(), file.getSize()))
+        {
+            if (loadCompressedImage(file.getData(), file.getSize(), pixels, size))
+                return true;
+
+            err() << "Failed to load image\n" << formatDebugPathInfo(filename) << std::endl;
+            return false;
+        }
+
+        // Load the image and get a pointer to the pixels in memory
+        const auto fileSize = static_cast<int>(file.getSize());
+        ptr = stbi_load_from_memory(file.getData(), fileSize, &width, &height, &channels, STBI_rgb_alpha);
+    }
+    else
+    {
+        std::vector<Uint8> compressedData;
+        if (readCompressedImageFile(filename, compressedData))
+        {
+            if (loadCompressedImage(compressedData.data(), compressedData.size(), pixels, size))
+                return true;
+
+            err() << "Failed to load image\n" << formatDebugPathInfo(filename) << std::endl;
+            return false;
+        }
+
+        // Load the image and get a pointer to the pixels in memory
+        ptr = stbi_load(filename.string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    }
 
     if (ptr)
     {
@@ -141,6 +260,9 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
         // Clear the array (just in case)
         pixels.clear();
 
+        if (isCompressedImage(data, dataSize))
+            return loadCompressedImage(data, dataSize, pixels, size);
+
         // Load the image and get a pointer to the pixels in memory
         int         width    = 0;
         int         height   = 0;
@@ -188,6 +310,10 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
     // Clear the array (just in case)
     pixels.clear();
 
+    std::vector<Uint8> compressedData;
+    if (readCompressedImageStream(stream, compressedData))
+        return loadCompressedImage(compressedData.data(), compressedData.size(), pixels, size);
+
     // Make sure that the stream's reading position is at the beginning
     if (stream.seek(0) == -1)
     {
@@ -236,7 +362,10 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToFile(const std::filesystem::path& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
+bool ImageLoader::saveImageToFile(const std::filesystem::path& filename,
+                                  const std::vector<Uint8>&    pixels,
+                                  const Vector2u&              size,
+                                  const Image::SaveSettings&   settings)
 {
     // Make sure the image is not empty
     if (!pixels.empty() && (size.x > 0) && (size.y > 0))
@@ -261,14 +390,18 @@ bool ImageLoader::saveImageToFile(const std::filesystem::path& filename, const s
         }
         else if (extension == ".png")
         {
-            // PNG format
-            if (stbi_write_png(filename.string().c_str(), convertedSize.x, convertedSize.y, 4, pixels.data(), 0))
+            // PNG format, with our own encoder which supports the save settings
+            const int     level = settings.compressionLevel;
+            std::ofstream file(filename, std::ios::binary);
+            if (file && encodePng(&fileFromCallback, &file, pixels.data(), size, level, settings.pngFilter) &&
+                file.flush())
                 return true;
         }
         else if (extension == ".jpg" || extension == ".jpeg")
         {
             // JPG format
-            if (stbi_write_jpg(filename.string().c_str(), convertedSize.x, convertedSize.y, 4, pixels.data(), 90))
+            const int quality = settings.jpegQuality;
+            if (stbi_write_jpg(filename.string().c_str(), convertedSize.x, convertedSize.y, 4, pixels.data(), quality))
                 return true;
         }
     }
@@ -278,43 +411,42 @@ bool ImageLoader::saveImageToFile(const std::filesystem::path& filename, const s
 }
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToMemory(const std::string&        format,
-                                    std::vector<sf::Uint8>&   output,
-                                    const std::vector<Uint8>& pixels,
-                                    const Vector2u&           size)
+bool ImageLoader::saveImageToMemory(const std::string&         format,
+                                    std::vector<sf::Uint8>&    output,
+                                    const std::vector<Uint8>&  pixels,
+                                    const Vector2u&            size,
+                                    const Image::SaveSettings& settings)
 {
-    // Make sure the image is not empty
-    if (!pixels.empty() && (size.x > 0) && (size.y > 0))
-    {
-        // Choose function based on format
+    if (encodeImage(format, &bufferFromCallback, &output, pixels, size, settings))
+        return true;
+
+    err() << "Failed to save image with format " << std::quoted(format) << std::endl;
+    return false;
+}
 
-        std::string    specified     = toLower(format);
-        const Vector2i convertedSize = Vector2i(size);
 
-        if (specified == "bmp")
-        {
-            // BMP format
-            if (stbi_write_bmp_to_func(&bufferFromCallback, &output, convertedSize.x, convertedSize.y, 4, pixels.data()))
-                return true;
-        }
-        else if (specified == "tga")
-        {
-            // TGA format
-            if (stbi_write_tga_to_func(&bufferFromCallback, &output, convertedSize.x, convertedSize.y, 4, pixels.data()))
-                return true;
-        }
-        else if (specified == "png")
-        {
-            // PNG format
-            if (stbi_write_png_to_func(&bufferFromCallback, &output, convertedSize.x, convertedSize.y, 4, pixels.data(), 0))
-                return true;
-        }
-        else if (specified == "jpg" || specified == "jpeg")
+////////////////////////////////////////////////////////////
+bool ImageLoader::saveImageToMemory(const std::string&         format,
+                                    void*                      output,
+                                    std::size_t                capacity,
+                                    std::size_t&               outputSize,
+                                    const std::vector<Uint8>&  pixels,
+                                    const Vector2u&            size,
+                                    const Image::SaveSettings& settings)
+{
+    FixedBuffer buffer{static_cast<Uint8*>(output), output ? capacity : 0, 0, false};
+
+    if (encodeImage(format, &fixedBufferFromCallback, &buffer, pixels, size, settings))
+    {
+        if (!buffer.overflow)
         {
-            // JPG format
-            if (stbi_write_jpg_to_func(&bufferFromCallback, &output, convertedSize.x, convertedSize.y, 4, pixels.data(), 90))
-                return true;
+            outputSize = buffer.size;
+            return true;
         }
+
+        err() << "Failed to save image with format " << std::quoted(format) << ", the output buffer of " << capacity
+              << " bytes is too small" << std::endl;
+        return false;
     }
 
     err() << "Failed to save image with format " << std::quoted(format) << std::endl;
@@ -28,6 +28,8 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
+
 #include <SFML/Config.hpp>
 
 #include <SFML/System/Vector2.hpp>
@@ -101,11 +103,15 @@ public:
     /// \param filename Path of image file to save
     /// \param pixels   Array of pixels to save to image
     /// \param size     Size of image to save, in pixels
+    /// \param settings Encoding options
     ///
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToFile(const std::filesystem::path& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
+    bool saveImageToFile(const std::filesystem::path& filename,
+                         const std::vector<Uint8>&    pixels,
+                         const Vector2u&              size,
+                         const Image::SaveSettings&   settings);
 
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an encoded image buffer
@@ -114,14 +120,38 @@ public:
     /// \param output   Buffer to fill with encoded data
     /// \param pixels   Array of pixels to save to image
     /// \param size     Size of image to save, in pixels
+    /// \param settings Encoding options
     ///
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToMemory(const std::string&        format,
-                           std::vector<sf::Uint8>&   output,
-                           const std::vector<Uint8>& pixels,
-                           const Vector2u&           size);
+    bool saveImageToMemory(const std::string&         format,
+                           std::vector<sf::Uint8>&    output,
+                           const std::vector<Uint8>&  pixels,
+                           const Vector2u&            size,
+                           const Image::SaveSettings& settings);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save an array of pixels as an encoded image in a caller provided buffer
+    ///
+    /// \param format     Must be "bmp", "png", "tga" or "jpg"/"jpeg".
+    /// \param output     Buffer to write the encoded data to
+    /// \param capacity   Size of the output buffer, in bytes
+    /// \param outputSize Number of bytes written to the output buffer
+    /// \param pixels     Array of pixels to save to image
+    /// \param size       Size of image to save, in pixels
+    /// \param settings   Encoding options
+    ///
+    /// \return True if saving was successful, false if it failed or the output buffer was too small
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveImageToMemory(const std::string&         format,
+                           void*                      output,
+                           std::size_t                capacity,
+                           std::size_t&               outputSize,
+                           const std::vector<Uint8>&  pixels,
+                           const Vector2u&            size,
+                           const Image::SaveSettings& settings);
 
 private:
     ////////////////////////////////////////////////////////////
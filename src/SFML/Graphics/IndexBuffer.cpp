@@ -28,6 +28,7 @@
 #include <SFML/Graphics/IndexBuffer.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/UploadCounters.hpp>
 #include <SFML/System/Err.hpp>
 #include <mutex>
 #include <utility>
@@ -175,6 +176,8 @@ namespace sf
 
         glCheck(GLEXT_glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
 
+        priv::countBufferUpload(sizeof(GLuint) * static_cast<Uint64>(indexCount));
+
         return true;
     }
 
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/MappedFile.hpp>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+#include <SFML/System/Win32/WindowsHeader.hpp>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <limits>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+MappedFile::MappedFile() : m_data(nullptr), m_size(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFile::open(const std::filesystem::path& filename)
+{
+    close();
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
+    HANDLE file = CreateFileW(filename.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || (fileSize.QuadPart <= 0) ||
+        (static_cast<unsigned long long>(fileSize.QuadPart) > std::numeric_limits<std::size_t>::max()))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    // The view keeps the file and the mapping object alive, their handles can be closed right away
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+        return false;
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data)
+        return false;
+
+    m_data = static_cast<const Uint8*>(data);
+    m_size = static_cast<std::size_t>(fileSize.QuadPart);
+
+#else
+
+    const int file = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file == -1)
+        return false;
+
+    struct stat status;
+    if ((fstat(file, &status) == -1) || !S_ISREG(status.st_mode) || (status.st_size <= 0) ||
+        (static_cast<unsigned long long>(status.st_size) > std::numeric_limits<std::size_t>::max()))
+    {
+        ::close(file);
+        return false;
+    }
+
+    // The mapping keeps the file alive, its descriptor can be closed right away
+    const auto size = static_cast<std::size_t>(status.st_size);
+    void*      data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (data == MAP_FAILED)
+        return false;
+
+    // Image decoders read their input from start to end
+    posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+
+    m_data = static_cast<const Uint8*>(data);
+    m_size = size;
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* MappedFile::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t MappedFile::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+void MappedFile::close()
+{
+    if (!m_data)
+        return;
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    UnmapViewOfFile(m_data);
+#else
+    munmap(const_cast<Uint8*>(m_data), m_size);
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ParallelFor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+// A nested named namespace is used here to allow unity builds of SFML.
+namespace ParallelForImpl
+{
+// Maximum number of threads set by the user, 0 for the hardware concurrency
+std::atomic<unsigned int> maximumThreadCount(0);
+} // namespace ParallelForImpl
+} // namespace
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void parallelFor(std::size_t                                          count,
+                 std::size_t                                          minBlockSize,
+                 const std::function<void(std::size_t, std::size_t)>& function)
+{
+    if (count == 0)
+        return;
+
+    // Use as many blocks as possible, within the limits of the hardware and the minimum block size
+    const unsigned int threadCount = ParallelForImpl::maximumThreadCount;
+    std::size_t        blockCount  = std::max(threadCount > 0 ? threadCount : std::thread::hardware_concurrency(), 1u);
+    blockCount             = std::min(blockCount, count / std::max<std::size_t>(minBlockSize, 1));
+
+    if (blockCount <= 1)
+    {
+        function(0, count);
+        return;
+    }
+
+    const std::size_t blockSize = (count + blockCount - 1) / blockCount;
+
+    std::vector<std::thread> threads;
+    threads.reserve(blockCount - 1);
+
+    std::size_t begin = blockSize;
+    try
+    {
+        for (; begin < count; begin += blockSize)
+            threads.emplace_back(function, begin, std::min(begin + blockSize, count));
+    }
+    catch (const std::exception&)
+    {
+        // Threads couldn't be created: process the remaining blocks on the calling thread
+        for (; begin < count; begin += blockSize)
+            function(begin, std::min(begin + blockSize, count));
+    }
+
+    function(0, blockSize);
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+
+////////////////////////////////////////////////////////////
+void setMaximumThreadCount(unsigned int count)
+{
+    ParallelForImpl::maximumThreadCount = count;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int getMaximumThreadCount()
+{
+    return ParallelForImpl::maximumThreadCount;
+}
+
+} // namespace priv
+
+} // namespace sf
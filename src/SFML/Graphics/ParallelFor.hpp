@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PARALLELFOR_HPP
+#define SFML_PARALLELFOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Process a range of items on several threads
+///
+/// The range [0, count) is split into contiguous blocks of at
+/// least \a minBlockSize items, one per thread at most (see
+/// setMaximumThreadCount).
+/// The first block is processed by the calling thread, which
+/// returns once all the blocks are done. Ranges that don't span
+/// more than one block are processed on the calling thread only.
+///
+/// \a function must not throw, and must be safe to call
+/// concurrently on disjoint blocks.
+///
+/// \param count        Number of items to process
+/// \param minBlockSize Minimum number of items given to a thread
+/// \param function     Function processing the items [begin, end)
+///
+////////////////////////////////////////////////////////////
+void parallelFor(std::size_t                                          count,
+                 std::size_t                                          minBlockSize,
+                 const std::function<void(std::size_t, std::size_t)>& function);
+
+////////////////////////////////////////////////////////////
+/// \brief Limit the number of threads used by parallelFor
+///
+/// \param count Maximum number of threads, including the calling
+///              one; 0 to use one thread per hardware thread
+///
+////////////////////////////////////////////////////////////
+void setMaximumThreadCount(unsigned int count);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the maximum number of threads used by parallelFor
+///
+/// \return Maximum number of threads, 0 if it follows the hardware
+///
+////////////////////////////////////////////////////////////
+unsigned int getMaximumThreadCount();
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PARALLELFOR_HPP
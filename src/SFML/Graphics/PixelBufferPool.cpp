@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/PixelBufferPool.hpp>
+#include <SFML/System/Err.hpp>
+
+#include <iterator>
+#include <ostream>
+
+
+namespace
+{
+// A nested named namespace is used here to allow unity builds of SFML.
+namespace PixelBufferPoolImpl
+{
+std::recursive_mutex isAvailableMutex;
+} // namespace PixelBufferPoolImpl
+} // namespace
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+PixelBufferPool::PixelBufferPool(GLenum target, GLenum usage) : m_target(target), m_usage(usage)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+PixelBufferPool::~PixelBufferPool()
+{
+    if (m_buffers.empty())
+        return;
+
+    TransientContextLock contextLock;
+
+    for (const Buffer& buffer : m_buffers)
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer.name));
+}
+
+
+////////////////////////////////////////////////////////////
+bool PixelBufferPool::isAvailable()
+{
+    std::scoped_lock lock(PixelBufferPoolImpl::isAvailableMutex);
+
+    static bool checked   = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = GLEXT_vertex_buffer_object && GLEXT_pixel_buffer_object && GLEXT_map_buffer_range;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+PixelBufferPool::Buffer PixelBufferPool::acquire(std::size_t size)
+{
+    Buffer buffer{0, 0};
+
+    {
+        std::scoped_lock lock(m_mutex);
+
+        // Prefer a buffer that is large enough, otherwise reallocate the most recently released one
+        for (auto it = m_buffers.rbegin(); it != m_buffers.rend(); ++it)
+        {
+            if (it->capacity >= size)
+            {
+                buffer = *it;
+                m_buffers.erase(std::next(it).base());
+                break;
+            }
+        }
+
+        if (!buffer.name && !m_buffers.empty())
+        {
+            buffer = m_buffers.back();
+            m_buffers.pop_back();
+        }
+    }
+
+    if (!buffer.name)
+    {
+        GLuint name = 0;
+        glCheck(GLEXT_glGenBuffers(1, &name));
+
+        if (!name)
+        {
+            err() << "Could not create pixel buffer, failed to generate buffer" << std::endl;
+            return buffer;
+        }
+
+        buffer.name = name;
+    }
+
+    if (buffer.capacity < size)
+    {
+        glCheck(GLEXT_glBindBuffer(m_target, buffer.name));
+        glCheck(GLEXT_glBufferData(m_target, static_cast<GLsizeiptr>(size), nullptr, m_usage));
+        glCheck(GLEXT_glBindBuffer(m_target, 0));
+
+        buffer.capacity = size;
+    }
+
+    return buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void PixelBufferPool::release(const Buffer& buffer)
+{
+    if (!buffer.name)
+        return;
+
+    {
+        std::scoped_lock lock(m_mutex);
+
+        if (m_buffers.size() < MaxFreeBuffers)
+        {
+            m_buffers.push_back(buffer);
+            return;
+        }
+    }
+
+    glCheck(GLEXT_glDeleteBuffers(1, &buffer.name));
+}
+
+} // namespace priv
+
+} // namespace sf
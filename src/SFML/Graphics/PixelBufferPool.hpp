@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PIXELBUFFERPOOL_HPP
+#define SFML_PIXELBUFFERPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLExtensions.hpp>
+
+#include <SFML/Window/GlResource.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Pool of pixel buffer objects used to transfer
+///        texture data asynchronously
+///
+/// Buffers are handed out with at least the requested storage
+/// and recycled when they are released. Users map them with
+/// GL_MAP_INVALIDATE_BUFFER_BIT, so that the driver provides
+/// fresh storage if the GPU is still reading a previous transfer.
+///
+////////////////////////////////////////////////////////////
+class PixelBufferPool : GlResource
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Buffer of the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Buffer
+    {
+        unsigned int name;     //!< OpenGL buffer object, 0 if invalid
+        std::size_t  capacity; //!< Size of the storage of the buffer, in bytes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// \param target Buffer binding point the buffers are used with
+    /// \param usage  Usage hint of the storage of the buffers
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelBufferPool(GLenum target, GLenum usage);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Deletes the buffers which were released to the pool.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PixelBufferPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelBufferPool(const PixelBufferPool&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelBufferPool& operator=(const PixelBufferPool&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether pixel buffer objects are supported by the system
+    ///
+    /// Mapping the buffers requires ARB_map_buffer_range as well.
+    ///
+    /// \return True if pixel buffer objects can be used
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a buffer of at least the given size
+    ///
+    /// An OpenGL context must be active. The binding of the
+    /// target of the pool is reset to 0.
+    ///
+    /// \param size Required storage, in bytes
+    ///
+    /// \return Buffer, whose name is 0 if it couldn't be created
+    ///
+    ////////////////////////////////////////////////////////////
+    Buffer acquire(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a buffer back to the pool
+    ///
+    /// The buffer must not be mapped anymore. An OpenGL context
+    /// must be active, in case the buffer has to be deleted.
+    ///
+    /// \param buffer Buffer previously returned by acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(const Buffer& buffer);
+
+private:
+    ////////////////////////////////////////////////////////////
+    // Member types
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        MaxFreeBuffers = 4 //!< Number of released buffers kept for reuse
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    GLenum              m_target;  //!< Buffer binding point
+    GLenum              m_usage;   //!< Usage hint of the storage
+    std::mutex          m_mutex;   //!< Protects the free buffers, which may be acquired from several threads
+    std::vector<Buffer> m_buffers; //!< Buffers available for reuse
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PIXELBUFFERPOOL_HPP
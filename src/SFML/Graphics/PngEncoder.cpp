@@ -0,0 +1,654 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ParallelFor.hpp>
+#include <SFML/Graphics/PngEncoder.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+
+namespace
+{
+// A nested named namespace is used here to allow unity builds of SFML.
+namespace PngEncoderImpl
+{
+// Target size of the filtered rows of a segment; segments are filtered and deflated independently, on separate threads
+constexpr std::size_t segmentSize = 512 * 1024;
+
+// Number of bytes per pixel (RGBA8)
+constexpr std::size_t pixelSize = 4;
+
+// Deflate window and match limits (RFC 1951)
+constexpr std::size_t windowSize = 32768;
+constexpr std::size_t minMatch   = 3;
+constexpr std::size_t maxMatch   = 258;
+constexpr std::size_t noPosition = std::numeric_limits<std::size_t>::max();
+
+// Number of bits of the hash of 3 bytes used to find matches
+constexpr unsigned int hashBits = 15;
+
+// Length and distance codes of deflate: base values and number of extra bits
+constexpr sf::Uint16 lengthBase[] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                     31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+
+constexpr sf::Uint8 lengthExtra[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                     2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+constexpr sf::Uint16 distanceBase[] = {1,    2,    3,    4,    5,    7,    9,    13,    17,    25,
+                                       33,   49,   65,   97,   129,  193,  257,  385,   513,   769,
+                                       1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+
+constexpr sf::Uint8 distanceExtra[] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4,  4,  5,  5,  6,
+                                       6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+
+////////////////////////////////////////////////////////////
+sf::Uint32 reverseBits(sf::Uint32 value, unsigned int count)
+{
+    sf::Uint32 result = 0;
+    for (unsigned int i = 0; i < count; ++i, value >>= 1)
+        result = (result << 1) | (value & 1);
+
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+// Code of a literal/length symbol with the fixed Huffman codes, bits reversed so that it can be written LSB first
+struct FixedCode
+{
+    sf::Uint32   bits;
+    unsigned int length;
+};
+
+std::array<FixedCode, 288> makeFixedCodes()
+{
+    std::array<FixedCode, 288> codes;
+    for (sf::Uint32 symbol = 0; symbol < 288; ++symbol)
+    {
+        FixedCode& code = codes[symbol];
+        if (symbol < 144)
+            code = {0x30 + symbol, 8};
+        else if (symbol < 256)
+            code = {0x190 + symbol - 144, 9};
+        else if (symbol < 280)
+            code = {symbol - 256, 7};
+        else
+            code = {0xC0 + symbol - 280, 8};
+
+        code.bits = reverseBits(code.bits, code.length);
+    }
+
+    return codes;
+}
+
+const std::array<FixedCode, 288> fixedCodes = makeFixedCodes();
+
+
+////////////////////////////////////////////////////////////
+std::array<sf::Uint32, 256> makeCrcTable()
+{
+    std::array<sf::Uint32, 256> table;
+    for (sf::Uint32 i = 0; i < 256; ++i)
+    {
+        sf::Uint32 value = i;
+        for (int bit = 0; bit < 8; ++bit)
+            value = (value & 1) ? 0xEDB88320 ^ (value >> 1) : value >> 1;
+
+        table[i] = value;
+    }
+
+    return table;
+}
+
+const std::array<sf::Uint32, 256> crcTable = makeCrcTable();
+
+
+////////////////////////////////////////////////////////////
+// Compute the CRC-32 of some data, as stored at the end of PNG chunks
+sf::Uint32 computeCrc(const sf::Uint8* data, std::size_t size)
+{
+    sf::Uint32 crc = 0xFFFFFFFF;
+    for (std::size_t i = 0; i < size; ++i)
+        crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+
+    return crc ^ 0xFFFFFFFF;
+}
+
+
+////////////////////////////////////////////////////////////
+// Compute the Adler-32 checksum of some data, as stored at the end of zlib streams
+sf::Uint32 computeAdler(const sf::Uint8* data, std::size_t size)
+{
+    sf::Uint32 a = 1;
+    sf::Uint32 b = 0;
+    while (size > 0)
+    {
+        // 5552 is the largest number of bytes that can be summed before b overflows
+        const std::size_t blockSize = std::min<std::size_t>(size, 5552);
+        for (std::size_t i = 0; i < blockSize; ++i)
+        {
+            a += data[i];
+            b += a;
+        }
+
+        a %= 65521;
+        b %= 65521;
+        data += blockSize;
+        size -= blockSize;
+    }
+
+    return (b << 16) | a;
+}
+
+
+////////////////////////////////////////////////////////////
+// Get the Adler-32 checksum of two consecutive blocks of data from their own checksums
+sf::Uint32 combineAdler(sf::Uint32 first, sf::Uint32 second, std::size_t secondSize)
+{
+    constexpr sf::Uint32 base      = 65521;
+    const auto           remainder = static_cast<sf::Uint32>(secondSize % base);
+
+    sf::Uint32 a = first & 0xFFFF;
+    sf::Uint32 b = (remainder * a) % base;
+    a += (second & 0xFFFF) + base - 1;
+    b += (first >> 16) + (second >> 16) + base - remainder;
+
+    if (a >= base)
+        a -= base;
+    if (a >= base)
+        a -= base;
+    if (b >= base * 2)
+        b -= base * 2;
+    if (b >= base)
+        b -= base;
+
+    return (b << 16) | a;
+}
+
+
+////////////////////////////////////////////////////////////
+void writeUint32(std::vector<sf::Uint8>& output, std::size_t offset, sf::Uint32 value)
+{
+    output[offset]     = static_cast<sf::Uint8>(value >> 24);
+    output[offset + 1] = static_cast<sf::Uint8>(value >> 16);
+    output[offset + 2] = static_cast<sf::Uint8>(value >> 8);
+    output[offset + 3] = static_cast<sf::Uint8>(value);
+}
+
+
+////////////////////////////////////////////////////////////
+// Start a PNG chunk, its length and CRC are filled by finishChunk
+void startChunk(std::vector<sf::Uint8>& chunk, const char* type)
+{
+    chunk.insert(chunk.end(), 4, 0);
+    chunk.insert(chunk.end(), type, type + 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void finishChunk(std::vector<sf::Uint8>& chunk)
+{
+    writeUint32(chunk, 0, static_cast<sf::Uint32>(chunk.size() - 8));
+
+    const sf::Uint32 crc = computeCrc(chunk.data() + 4, chunk.size() - 4);
+    chunk.insert(chunk.end(), 4, 0);
+    writeUint32(chunk, chunk.size() - 4, crc);
+}
+
+
+////////////////////////////////////////////////////////////
+// Predictors of the PNG filters
+int paeth(int left, int up, int upLeft)
+{
+    const int estimate       = left + up - upLeft;
+    const int distanceLeft   = std::abs(estimate - left);
+    const int distanceUp     = std::abs(estimate - up);
+    const int distanceUpLeft = std::abs(estimate - upLeft);
+
+    if ((distanceLeft <= distanceUp) && (distanceLeft <= distanceUpLeft))
+        return left;
+
+    return distanceUp <= distanceUpLeft ? up : upLeft;
+}
+
+
+////////////////////////////////////////////////////////////
+// Filter a row of pixels; previous is the unfiltered row above, all zeros for the first row
+void filterRow(sf::Image::PngFilter filter,
+               const sf::Uint8*     row,
+               const sf::Uint8*     previous,
+               std::size_t          rowSize,
+               sf::Uint8*           output)
+{
+    const auto byte = [](int value) { return static_cast<sf::Uint8>(value); };
+
+    // The first pixel has no left neighbor, the predictors use 0 instead
+    switch (filter)
+    {
+        case sf::Image::PngSub:
+            std::copy(row, row + pixelSize, output);
+            for (std::size_t i = pixelSize; i < rowSize; ++i)
+                output[i] = byte(row[i] - row[i - pixelSize]);
+            break;
+
+        case sf::Image::PngUp:
+            for (std::size_t i = 0; i < rowSize; ++i)
+                output[i] = byte(row[i] - previous[i]);
+            break;
+
+        case sf::Image::PngAverage:
+            for (std::size_t i = 0; i < pixelSize; ++i)
+                output[i] = byte(row[i] - previous[i] / 2);
+            for (std::size_t i = pixelSize; i < rowSize; ++i)
+                output[i] = byte(row[i] - (row[i - pixelSize] + previous[i]) / 2);
+            break;
+
+        case sf::Image::PngPaeth:
+            for (std::size_t i = 0; i < pixelSize; ++i)
+                output[i] = byte(row[i] - previous[i]);
+            for (std::size_t i = pixelSize; i < rowSize; ++i)
+                output[i] = byte(row[i] - paeth(row[i - pixelSize], previous[i], previous[i - pixelSize]));
+            break;
+
+        default:
+            std::copy(row, row + rowSize, output);
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+// Filter the rows of a segment, each filtered row starts with the type of its filter
+void filterRows(const sf::Uint8*        pixels,
+                std::size_t             rowSize,
+                std::size_t             firstRow,
+                std::size_t             rowCount,
+                sf::Image::PngFilter    filter,
+                std::vector<sf::Uint8>& output)
+{
+    output.resize(rowCount * (rowSize + 1));
+
+    std::vector<sf::Uint8> candidate(filter == sf::Image::PngAdaptive ? rowSize : 0);
+    std::vector<sf::Uint8> zeros(firstRow == 0 ? rowSize : 0);
+
+    for (std::size_t i = 0; i < rowCount; ++i)
+    {
+        const std::size_t row      = firstRow + i;
+        const sf::Uint8*  current  = pixels + row * rowSize;
+        const sf::Uint8*  previous = row > 0 ? current - rowSize : zeros.data();
+        sf::Uint8*        filtered = output.data() + i * (rowSize + 1);
+
+        if (filter != sf::Image::PngAdaptive)
+        {
+            filtered[0] = static_cast<sf::Uint8>(filter);
+            filterRow(filter, current, previous, rowSize, filtered + 1);
+            continue;
+        }
+
+        // Keep the filter which minimizes the sum of the absolute (signed) differences, like most encoders
+        std::size_t bestScore = std::numeric_limits<std::size_t>::max();
+        for (int type = sf::Image::PngNone; type < sf::Image::PngAdaptive; ++type)
+        {
+            filterRow(static_cast<sf::Image::PngFilter>(type), current, previous, rowSize, candidate.data());
+
+            std::size_t score = 0;
+            for (const sf::Uint8 value : candidate)
+                score += value < 128 ? value : 256u - value;
+
+            if (score < bestScore)
+            {
+                bestScore   = score;
+                filtered[0] = static_cast<sf::Uint8>(type);
+                std::copy(candidate.begin(), candidate.end(), filtered + 1);
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+// Writes bits to a deflate stream, least significant bit first
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<sf::Uint8>& output) : m_output(output), m_bits(0), m_count(0)
+    {
+    }
+
+    void write(sf::Uint32 value, unsigned int count)
+    {
+        m_bits |= value << m_count;
+        m_count += count;
+
+        while (m_count >= 8)
+        {
+            m_output.push_back(static_cast<sf::Uint8>(m_bits));
+            m_bits >>= 8;
+            m_count -= 8;
+        }
+    }
+
+    void writeSymbol(std::size_t symbol)
+    {
+        write(fixedCodes[symbol].bits, fixedCodes[symbol].length);
+    }
+
+    void align()
+    {
+        if (m_count > 0)
+            write(0, 8 - m_count);
+    }
+
+private:
+    std::vector<sf::Uint8>& m_output;
+    sf::Uint32              m_bits;
+    unsigned int            m_count;
+};
+
+
+////////////////////////////////////////////////////////////
+// Write data as stored (uncompressed) deflate blocks
+void writeStored(const sf::Uint8* data, std::size_t size, bool last, std::vector<sf::Uint8>& output, BitWriter& writer)
+{
+    do
+    {
+        const std::size_t blockSize = std::min<std::size_t>(size, 65535);
+        size -= blockSize;
+
+        writer.write((last && (size == 0)) ? 1 : 0, 1);
+        writer.write(0, 2);
+        writer.align();
+
+        const sf::Uint8 header[] = {static_cast<sf::Uint8>(blockSize),
+                                    static_cast<sf::Uint8>(blockSize >> 8),
+                                    static_cast<sf::Uint8>(~blockSize),
+                                    static_cast<sf::Uint8>(~blockSize >> 8)};
+        output.insert(output.end(), header, header + 4);
+        output.insert(output.end(), data, data + blockSize);
+        data += blockSize;
+    } while (size > 0);
+}
+
+
+////////////////////////////////////////////////////////////
+// Write data as a deflate block with the fixed Huffman codes; matches are searched
+// in a hash chain whose length grows with the level, like stb_image_write does
+void writeFixed(const sf::Uint8* data, std::size_t size, int level, bool last, BitWriter& writer)
+{
+    writer.write(last ? 1 : 0, 1);
+    writer.write(1, 2);
+
+    const auto maxChain = static_cast<std::size_t>(level) * 2;
+    const bool lazy     = level >= 5;
+
+    std::vector<std::size_t> head(std::size_t{1} << hashBits, noPosition);
+    std::vector<std::size_t> previous(windowSize, noPosition);
+
+    const auto hash = [data](std::size_t position)
+    {
+        const sf::Uint32 value = (sf::Uint32{data[position]} << 16) | (sf::Uint32{data[position + 1]} << 8) |
+                                 data[position + 2];
+        return (value * 2654435761u) >> (32 - hashBits);
+    };
+
+    const auto insert = [&](std::size_t position)
+    {
+        const sf::Uint32 key            = hash(position);
+        previous[position % windowSize] = head[key];
+        head[key]                       = position;
+    };
+
+    const auto findMatch = [&](std::size_t position, std::size_t& distance)
+    {
+        const std::size_t limit     = std::min(maxMatch, size - position);
+        std::size_t       best      = 0;
+        std::size_t       candidate = head[hash(position)];
+
+        for (std::size_t chain = 0; chain < maxChain; ++chain)
+        {
+            if ((candidate == noPosition) || (position - candidate >= windowSize))
+                break;
+
+            std::size_t length = 0;
+            while ((length < limit) && (data[candidate + length] == data[position + length]))
+                ++length;
+
+            if (length > best)
+            {
+                best     = length;
+                distance = position - candidate;
+                if (length == limit)
+                    break;
+            }
+
+            // The slot of an old position may have been reused by a newer one, chains must go backward
+            const std::size_t next = previous[candidate % windowSize];
+            if ((next == noPosition) || (next >= candidate))
+                break;
+
+            candidate = next;
+        }
+
+        return best >= minMatch ? best : 0;
+    };
+
+    std::size_t position = 0;
+    while (position < size)
+    {
+        std::size_t length   = 0;
+        std::size_t distance = 0;
+
+        if (size - position >= minMatch)
+        {
+            length = findMatch(position, distance);
+            insert(position);
+
+            // Lazy matching: if the next byte starts a longer match, emit this one as a literal
+            if (lazy && (length > 0) && (length < maxMatch) && (size - position > minMatch))
+            {
+                std::size_t nextDistance = 0;
+                if (findMatch(position + 1, nextDistance) > length)
+                    length = 0;
+            }
+        }
+
+        if (length == 0)
+        {
+            writer.writeSymbol(data[position]);
+            ++position;
+            continue;
+        }
+
+        std::size_t code = 0;
+        while ((code + 1 < std::size(lengthBase)) && (lengthBase[code + 1] <= length))
+            ++code;
+
+        writer.writeSymbol(257 + code);
+        writer.write(static_cast<sf::Uint32>(length - lengthBase[code]), lengthExtra[code]);
+
+        code = 0;
+        while ((code + 1 < std::size(distanceBase)) && (distanceBase[code + 1] <= distance))
+            ++code;
+
+        writer.write(reverseBits(static_cast<sf::Uint32>(code), 5), 5);
+        writer.write(static_cast<sf::Uint32>(distance - distanceBase[code]), distanceExtra[code]);
+
+        if (level == 9)
+            for (std::size_t i = 1; (i < length) && (size - (position + i) >= minMatch); ++i)
+                insert(position + i);
+
+        position += length;
+    }
+
+    // End of block
+    writer.writeSymbol(256);
+}
+
+
+////////////////////////////////////////////////////////////
+// Rows of the image encoded as one IDAT chunk
+struct Segment
+{
+    std::size_t            firstRow;     //!< Index of the first row of the segment
+    std::size_t            rowCount;     //!< Number of rows of the segment
+    std::size_t            filteredSize; //!< Size of the filtered rows, in bytes
+    sf::Uint32             adler;        //!< Adler-32 checksum of the filtered rows
+    std::vector<sf::Uint8> chunk;        //!< Encoded chunk
+};
+
+
+////////////////////////////////////////////////////////////
+void encodeSegment(Segment&             segment,
+                   const sf::Uint8*     pixels,
+                   std::size_t          rowSize,
+                   int                  level,
+                   sf::Image::PngFilter filter,
+                   bool                 first,
+                   bool                 last)
+{
+    std::vector<sf::Uint8> filtered;
+    filterRows(pixels, rowSize, segment.firstRow, segment.rowCount, filter, filtered);
+
+    segment.filteredSize = filtered.size();
+    segment.adler        = computeAdler(filtered.data(), filtered.size());
+
+    std::vector<sf::Uint8>& chunk = segment.chunk;
+    chunk.reserve(filtered.size() + filtered.size() / 8 + 64);
+    startChunk(chunk, "IDAT");
+
+    // The zlib header starts the first segment, its compression level field is informative only
+    if (first)
+    {
+        chunk.push_back(0x78);
+        chunk.push_back(level <= 1 ? 0x01 : (level <= 5 ? 0x5E : (level == 6 ? 0x9C : 0xDA)));
+    }
+
+    BitWriter writer(chunk);
+    if (level == 0)
+    {
+        writeStored(filtered.data(), filtered.size(), last, chunk, writer);
+    }
+    else
+    {
+        writeFixed(filtered.data(), filtered.size(), level, last, writer);
+
+        // Segments other than the last end with an empty stored block, so that the next one starts on a byte boundary
+        if (!last)
+            writeStored(nullptr, 0, false, chunk, writer);
+
+        writer.align();
+    }
+
+    // The last chunk is finished once the checksum of the whole stream is known
+    if (!last)
+        finishChunk(chunk);
+}
+
+} // namespace PngEncoderImpl
+} // namespace
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool encodePng(PngWriteFunction function,
+               void*            context,
+               const Uint8*     pixels,
+               const Vector2u&  size,
+               int              level,
+               Image::PngFilter filter)
+{
+    using namespace PngEncoderImpl;
+
+    if (!pixels || (size.x == 0) || (size.y == 0) || (size.x > 0x7FFFFFFF) || (size.y > 0x7FFFFFFF))
+        return false;
+
+    level = std::clamp(level, 0, 9);
+
+    // Split the rows into segments of about the same size
+    const std::size_t rowSize        = std::size_t{size.x} * pixelSize;
+    const std::size_t rowsPerSegment = std::max<std::size_t>(segmentSize / (rowSize + 1), 1);
+    const std::size_t segmentCount   = (size.y + rowsPerSegment - 1) / rowsPerSegment;
+
+    std::vector<Segment> segments(segmentCount);
+    for (std::size_t i = 0; i < segmentCount; ++i)
+    {
+        segments[i].firstRow = i * rowsPerSegment;
+        segments[i].rowCount = std::min(rowsPerSegment, size.y - segments[i].firstRow);
+    }
+
+    parallelFor(segmentCount,
+                1,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                        encodeSegment(segments[i], pixels, rowSize, level, filter, i == 0, i + 1 == segmentCount);
+                });
+
+    // Finish the zlib stream with the checksum of all the segments
+    Uint32 adler = segments.front().adler;
+    for (std::size_t i = 1; i < segmentCount; ++i)
+        adler = combineAdler(adler, segments[i].adler, segments[i].filteredSize);
+
+    std::vector<Uint8>& lastChunk = segments.back().chunk;
+    lastChunk.insert(lastChunk.end(), 4, 0);
+    writeUint32(lastChunk, lastChunk.size() - 4, adler);
+    finishChunk(lastChunk);
+
+    // Header: signature and IHDR chunk (8-bit RGBA, no interlacing)
+    std::vector<Uint8> header = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<Uint8> chunk;
+    startChunk(chunk, "IHDR");
+    chunk.insert(chunk.end(), 8, 0);
+    writeUint32(chunk, 8, size.x);
+    writeUint32(chunk, 12, size.y);
+    chunk.insert(chunk.end(), {8, 6, 0, 0, 0});
+    finishChunk(chunk);
+    header.insert(header.end(), chunk.begin(), chunk.end());
+
+    function(context, header.data(), static_cast<int>(header.size()));
+    for (Segment& segment : segments)
+        function(context, segment.chunk.data(), static_cast<int>(segment.chunk.size()));
+
+    chunk.clear();
+    startChunk(chunk, "IEND");
+    finishChunk(chunk);
+    function(context, chunk.data(), static_cast<int>(chunk.size()));
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PNGENCODER_HPP
+#define SFML_PNGENCODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
+
+#include <SFML/Config.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Callback receiving the encoded data, compatible with stbi_write_func
+///
+////////////////////////////////////////////////////////////
+using PngWriteFunction = void (*)(void* context, void* data, int size);
+
+////////////////////////////////////////////////////////////
+/// \brief Encode RGBA pixels as a PNG file
+///
+/// The rows are split into segments of about the same size,
+/// which are filtered and deflated independently on several
+/// threads, and written as one IDAT chunk each. The output
+/// only depends on the pixels and the settings, not on the
+/// number of threads.
+///
+/// Deflated segments use the fixed Huffman codes, like
+/// stb_image_write; level 0 writes stored (uncompressed)
+/// blocks and higher levels search longer for matches.
+///
+/// \param function Function receiving the encoded data, in order
+/// \param context  User data passed to \a function
+/// \param pixels   Array of size.x * size.y RGBA pixels
+/// \param size     Size of the image, in pixels
+/// \param level    Compression level, clamped to [0, 9]
+/// \param filter   Filter applied to the rows
+///
+/// \return True if encoding was successful
+///
+////////////////////////////////////////////////////////////
+[[nodiscard]] bool encodePng(PngWriteFunction function,
+                             void*            context,
+                             const Uint8*     pixels,
+                             const Vector2u&  size,
+                             int              level,
+                             Image::PngFilter filter);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PNGENCODER_HPP
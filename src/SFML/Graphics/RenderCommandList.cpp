@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderCommandList.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderCommandList::RenderCommandList() = default;
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::clear(const Color& color)
+{
+    Command& command = addCommand(Command::Clear);
+    command.color    = color;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::setView(const View& view)
+{
+    Command& command = addCommand(Command::SetView);
+    command.index    = m_views.size();
+
+    m_views.push_back(view);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::draw(const Drawable& drawable, const RenderStates& states)
+{
+    Command& command = addCommand(Command::DrawDrawable);
+    command.states   = states;
+    command.drawable = &drawable;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::draw(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    Command& command      = addCommand(Command::DrawVertices);
+    command.states        = states;
+    command.index         = m_vertices.size();
+    command.count         = vertexCount;
+    command.primitiveType = type;
+
+    m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::draw(const VertexBuffer& vertexBuffer,
+                             std::size_t         firstVertex,
+                             std::size_t         vertexCount,
+                             const RenderStates& states)
+{
+    Command& command     = addCommand(Command::DrawVertexBuffer);
+    command.states       = states;
+    command.index        = firstVertex;
+    command.count        = vertexCount;
+    command.vertexBuffer = &vertexBuffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::reset()
+{
+    m_commands.clear();
+    m_vertices.clear();
+    m_views.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderCommandList::getCommandCount() const
+{
+    return m_commands.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderCommandList::draw(RenderTarget& target, const RenderStates& states) const
+{
+    for (const Command& command : m_commands)
+    {
+        // Combine the transform of the replay with the recorded one
+        RenderStates statesCopy(command.states);
+        statesCopy.transform = states.transform * command.states.transform;
+
+        switch (command.type)
+        {
+            case Command::Clear:
+                target.clear(command.color);
+                break;
+
+            case Command::SetView:
+                target.setView(m_views[command.index]);
+                break;
+
+            case Command::DrawDrawable:
+                target.draw(*command.drawable, statesCopy);
+                break;
+
+            case Command::DrawVertices:
+                target.draw(&m_vertices[command.index], command.count, command.primitiveType, statesCopy);
+                break;
+
+            case Command::DrawVertexBuffer:
+                target.draw(*command.vertexBuffer, command.index, command.count, statesCopy);
+                break;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+RenderCommandList::Command& RenderCommandList::addCommand(Command::Type type)
+{
+    Command command;
+    command.type          = type;
+    command.index         = 0;
+    command.count         = 0;
+    command.primitiveType = Points;
+    command.drawable      = nullptr;
+    command.vertexBuffer  = nullptr;
+
+    m_commands.push_back(command);
+
+    return m_commands.back();
+}
+
+} // namespace sf
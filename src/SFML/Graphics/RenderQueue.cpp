@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderQueue.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include <algorithm>
+#include <functional>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderQueue::RenderQueue() : m_orderNeedUpdate(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::submit(const Drawable& drawable, const RenderStates& states, int layer, float depth)
+{
+    Submission& submission = addSubmission(states, layer, depth);
+    submission.drawable    = &drawable;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::submit(const Vertex*       vertices,
+                         std::size_t         vertexCount,
+                         PrimitiveType       type,
+                         const RenderStates& states,
+                         int                 layer,
+                         float               depth)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    Submission& submission = addSubmission(states, layer, depth);
+    submission.firstVertex = m_vertices.size();
+    submission.vertexCount = vertexCount;
+    submission.type        = type;
+
+    m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::setSubmissionOrderPreserved(int layer, bool preserved)
+{
+    auto it = std::find(m_orderedLayers.begin(), m_orderedLayers.end(), layer);
+
+    if (preserved && (it == m_orderedLayers.end()))
+        m_orderedLayers.push_back(layer);
+    else if (!preserved && (it != m_orderedLayers.end()))
+        m_orderedLayers.erase(it);
+
+    m_orderNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderQueue::isSubmissionOrderPreserved(int layer) const
+{
+    return std::find(m_orderedLayers.begin(), m_orderedLayers.end(), layer) != m_orderedLayers.end();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::clear()
+{
+    m_submissions.clear();
+    m_vertices.clear();
+    m_blendModes.clear();
+    m_order.clear();
+    m_orderNeedUpdate = false;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderQueue::getSubmissionCount() const
+{
+    return m_submissions.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::draw(RenderTarget& target, const RenderStates& states) const
+{
+    sort();
+
+    for (std::size_t index : m_order)
+    {
+        const Submission& submission = m_submissions[index];
+
+        // Combine the transform of the queue with the submitted one
+        RenderStates statesCopy(submission.states);
+        statesCopy.transform = states.transform * submission.states.transform;
+
+        if (submission.drawable)
+            target.draw(*submission.drawable, statesCopy);
+        else
+            target.draw(&m_vertices[submission.firstVertex], submission.vertexCount, submission.type, statesCopy);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::sort() const
+{
+    if (!m_orderNeedUpdate)
+        return;
+
+    m_order.resize(m_submissions.size());
+    for (std::size_t i = 0; i < m_order.size(); ++i)
+        m_order[i] = i;
+
+    // Look up the layers which keep their submission order once, rather than in every comparison
+    std::vector<bool> preserved(m_submissions.size());
+    for (std::size_t i = 0; i < m_submissions.size(); ++i)
+        preserved[i] = isSubmissionOrderPreserved(m_submissions[i].layer);
+
+    // Pointers are only compared to group identical states together, their actual order doesn't matter
+    std::less<const void*> pointerLess;
+
+    auto compare = [this, &preserved, &pointerLess](std::size_t leftIndex, std::size_t rightIndex)
+    {
+        const Submission& left  = m_submissions[leftIndex];
+        const Submission& right = m_submissions[rightIndex];
+
+        if (left.layer != right.layer)
+            return left.layer < right.layer;
+
+        if (!preserved[leftIndex])
+        {
+            if (left.states.shader != right.states.shader)
+                return pointerLess(left.states.shader, right.states.shader);
+
+            if (left.states.texture != right.states.texture)
+                return pointerLess(left.states.texture, right.states.texture);
+
+            if (left.blendIndex != right.blendIndex)
+                return left.blendIndex < right.blendIndex;
+
+            if (left.depth < right.depth)
+                return true;
+
+            if (right.depth < left.depth)
+                return false;
+        }
+
+        // Identical keys keep their submission order
+        return leftIndex < rightIndex;
+    };
+
+    std::sort(m_order.begin(), m_order.end(), compare);
+
+    m_orderNeedUpdate = false;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderQueue::Submission& RenderQueue::addSubmission(const RenderStates& states, int layer, float depth)
+{
+    Submission submission;
+    submission.drawable    = nullptr;
+    submission.firstVertex = 0;
+    submission.vertexCount = 0;
+    submission.type        = Points;
+    submission.states      = states;
+    submission.layer       = layer;
+    submission.depth       = depth;
+
+    // Blend modes have no natural ordering, sort them by order of first appearance
+    auto blendMode        = std::find(m_blendModes.begin(), m_blendModes.end(), states.blendMode);
+    submission.blendIndex = static_cast<std::size_t>(blendMode - m_blendModes.begin());
+    if (blendMode == m_blendModes.end())
+        m_blendModes.push_back(states.blendMode);
+
+    m_submissions.push_back(submission);
+    m_orderNeedUpdate = true;
+
+    return m_submissions.back();
+}
+
+} // namespace sf
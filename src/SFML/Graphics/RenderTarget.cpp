@@ -27,11 +27,15 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GpuProfiler.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureCache.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/UploadCounters.hpp>
 #include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/VertexStream.hpp>
 #include <SFML/Graphics/IndexBuffer.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Window/Context.hpp>
@@ -40,6 +44,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <mutex>
 #include <ostream>
@@ -143,6 +148,24 @@ sf::Uint32 equationToGlConstant(sf::BlendMode::Equation blendEquation)
 
     return GLEXT_GL_FUNC_ADD;
 }
+
+
+// Get the smallest rectangle that contains both rectangles, empty rectangles are ignored
+sf::IntRect unite(const sf::IntRect& left, const sf::IntRect& right)
+{
+    if ((left.width <= 0) || (left.height <= 0))
+        return right;
+
+    if ((right.width <= 0) || (right.height <= 0))
+        return left;
+
+    const int minX = std::min(left.left, right.left);
+    const int minY = std::min(left.top, right.top);
+    const int maxX = std::max(left.left + left.width, right.left + right.width);
+    const int maxY = std::max(left.top + left.height, right.top + right.height);
+
+    return sf::IntRect({minX, minY}, {maxX - minX, maxY - minY});
+}
 } // namespace RenderTargetImpl
 } // namespace
 
@@ -150,7 +173,7 @@ sf::Uint32 equationToGlConstant(sf::BlendMode::Equation blendEquation)
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-RenderTarget::RenderTarget() : m_defaultView(), m_view(), m_cache(), m_id(0)
+RenderTarget::RenderTarget() : m_defaultView(), m_view(), m_cache(), m_batch(), m_statistics(), m_culling(), m_damage(), m_profiler(), m_vertexStream(), m_id(0)
 {
     m_cache.glStatesSet = false;
 }
@@ -163,11 +186,19 @@ RenderTarget::~RenderTarget() = default;
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
+    flush();
+
+    // The frame starts with the clear, the next draws can be culled with its repaint area
+    updateRepaintArea();
+
     if (RenderTargetImpl::isActive(m_id) || setActive(true))
     {
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(nullptr);
 
+        // Only clear the repaint area
+        applyDamage();
+
         glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
         glCheck(glClear(GL_COLOR_BUFFER_BIT));
     }
@@ -177,8 +208,12 @@ void RenderTarget::clear(const Color& color)
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
-    m_view              = view;
-    m_cache.viewChanged = true;
+    // Pending draws must be rendered with the view that was active when they were issued
+    flush();
+
+    m_view                = view;
+    m_cache.viewChanged   = true;
+    m_culling.areaChanged = true;
 }
 
 
@@ -255,6 +290,44 @@ Vector2i RenderTarget::mapCoordsToPixel(const Vector2f& point, const View& view)
 ////////////////////////////////////////////////////////////
 void RenderTarget::draw(const Drawable& drawable, const RenderStates& states)
 {
+    // The repaint area is only known once the frame has started
+    bool damageCulling = m_damage.enabled && m_damage.frameStarted;
+
+    if (m_culling.enabled || damageCulling)
+    {
+        if (std::optional<FloatRect> bounds = drawable.getCullingBounds())
+        {
+            FloatRect global  = states.transform.transformRect(*bounds);
+            bool      visible = true;
+
+            if (m_culling.enabled)
+            {
+                // The visible area only changes with the view, compute it once per view
+                if (m_culling.areaChanged)
+                {
+                    m_culling.visibleArea = m_view.getInverseTransform().transformRect(FloatRect({-1.f, -1.f}, {2.f, 2.f}));
+                    m_culling.areaChanged = false;
+                }
+
+                // Inclusive test, so that degenerate bounds (horizontal or vertical lines) are not culled
+                const FloatRect& area = m_culling.visibleArea;
+                visible = (global.left <= area.left + area.width) && (global.left + global.width >= area.left) &&
+                          (global.top <= area.top + area.height) && (global.top + global.height >= area.top);
+            }
+
+            if (visible && damageCulling)
+                visible = mapRectToPixels(global).findIntersection(getRepaintArea()).has_value();
+
+            if (!visible)
+            {
+                if (m_statistics.enabled)
+                    ++m_statistics.current.culledDraws;
+
+                return;
+            }
+        }
+    }
+
     drawable.draw(*this, states);
 }
 
@@ -266,11 +339,29 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, Primiti
     if (!vertices || (vertexCount == 0))
         return;
 
+    if (m_batch.enabled)
+        appendToBatch(vertices, vertexCount, type, states);
+    else
+        drawImmediate(vertices, vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawImmediate(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states)
+{
     if (RenderTargetImpl::isActive(m_id) || setActive(true))
     {
         // Check if the vertex count is low enough so that we can pre-transform them
         bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
 
+        if (m_statistics.enabled)
+        {
+            if (useVertexCache)
+                ++m_statistics.current.vertexCacheHits;
+            else
+                ++m_statistics.current.vertexCacheMisses;
+        }
+
         if (useVertexCache)
         {
             // Pre-transform the vertices and store them into the vertex cache
@@ -285,6 +376,19 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, Primiti
 
         setupDraw(useVertexCache, states);
 
+        // Vertices that can't be pre-transformed are streamed through a ring buffer if
+        // possible, client-side arrays would make the driver copy them synchronously
+        std::size_t firstVertex = 0;
+        bool        useStream   = false;
+        if (!useVertexCache)
+        {
+            if (!m_vertexStream && priv::VertexStream::isAvailable())
+                m_vertexStream = std::make_unique<priv::VertexStream>();
+
+            if (m_vertexStream && m_vertexStream->isValid())
+                useStream = m_vertexStream->write(vertices, vertexCount, firstVertex);
+        }
+
         // Check if texture coordinates array is needed, and update client state accordingly
         bool enableTexCoordsArray = (states.texture || states.shader);
         if (!m_cache.enable || (enableTexCoordsArray != m_cache.texCoordsArrayEnabled))
@@ -295,9 +399,19 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, Primiti
                 glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
         }
 
+        if (useStream)
+        {
+            // The vertices are read from the stream buffer, starting at firstVertex
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_vertexStream->getNativeHandle()));
+
+            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+            if (enableTexCoordsArray)
+                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+        }
         // If we switch between non-cache and cache mode or enable texture
         // coordinates we need to set up the pointers to the vertices' components
-        if (!m_cache.enable || !useVertexCache || !m_cache.useVertexCache)
+        else if (!m_cache.enable || !useVertexCache || !m_cache.useVertexCache)
         {
             const char* data = reinterpret_cast<const char*>(vertices);
 
@@ -318,7 +432,11 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, Primiti
             glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
         }
 
-        drawPrimitives(type, 0, vertexCount);
+        drawPrimitives(type, firstVertex, vertexCount);
+
+        if (useStream)
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
         cleanupDraw(states);
 
         // Update the cache
@@ -356,6 +474,9 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
     if (!vertexCount || !vertexBuffer.getNativeHandle())
         return;
 
+    // Keep the drawing order consistent with the batched draws
+    flush();
+
     if (RenderTargetImpl::isActive(m_id) || setActive(true))
     {
         setupDraw(false, states);
@@ -406,6 +527,9 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& ind
     if (!indexCount || !vertexBuffer.getNativeHandle() || !indexBuffer.getNativeHandle())
         return;
 
+    // Keep the drawing order consistent with the batched draws
+    flush();
+
     if (RenderTargetImpl::isActive(m_id) || setActive(true))
     {
         setupDraw(false, states);
@@ -438,6 +562,152 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& ind
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    if (!enabled)
+        flush();
+
+    m_batch.enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_batch.enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flush()
+{
+    if (m_batch.vertices.empty())
+        return;
+
+    // Take the vertices out of the batch first, drawing may reset the GL states which flushes again
+    std::vector<Vertex> vertices;
+    vertices.swap(m_batch.vertices);
+
+    // The vertices are already transformed, render them with an identity transform
+    RenderStates states(m_batch.blendMode, Transform::Identity, m_batch.texture, m_batch.shader);
+    drawImmediate(vertices.data(), vertices.size(), m_batch.type, states);
+
+    // Keep the allocated memory around for the next batch
+    vertices.clear();
+    m_batch.vertices.swap(vertices);
+    ++m_batch.flushCount;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTarget::getBatchFlushCount() const
+{
+    return m_batch.lastFlushCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setStatisticsEnabled(bool enabled)
+{
+    // Start counting from a clean state
+    if (enabled && !m_statistics.enabled)
+        resetStatistics();
+
+    m_statistics.enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isStatisticsEnabled() const
+{
+    return m_statistics.enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderStatistics& RenderTarget::getStatistics() const
+{
+    return m_statistics.last;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::resetStatistics()
+{
+    m_statistics.current            = RenderStatistics();
+    m_statistics.textureUploadStart = priv::getTextureUploadBytes();
+    m_statistics.bufferUploadStart  = priv::getBufferUploadBytes();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setCullingEnabled(bool enabled)
+{
+    m_culling.enabled     = enabled;
+    m_culling.areaChanged = true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isCullingEnabled() const
+{
+    return m_culling.enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setDamageTrackingEnabled(bool enabled)
+{
+    // Pending draws must be clipped with the repaint area that was active when they were issued
+    flush();
+
+    m_damage.scissorChanged = enabled || m_damage.enabled;
+    m_damage.enabled        = enabled;
+    m_damage.frameStarted   = false;
+    m_damage.history.clear();
+
+    // Nothing is known about the current contents of the target, everything must be repainted
+    m_damage.current = IntRect({0, 0}, Vector2i(getSize()));
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isDamageTrackingEnabled() const
+{
+    return m_damage.enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::markDirty(const IntRect& region)
+{
+    if (!m_damage.enabled)
+        return;
+
+    // Only keep the part of the region that is inside the target
+    std::optional<IntRect> clipped = region.findIntersection(IntRect({0, 0}, Vector2i(getSize())));
+    if (!clipped)
+        return;
+
+    m_damage.current        = RenderTargetImpl::unite(m_damage.current, *clipped);
+    m_damage.scissorChanged = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::markDirty(const Drawable& drawable, const RenderStates& states)
+{
+    if (!m_damage.enabled)
+        return;
+
+    if (std::optional<FloatRect> bounds = drawable.getCullingBounds())
+        markDirty(mapRectToPixels(states.transform.transformRect(*bounds)));
+    else
+        markDirty(IntRect({0, 0}, Vector2i(getSize())));
+}
+
+
 ////////////////////////////////////////////////////////////
 bool RenderTarget::isSrgb() const
 {
@@ -490,6 +760,8 @@ bool RenderTarget::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTarget::pushGLStates()
 {
+    flush();
+
     if (RenderTargetImpl::isActive(m_id) || setActive(true))
     {
 #ifdef SFML_DEBUG
@@ -521,6 +793,8 @@ void RenderTarget::pushGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::popGLStates()
 {
+    flush();
+
     if (RenderTargetImpl::isActive(m_id) || setActive(true))
     {
         glCheck(glMatrixMode(GL_PROJECTION));
@@ -534,12 +808,18 @@ void RenderTarget::popGLStates()
         glCheck(glPopAttrib());
 #endif
     }
+
+    // The scissor of the user has been restored, ours must be applied again
+    if (m_damage.enabled)
+        m_damage.scissorChanged = true;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::resetGLStates()
 {
+    flush();
+
     // Check here to make sure a context change does not happen after activate(true)
     bool shaderAvailable       = Shader::isAvailable();
     bool vertexBufferAvailable = VertexBuffer::isAvailable();
@@ -592,6 +872,9 @@ void RenderTarget::resetGLStates()
 
         m_cache.useVertexCache = false;
 
+        if (m_damage.enabled)
+            m_damage.scissorChanged = true;
+
         // Set the default view
         setView(getView());
 
@@ -613,6 +896,63 @@ void RenderTarget::initialize()
     // Generate a unique ID for this RenderTarget to track
     // whether it is active within a specific context
     m_id = RenderTargetImpl::getUniqueId();
+
+    // The contents of the new target are undefined, everything must be repainted
+    m_damage.frameStarted   = false;
+    m_damage.scissorChanged = m_damage.enabled;
+    m_damage.current        = IntRect({0, 0}, Vector2i(getSize()));
+    m_damage.history.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::endFrame()
+{
+    flush();
+
+    m_batch.lastFlushCount = m_batch.flushCount;
+    m_batch.flushCount     = 0;
+
+    if (m_statistics.enabled)
+    {
+        // Uploads are counted globally, keep the part that happened during this frame
+        m_statistics.current.textureUploadBytes = priv::getTextureUploadBytes() - m_statistics.textureUploadStart;
+        m_statistics.current.bufferUploadBytes  = priv::getBufferUploadBytes() - m_statistics.bufferUploadStart;
+
+        m_statistics.last = m_statistics.current;
+        resetStatistics();
+    }
+
+    if (m_profiler && (RenderTargetImpl::isActive(m_id) || setActive(true)))
+        m_profiler->endFrame();
+
+    if (m_damage.enabled)
+    {
+        // Remember the damage of the frame, it is missing from the back buffers that will be reused later
+        m_damage.history.insert(m_damage.history.begin(), m_damage.current);
+        if (m_damage.history.size() > Damage::MaxHistory)
+            m_damage.history.pop_back();
+
+        m_damage.current      = IntRect();
+        m_damage.frameStarted = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<IntRect> RenderTarget::getFrameDamage() const
+{
+    if (!m_damage.enabled || (m_damage.current.width <= 0) || (m_damage.current.height <= 0))
+        return std::nullopt;
+
+    return m_damage.current;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTarget::getBackBufferAge() const
+{
+    return 0;
 }
 
 
@@ -632,6 +972,86 @@ void RenderTarget::applyCurrentView()
     glCheck(glMatrixMode(GL_MODELVIEW));
 
     m_cache.viewChanged = false;
+
+    if (m_statistics.enabled)
+        ++m_statistics.current.viewChanges;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::appendToBatch(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states)
+{
+    // Strips and fans cannot be concatenated, they are converted to their list equivalent
+    PrimitiveType batchType = type;
+    if (type == LineStrip)
+        batchType = Lines;
+    else if ((type == TriangleStrip) || (type == TriangleFan))
+        batchType = Triangles;
+
+    // Start a new batch if the render states differ from the ones of the pending batch
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    if (!m_batch.vertices.empty() &&
+        ((batchType != m_batch.type) || (states.blendMode != m_batch.blendMode) ||
+         (textureId != m_batch.textureId) || (states.shader != m_batch.shader)))
+        flush();
+
+    if (m_batch.vertices.empty())
+    {
+        m_batch.type      = batchType;
+        m_batch.blendMode = states.blendMode;
+        m_batch.texture   = states.texture;
+        m_batch.textureId = textureId;
+        m_batch.shader    = states.shader;
+    }
+
+    auto append = [this, &states](const Vertex& vertex)
+    { m_batch.vertices.emplace_back(states.transform * vertex.position, vertex.color, vertex.texCoords); };
+
+    switch (type)
+    {
+        case Points:
+            for (std::size_t i = 0; i < vertexCount; ++i)
+                append(vertices[i]);
+            break;
+
+        case Lines:
+        case Triangles:
+        {
+            // Incomplete primitives are ignored by OpenGL, they must not leak into the next draw
+            std::size_t primitiveSize = (type == Lines) ? 2 : 3;
+            std::size_t count         = vertexCount - vertexCount % primitiveSize;
+            for (std::size_t i = 0; i < count; ++i)
+                append(vertices[i]);
+            break;
+        }
+
+        case LineStrip:
+            for (std::size_t i = 1; i < vertexCount; ++i)
+            {
+                append(vertices[i - 1]);
+                append(vertices[i]);
+            }
+            break;
+
+        case TriangleStrip:
+            for (std::size_t i = 2; i < vertexCount; ++i)
+            {
+                // Every other triangle of a strip has its winding reversed
+                append(vertices[(i % 2) ? i - 1 : i - 2]);
+                append(vertices[(i % 2) ? i - 2 : i - 1]);
+                append(vertices[i]);
+            }
+            break;
+
+        case TriangleFan:
+            for (std::size_t i = 2; i < vertexCount; ++i)
+            {
+                append(vertices[0]);
+                append(vertices[i - 1]);
+                append(vertices[i]);
+            }
+            break;
+    }
 }
 
 
@@ -685,6 +1105,9 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
     }
 
     m_cache.lastBlendMode = mode;
+
+    if (m_statistics.enabled)
+        ++m_statistics.current.blendModeChanges;
 }
 
 
@@ -706,6 +1129,9 @@ void RenderTarget::applyTexture(const Texture* texture)
     Texture::bind(texture, Texture::Pixels);
 
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+
+    if (m_statistics.enabled)
+        ++m_statistics.current.textureBinds;
 }
 
 
@@ -713,6 +1139,9 @@ void RenderTarget::applyTexture(const Texture* texture)
 void RenderTarget::applyShader(const Shader* shader)
 {
     Shader::bind(shader);
+
+    if (m_statistics.enabled)
+        ++m_statistics.current.shaderBinds;
 }
 
 
@@ -733,6 +1162,9 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
     if (!m_cache.glStatesSet)
         resetGLStates();
 
+    // Clip the draw to the repaint area
+    applyDamage();
+
     if (useVertexCache)
     {
         // Since vertices are transformed, we must use an identity transform to render them
@@ -767,7 +1199,15 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
     {
         Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
         if (textureId != m_cache.lastTextureId)
+        {
             applyTexture(states.texture);
+        }
+        else if (states.texture && states.texture->m_cacheEntry)
+        {
+            // The texture is still bound from the previous draw, but it must be marked
+            // as used so that a texture drawn every frame is not the first one evicted
+            TextureCache::touch(*states.texture->m_cacheEntry);
+        }
     }
 
     // Apply the shader
@@ -785,6 +1225,12 @@ void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t firstVertex, s
 
     // Draw the primitives
     glCheck(glDrawArrays(mode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
+
+    if (m_statistics.enabled)
+    {
+        ++m_statistics.current.drawCalls;
+        m_statistics.current.vertices += vertexCount;
+    }
 }
 
 void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t indexCount)
@@ -796,6 +1242,12 @@ void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t indexCount)
 
     // Draw the primitives
     glCheck(glDrawElements(mode,static_cast<GLsizei>(indexCount),GL_UNSIGNED_INT,nullptr));
+
+    if (m_statistics.enabled)
+    {
+        ++m_statistics.current.drawCalls;
+        m_statistics.current.vertices += indexCount;
+    }
 }
 
 
@@ -815,6 +1267,138 @@ void RenderTarget::cleanupDraw(const RenderStates& states)
     m_cache.enable = true;
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyDamage()
+{
+    // The scissor state is shared by all the targets drawn in the same context (e.g. a window
+    // and its FBO render textures), ours must be set again after switching targets or contexts
+    if (!m_cache.enable && m_damage.enabled)
+        m_damage.scissorChanged = true;
+
+    updateRepaintArea();
+
+    if (m_damage.scissorChanged)
+    {
+        if (m_damage.enabled)
+        {
+            // OpenGL window coordinates start at the bottom-left corner
+            IntRect area   = getRepaintArea();
+            int     bottom = static_cast<int>(getSize().y) - (area.top + area.height);
+
+            glCheck(glEnable(GL_SCISSOR_TEST));
+            glCheck(glScissor(area.left, bottom, area.width, area.height));
+            m_damage.scissorApplied = true;
+        }
+        else if (m_damage.scissorApplied)
+        {
+            // Only undo our own scissor, the scissor test may be used by the application otherwise
+            glCheck(glDisable(GL_SCISSOR_TEST));
+            m_damage.scissorApplied = false;
+        }
+
+        m_damage.scissorChanged = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::updateRepaintArea()
+{
+    if (!m_damage.enabled || m_damage.frameStarted)
+        return;
+
+    // The back buffer misses the damage of the frames presented since its contents were drawn
+    unsigned int age = getBackBufferAge();
+
+    if ((age == 0) || (static_cast<std::size_t>(age - 1) > m_damage.history.size()))
+    {
+        // The contents of the back buffer are unknown, everything must be repainted
+        m_damage.previous = IntRect({0, 0}, Vector2i(getSize()));
+    }
+    else
+    {
+        m_damage.previous = IntRect();
+        for (std::size_t i = 0; i + 1 < age; ++i)
+            m_damage.previous = RenderTargetImpl::unite(m_damage.previous, m_damage.history[i]);
+    }
+
+    m_damage.frameStarted   = true;
+    m_damage.scissorChanged = true;
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect RenderTarget::getRepaintArea() const
+{
+    return RenderTargetImpl::unite(m_damage.current, m_damage.previous);
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect RenderTarget::mapRectToPixels(const FloatRect& rectangle) const
+{
+    // First, transform the rectangle by the view matrix
+    FloatRect normalized = m_view.getTransform().transformRect(rectangle);
+
+    // Then convert to viewport coordinates, clamped so that huge rectangles can be converted to integers
+    FloatRect  viewport = FloatRect(getViewport(m_view));
+    Vector2f   size     = Vector2f(getSize());
+    const auto clamp    = [](float value, float max) { return std::clamp(value, -1.f, max + 1.f); };
+
+    float left   = clamp((normalized.left + 1.f) / 2.f * viewport.width + viewport.left, size.x);
+    float right  = clamp((normalized.left + normalized.width + 1.f) / 2.f * viewport.width + viewport.left, size.x);
+    float top    = clamp((-normalized.top - normalized.height + 1.f) / 2.f * viewport.height + viewport.top, size.y);
+    float bottom = clamp((-normalized.top + 1.f) / 2.f * viewport.height + viewport.top, size.y);
+
+    // Round outwards, with a margin for the pixels touched by line and point rasterization
+    const int minX = static_cast<int>(std::floor(left)) - 1;
+    const int minY = static_cast<int>(std::floor(top)) - 1;
+    const int maxX = static_cast<int>(std::ceil(right)) + 1;
+    const int maxY = static_cast<int>(std::ceil(bottom)) + 1;
+
+    return IntRect({minX, minY}, {maxX - minX, maxY - minY});
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTarget::beginProfileZone(const std::string& name)
+{
+    // Pending draws were issued before the zone began
+    flush();
+
+    if (RenderTargetImpl::isActive(m_id) || setActive(true))
+    {
+        if (!m_profiler)
+            m_profiler = std::make_unique<priv::GpuProfiler>();
+
+        return m_profiler->beginZone(name);
+    }
+
+    // Invalid identifier, ignored when the zone ends
+    return static_cast<std::size_t>(-1);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::endProfileZone(std::size_t zone)
+{
+    // Pending draws were issued inside the zone
+    flush();
+
+    if (m_profiler && (RenderTargetImpl::isActive(m_id) || setActive(true)))
+        m_profiler->endZone(zone);
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<GpuProfileZone::Result>& RenderTarget::getProfileResults() const
+{
+    static const std::vector<GpuProfileZone::Result> noResults;
+
+    return m_profiler ? m_profiler->getResults() : noResults;
+}
+
 } // namespace sf
 
 
@@ -138,6 +138,10 @@ bool RenderTexture::generateMipmap()
 ////////////////////////////////////////////////////////////
 bool RenderTexture::setActive(bool active)
 {
+    // Submit the pending draws while our context is still current
+    if (!active)
+        flush();
+
     // Update RenderTarget tracking
     if (m_impl && m_impl->activate(active))
         return RenderTarget::setActive(active);
@@ -149,6 +153,8 @@ bool RenderTexture::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTexture::display()
 {
+    RenderTarget::endFrame();
+
     // Update the target texture
     if (m_impl && (priv::RenderTextureImplFBO::isAvailable() || setActive(true)))
     {
@@ -179,4 +185,11 @@ const Texture& RenderTexture::getTexture() const
     return m_texture;
 }
 
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getBackBufferAge() const
+{
+    return 1;
+}
+
 } // namespace sf
@@ -79,6 +79,10 @@ bool RenderWindow::isSrgb() const
 ////////////////////////////////////////////////////////////
 bool RenderWindow::setActive(bool active)
 {
+    // Submit the pending draws while our context is still current
+    if (!active)
+        flush();
+
     bool result = Window::setActive(active);
 
     // Update RenderTarget tracking
@@ -98,6 +102,27 @@ bool RenderWindow::setActive(bool active)
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderWindow::display()
+{
+    // The damage of the frame is forgotten at the end of the frame
+    std::optional<IntRect> damage = getFrameDamage();
+
+    RenderTarget::endFrame();
+
+    if (damage)
+    {
+        // The windowing system uses OpenGL window coordinates, which start at the bottom-left corner
+        int bottom = static_cast<int>(getSize().y) - (damage->top + damage->height);
+        Window::displayWithDamage({damage->left, bottom}, {damage->width, damage->height});
+    }
+    else
+    {
+        Window::display();
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderWindow::onCreate()
 {
@@ -118,6 +143,24 @@ void RenderWindow::onResize()
 {
     // Update the current view (recompute the viewport, which is stored in relative coordinates)
     setView(getView());
+
+    // The contents of the resized window must be repainted entirely
+    markDirty(IntRect({0, 0}, Vector2i(getSize())));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::onBeforeRead() const
+{
+    // Like setActive, this is const for the user: the draws only reach OpenGL earlier, what is displayed is unchanged
+    const_cast<RenderWindow&>(*this).flush();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderWindow::getBackBufferAge() const
+{
+    return Window::getBackBufferAge();
 }
 
 } // namespace sf
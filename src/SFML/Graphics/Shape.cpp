@@ -201,6 +201,13 @@ void Shape::update()
 }
 
 
+////////////////////////////////////////////////////////////
+std::optional<FloatRect> Shape::getCullingBounds() const
+{
+    return getGlobalBounds();
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shape::draw(RenderTarget& target, const RenderStates& states) const
 {
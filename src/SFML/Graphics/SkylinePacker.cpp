@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SkylinePacker.hpp>
+
+#include <algorithm>
+#include <limits>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SkylinePacker::SkylinePacker(const Vector2u& size)
+{
+    reset(size);
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::reset(const Vector2u& size)
+{
+    m_size       = size;
+    m_usedHeight = 0;
+    m_skyline.assign(1, {0, 0, size.x});
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<Vector2u> SkylinePacker::find(const Vector2u& size) const
+{
+    unsigned int      y     = 0;
+    const std::size_t index = findSegment(size, y);
+    if (index == m_skyline.size())
+        return std::nullopt;
+
+    return Vector2u(m_skyline[index].x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<Vector2u> SkylinePacker::insert(const Vector2u& size)
+{
+    unsigned int      bestY     = 0;
+    const std::size_t bestIndex = findSegment(size, bestY);
+    if (bestIndex == m_skyline.size())
+        return std::nullopt;
+
+    const Vector2u position(m_skyline[bestIndex].x, bestY);
+
+    // Raise the skyline over the rectangle, and shorten the segments which are now below it
+    m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(bestIndex), {position.x, bestY + size.y, size.x});
+    const unsigned int right = position.x + size.x;
+    for (std::size_t i = bestIndex + 1; (i < m_skyline.size()) && (m_skyline[i].x < right);)
+    {
+        Segment&           segment = m_skyline[i];
+        const unsigned int covered = right - segment.x;
+        if (segment.width <= covered)
+        {
+            m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+        else
+        {
+            segment.x += covered;
+            segment.width -= covered;
+            break;
+        }
+    }
+
+    // Merge the neighbor segments which have the same height
+    for (std::size_t i = 0; i + 1 < m_skyline.size();)
+    {
+        if (m_skyline[i].y == m_skyline[i + 1].y)
+        {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    m_usedHeight = std::max(m_usedHeight, bestY + size.y);
+
+    return position;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2u& SkylinePacker::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SkylinePacker::getUsedHeight() const
+{
+    return m_usedHeight;
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<unsigned int> SkylinePacker::fit(std::size_t index, const Vector2u& size) const
+{
+    if (m_skyline[index].x + size.x > m_size.x)
+        return std::nullopt;
+
+    // The rectangle rests on the highest segment that it spans
+    unsigned int y         = 0;
+    unsigned int widthLeft = size.x;
+    for (std::size_t i = index; widthLeft > 0; ++i)
+    {
+        y = std::max(y, m_skyline[i].y);
+        if (y + size.y > m_size.y)
+            return std::nullopt;
+
+        widthLeft -= std::min(widthLeft, m_skyline[i].width);
+    }
+
+    return y;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SkylinePacker::findSegment(const Vector2u& size, unsigned int& y) const
+{
+    if ((size.x == 0) || (size.y == 0) || (size.x > m_size.x) || (size.y > m_size.y))
+        return m_skyline.size();
+
+    // The leftmost segment wins ties
+    std::size_t bestIndex = m_skyline.size();
+    y                     = std::numeric_limits<unsigned int>::max();
+    for (std::size_t i = 0; i < m_skyline.size(); ++i)
+    {
+        const std::optional<unsigned int> top = fit(i, size);
+        if (top && (*top < y))
+        {
+            bestIndex = i;
+            y         = *top;
+        }
+    }
+
+    return bestIndex;
+}
+
+} // namespace priv
+
+} // namespace sf
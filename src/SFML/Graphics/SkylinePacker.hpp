@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SKYLINEPACKER_HPP
+#define SFML_SKYLINEPACKER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Vector2.hpp>
+
+#include <optional>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Packs rectangles into a fixed size area
+///
+/// Rectangles are stacked from the top of the area. The packer
+/// keeps the skyline formed by the bottom edges of the rectangles
+/// placed so far, and puts each new rectangle where it stays the
+/// closest to the top of the area, the leftmost place on ties
+/// (the bottom-left heuristic, upside down). Holes left under the
+/// skyline are never reclaimed, rectangles are never removed.
+///
+////////////////////////////////////////////////////////////
+class SkylinePacker
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the packer of an area
+    ///
+    /// \param size Size of the area to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SkylinePacker(const Vector2u& size = Vector2u());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Empty the packer and change the size of its area
+    ///
+    /// \param size Size of the area to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset(const Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a place for a rectangle, without reserving it
+    ///
+    /// This lets callers prepare the area before inserting the
+    /// rectangle, the next call to insert with the same size
+    /// returns the same position.
+    ///
+    /// \param size Size of the rectangle to place
+    ///
+    /// \return Position of the top-left corner of the rectangle, or std::nullopt if there is no room left
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::optional<Vector2u> find(const Vector2u& size) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a place for a rectangle and reserve it
+    ///
+    /// \param size Size of the rectangle to place
+    ///
+    /// \return Position of the top-left corner of the rectangle, or std::nullopt if there is no room left
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::optional<Vector2u> insert(const Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the area
+    ///
+    /// \return Size of the area to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] const Vector2u& getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the height of the part of the area in use
+    ///
+    /// \return Bottom edge of the lowest rectangle placed so far
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] unsigned int getUsedHeight() const;
+
+private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Horizontal segment of the skyline
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Segment
+    {
+        unsigned int x;     //!< Left edge of the segment
+        unsigned int y;     //!< Height of the skyline over the segment
+        unsigned int width; //!< Width of the segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a rectangle fits from the left edge of a segment
+    ///
+    /// \param index Index of the segment
+    /// \param size  Size of the rectangle
+    ///
+    /// \return Top edge of the rectangle, if it fits
+    ///
+    ////////////////////////////////////////////////////////////
+    std::optional<unsigned int> fit(std::size_t index, const Vector2u& size) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the segment from which a rectangle stays the closest to the top
+    ///
+    /// \param size Size of the rectangle
+    /// \param y    Filled with the top edge of the rectangle
+    ///
+    /// \return Index of the segment, or the number of segments if the rectangle doesn't fit
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findSegment(const Vector2u& size, unsigned int& y) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u             m_size;       //!< Size of the area
+    unsigned int         m_usedHeight; //!< Bottom edge of the lowest rectangle
+    std::vector<Segment> m_skyline;    //!< Segments of the skyline, from left to right
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SKYLINEPACKER_HPP
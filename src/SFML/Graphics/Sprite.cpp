@@ -132,6 +132,13 @@ FloatRect Sprite::getGlobalBounds() const
 }
 
 
+////////////////////////////////////////////////////////////
+std::optional<FloatRect> Sprite::getCullingBounds() const
+{
+    return getGlobalBounds();
+}
+
+
 ////////////////////////////////////////////////////////////
 void Sprite::draw(RenderTarget& target, const RenderStates& states) const
 {
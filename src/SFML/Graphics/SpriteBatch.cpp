@@ -0,0 +1,352 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+
+
+namespace
+{
+// A nested named namespace is used here to allow unity builds of SFML.
+namespace SpriteBatchImpl
+{
+// Number of vertices used to draw a single instance (two triangles)
+constexpr std::size_t verticesPerInstance = 6;
+} // namespace SpriteBatchImpl
+} // namespace
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpriteBatch::Instance::Instance() : position(), origin(), rotation(), scale(1, 1), textureRect(), color(Color::White)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::Instance::Instance(const Vector2f& thePosition, const IntRect& theTextureRect, const Color& theColor) :
+position(thePosition),
+origin(),
+rotation(),
+scale(1, 1),
+textureRect(theTextureRect),
+color(theColor)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch() :
+m_texture(nullptr),
+m_instances(),
+m_vertices(),
+m_vertexBuffer(),
+m_dirtyBegin(0),
+m_dirtyEnd(0),
+m_bounds(),
+m_boundsNeedUpdate(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch(const Texture& texture) : SpriteBatch()
+{
+    setTexture(texture);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTexture(const Texture& texture)
+{
+    m_texture = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* SpriteBatch::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getInstanceCount() const
+{
+    return m_instances.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::resize(std::size_t instanceCount)
+{
+    std::size_t previousCount = m_instances.size();
+
+    m_instances.resize(instanceCount);
+    m_vertices.resize(instanceCount * SpriteBatchImpl::verticesPerInstance);
+
+    for (std::size_t i = previousCount; i < instanceCount; ++i)
+        updateVertices(i);
+
+    if (instanceCount > previousCount)
+        invalidate(previousCount, instanceCount - previousCount);
+
+    // Removed instances don't need an upload, but they may have defined the bounds
+    m_boundsNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::clear()
+{
+    m_instances.clear();
+    m_vertices.clear();
+    m_dirtyBegin       = 0;
+    m_dirtyEnd         = 0;
+    m_bounds           = FloatRect();
+    m_boundsNeedUpdate = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::append(const Instance& instance)
+{
+    m_instances.push_back(instance);
+    m_vertices.resize(m_instances.size() * SpriteBatchImpl::verticesPerInstance);
+
+    updateVertices(m_instances.size() - 1);
+    invalidate(m_instances.size() - 1, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setInstance(std::size_t index, const Instance& instance)
+{
+    setInstances(index, &instance, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setInstances(std::size_t first, const Instance* instances, std::size_t count)
+{
+    assert(first + count <= m_instances.size());
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        m_instances[first + i] = instances[i];
+        updateVertices(first + i);
+    }
+
+    invalidate(first, count);
+}
+
+
+////////////////////////////////////////////////////////////
+const SpriteBatch::Instance& SpriteBatch::getInstance(std::size_t index) const
+{
+    return m_instances[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Vertex* SpriteBatch::getVertices() const
+{
+    return m_vertices.data();
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect SpriteBatch::getBounds() const
+{
+    // Static batches are culled on every draw, their bounds are only computed again after a modification
+    if (!m_boundsNeedUpdate)
+        return m_bounds;
+
+    m_boundsNeedUpdate = false;
+
+    if (!m_vertices.empty())
+    {
+        float left   = m_vertices[0].position.x;
+        float top    = m_vertices[0].position.y;
+        float right  = m_vertices[0].position.x;
+        float bottom = m_vertices[0].position.y;
+
+        for (std::size_t i = 1; i < m_vertices.size(); ++i)
+        {
+            Vector2f position = m_vertices[i].position;
+
+            left   = std::min(left, position.x);
+            right  = std::max(right, position.x);
+            top    = std::min(top, position.y);
+            bottom = std::max(bottom, position.y);
+        }
+
+        m_bounds = FloatRect({left, top}, {right - left, bottom - top});
+    }
+    else
+    {
+        // Batch is empty
+        m_bounds = FloatRect();
+    }
+
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<FloatRect> SpriteBatch::getCullingBounds() const
+{
+    return getBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(RenderTarget& target, const RenderStates& states) const
+{
+    if (!m_texture || m_vertices.empty())
+        return;
+
+    RenderStates statesCopy(states);
+    statesCopy.texture = m_texture;
+
+    // Draw from graphics memory if possible, fall back to system memory otherwise
+    if (uploadVertices())
+        target.draw(*m_vertexBuffer, 0, m_vertices.size(), statesCopy);
+    else
+        target.draw(m_vertices.data(), m_vertices.size(), Triangles, statesCopy);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::updateVertices(std::size_t index)
+{
+    const Instance& instance = m_instances[index];
+    Vertex*         vertices = &m_vertices[index * SpriteBatchImpl::verticesPerInstance];
+
+    // Same transform as sf::Transformable, computed without the intermediate sf::Transform
+    float angle  = -instance.rotation.asRadians();
+    float cosine = std::cos(angle);
+    float sine   = std::sin(angle);
+    float sxc    = instance.scale.x * cosine;
+    float syc    = instance.scale.y * cosine;
+    float sxs    = instance.scale.x * sine;
+    float sys    = instance.scale.y * sine;
+    float tx     = -instance.origin.x * sxc - instance.origin.y * sys + instance.position.x;
+    float ty     = instance.origin.x * sxs - instance.origin.y * syc + instance.position.y;
+
+    auto width  = static_cast<float>(std::abs(instance.textureRect.width));
+    auto height = static_cast<float>(std::abs(instance.textureRect.height));
+
+    FloatRect textureRect(instance.textureRect);
+    float     left   = textureRect.left;
+    float     right  = left + textureRect.width;
+    float     top    = textureRect.top;
+    float     bottom = top + textureRect.height;
+
+    // Corners of the quad, in the same order as sf::Sprite
+    Vertex corners[4] = {Vertex(Vector2f(tx, ty), instance.color, Vector2f(left, top)),
+                         Vertex(Vector2f(sys * height + tx, syc * height + ty), instance.color, Vector2f(left, bottom)),
+                         Vertex(Vector2f(sxc * width + tx, -sxs * width + ty), instance.color, Vector2f(right, top)),
+                         Vertex(Vector2f(sxc * width + sys * height + tx, -sxs * width + syc * height + ty),
+                                instance.color,
+                                Vector2f(right, bottom))};
+
+    vertices[0] = corners[0];
+    vertices[1] = corners[1];
+    vertices[2] = corners[2];
+    vertices[3] = corners[2];
+    vertices[4] = corners[1];
+    vertices[5] = corners[3];
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::invalidate(std::size_t first, std::size_t count)
+{
+    if (count == 0)
+        return;
+
+    m_boundsNeedUpdate = true;
+
+    if (m_dirtyBegin == m_dirtyEnd)
+    {
+        m_dirtyBegin = first;
+        m_dirtyEnd   = first + count;
+    }
+    else
+    {
+        m_dirtyBegin = std::min(m_dirtyBegin, first);
+        m_dirtyEnd   = std::max(m_dirtyEnd, first + count);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::uploadVertices() const
+{
+    if (!VertexBuffer::isAvailable())
+        return false;
+
+    // The buffer is only created when the batch is first drawn, building a batch doesn't need a context
+    if (!m_vertexBuffer)
+        m_vertexBuffer.emplace(Triangles, VertexBuffer::Stream);
+
+    // Grow the buffer geometrically, and re-upload everything since its previous contents are lost
+    if (m_vertexBuffer->getVertexCount() < m_vertices.size())
+    {
+        if (!m_vertexBuffer->create(m_vertices.capacity()))
+            return false;
+
+        m_dirtyBegin = 0;
+        m_dirtyEnd   = m_instances.size();
+    }
+
+    // Upload the range of instances modified since the last draw
+    m_dirtyEnd = std::min(m_dirtyEnd, m_instances.size());
+    if (m_dirtyBegin < m_dirtyEnd)
+    {
+        std::size_t first = m_dirtyBegin * SpriteBatchImpl::verticesPerInstance;
+        std::size_t count = (m_dirtyEnd - m_dirtyBegin) * SpriteBatchImpl::verticesPerInstance;
+
+        if (!m_vertexBuffer->update(&m_vertices[first], count, static_cast<unsigned int>(first)))
+            return false;
+    }
+
+    m_dirtyBegin = 0;
+    m_dirtyEnd   = 0;
+
+    return true;
+}
+
+} // namespace sf
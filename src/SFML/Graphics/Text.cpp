@@ -27,11 +27,13 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 
 namespace
@@ -59,15 +61,20 @@ void addLine(sf::VertexArray& vertices,
         sf::Vertex(sf::Vector2f(lineLength + outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1)));
 }
 
-// Add a glyph quad to the vertex array
-void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italicShear)
+// Add a glyph quad to the vertex array; the glyph is scaled when it was loaded at another character size,
+// and the quad covers the given padding (in texels) around the glyph
+void addGlyphQuad(sf::VertexArray& vertices,
+                  sf::Vector2f     position,
+                  const sf::Color& color,
+                  const sf::Glyph& glyph,
+                  float            italicShear,
+                  float            scale   = 1.f,
+                  float            padding = 1.f)
 {
-    float padding = 1.0;
-
-    float left   = glyph.bounds.left - padding;
-    float top    = glyph.bounds.top - padding;
-    float right  = glyph.bounds.left + glyph.bounds.width + padding;
-    float bottom = glyph.bounds.top + glyph.bounds.height + padding;
+    float left   = (glyph.bounds.left - padding) * scale;
+    float top    = (glyph.bounds.top - padding) * scale;
+    float right  = (glyph.bounds.left + glyph.bounds.width + padding) * scale;
+    float bottom = (glyph.bounds.top + glyph.bounds.height + padding) * scale;
 
     float u1 = static_cast<float>(glyph.textureRect.left) - padding;
     float v1 = static_cast<float>(glyph.textureRect.top) - padding;
@@ -88,6 +95,63 @@ void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Co
                                color,
                                sf::Vector2f(u2, v2)));
 }
+
+// Group the quads of a vertex array by the font texture they use, and count the vertices of each texture;
+// only the quads which don't use the first texture are listed, as (quad index, texture index) pairs
+void groupByTexture(sf::VertexArray&                                         vertices,
+                    const std::vector<std::pair<std::size_t, unsigned int>>& quadTextures,
+                    std::vector<std::size_t>&                                vertexCounts)
+{
+    vertexCounts.assign(1, vertices.getVertexCount());
+
+    // Most texts only use the first texture, their vertices are already grouped
+    if (quadTextures.empty())
+        return;
+
+    std::vector<unsigned int> textures(vertices.getVertexCount() / 6, 0);
+    for (const auto& [quad, texture] : quadTextures)
+        textures[quad] = texture;
+
+    vertexCounts.assign(*std::max_element(textures.begin(), textures.end()) + 1, 0);
+    for (unsigned int texture : textures)
+        vertexCounts[texture] += 6;
+
+    // Move the quads to the range of their texture, keeping their order within each range
+    std::vector<std::size_t> offsets(vertexCounts.size(), 0);
+    for (std::size_t i = 1; i < offsets.size(); ++i)
+        offsets[i] = offsets[i - 1] + vertexCounts[i - 1];
+
+    sf::VertexArray grouped(sf::Triangles, vertices.getVertexCount());
+    for (std::size_t quad = 0; quad < textures.size(); ++quad)
+    {
+        std::size_t& offset = offsets[textures[quad]];
+        for (std::size_t i = 0; i < 6; ++i)
+            grouped[offset + i] = vertices[quad * 6 + i];
+        offset += 6;
+    }
+
+    vertices = grouped;
+}
+
+// Draw vertices grouped by font texture, with one draw call per texture
+template <typename TextureGetter>
+void drawByTexture(sf::RenderTarget&               target,
+                   sf::RenderStates                states,
+                   const TextureGetter&            getTexture,
+                   const sf::VertexArray&          vertices,
+                   const std::vector<std::size_t>& vertexCounts)
+{
+    std::size_t first = 0;
+    for (std::size_t i = 0; i < vertexCounts.size(); ++i)
+    {
+        if (vertexCounts[i] == 0)
+            continue;
+
+        states.texture = &getTexture(static_cast<unsigned int>(i));
+        target.draw(&vertices[first], vertexCounts[i], sf::Triangles, states);
+        first += vertexCounts[i];
+    }
+}
 } // namespace
 
 
@@ -108,7 +172,8 @@ m_vertices(Triangles),
 m_outlineVertices(Triangles),
 m_bounds(),
 m_geometryNeedUpdate(false),
-m_fontTextureId(0)
+m_fontTextureId(0),
+m_usesDistanceField(false)
 {
 }
 
@@ -128,7 +193,8 @@ m_vertices(Triangles),
 m_outlineVertices(Triangles),
 m_bounds(),
 m_geometryNeedUpdate(true),
-m_fontTextureId(0)
+m_fontTextureId(0),
+m_usesDistanceField(false)
 {
 }
 
@@ -336,9 +402,14 @@ Vector2f Text::findCharacterPos(std::size_t index) const
     if (index > m_string.getSize())
         index = m_string.getSize();
 
+    // Use the same glyphs as the geometry, which may be distance fields loaded at another size
+    const bool         distanceField = m_font->getDistanceFieldShader() != nullptr;
+    const unsigned int glyphSize     = distanceField ? Font::distanceFieldSize : m_characterSize;
+    const float        scale         = static_cast<float>(m_characterSize) / static_cast<float>(glyphSize);
+
     // Precompute the variables needed by the algorithm
     bool  isBold          = m_style & Bold;
-    float whitespaceWidth = m_font->getGlyph(U' ', m_characterSize, isBold).advance;
+    float whitespaceWidth = m_font->getGlyph(U' ', glyphSize, isBold, 0, distanceField).advance * scale;
     float letterSpacing   = (whitespaceWidth / 3.f) * (m_letterSpacingFactor - 1.f);
     whitespaceWidth += letterSpacing;
     float lineSpacing = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
@@ -351,7 +422,7 @@ Vector2f Text::findCharacterPos(std::size_t index) const
         Uint32 curChar = m_string[i];
 
         // Apply the kerning offset
-        position.x += m_font->getKerning(prevChar, curChar, m_characterSize, isBold);
+        position.x += m_font->getKerning(prevChar, curChar, glyphSize, isBold, distanceField) * scale;
         prevChar = curChar;
 
         // Handle special characters
@@ -370,7 +441,7 @@ Vector2f Text::findCharacterPos(std::size_t index) const
         }
 
         // For regular characters, add the advance offset of the glyph
-        position.x += m_font->getGlyph(curChar, m_characterSize, isBold).advance + letterSpacing;
+        position.x += m_font->getGlyph(curChar, glyphSize, isBold, 0, distanceField).advance * scale + letterSpacing;
     }
 
     // Transform the position to global coordinates
@@ -396,6 +467,13 @@ FloatRect Text::getGlobalBounds() const
 }
 
 
+////////////////////////////////////////////////////////////
+std::optional<FloatRect> Text::getCullingBounds() const
+{
+    return getGlobalBounds();
+}
+
+
 ////////////////////////////////////////////////////////////
 void Text::draw(RenderTarget& target, const RenderStates& states) const
 {
@@ -406,13 +484,45 @@ void Text::draw(RenderTarget& target, const RenderStates& states) const
         RenderStates statesCopy(states);
 
         statesCopy.transform *= getTransform();
-        statesCopy.texture = &m_font->getTexture(m_characterSize);
+
+        // Distance field glyphs are drawn with the shader of the font, unless a custom one is given
+        const unsigned int glyphSize  = m_usesDistanceField ? Font::distanceFieldSize : m_characterSize;
+        const auto         getTexture = [this, glyphSize](unsigned int page) -> const Texture&
+        {
+            return m_font->getTexture(glyphSize, page, m_usesDistanceField);
+        };
+
+        Shader* shader = nullptr;
+        if (m_usesDistanceField && !statesCopy.shader)
+        {
+            shader            = m_font->getDistanceFieldShader();
+            statesCopy.shader = shader;
+        }
 
         // Only draw the outline if there is something to draw
         if (m_outlineThickness != 0)
-            target.draw(m_outlineVertices, statesCopy);
+        {
+            // The outline is the same glyphs drawn with their edge moved outwards by the outline thickness.
+            // The draws pending in the batch of the target use the shader too, they must be submitted
+            // before its threshold changes, and the outline itself before the threshold is restored
+            if (shader)
+            {
+                const float scale     = static_cast<float>(m_characterSize) / static_cast<float>(glyphSize);
+                const float threshold = 0.5f - m_outlineThickness / scale / (2.f * Font::distanceFieldSpread);
+                target.flush();
+                shader->setUniform("threshold", std::clamp(threshold, 0.f, 1.f));
+            }
+
+            drawByTexture(target, statesCopy, getTexture, m_outlineVertices, m_outlineVertexCounts);
+
+            if (shader)
+            {
+                target.flush();
+                shader->setUniform("threshold", 0.5f);
+            }
+        }
 
-        target.draw(m_vertices, statesCopy);
+        drawByTexture(target, statesCopy, getTexture, m_vertices, m_vertexCounts);
     }
 }
 
@@ -423,12 +533,19 @@ void Text::ensureGeometryUpdate() const
     if (!m_font)
         return;
 
+    // Distance field glyphs are loaded once at a reference size, and scaled to the character size
+    const bool         distanceField = m_font->getDistanceFieldShader() != nullptr;
+    const unsigned int glyphSize     = distanceField ? Font::distanceFieldSize : m_characterSize;
+    const float        scale         = static_cast<float>(m_characterSize) / static_cast<float>(glyphSize);
+
     // Do nothing, if geometry has not changed and the font texture has not changed
-    if (!m_geometryNeedUpdate && m_font->getTexture(m_characterSize).m_cacheId == m_fontTextureId)
+    const Uint64 fontTextureId = m_font->getTexture(glyphSize, 0, distanceField).m_cacheId;
+    if (!m_geometryNeedUpdate && distanceField == m_usesDistanceField && fontTextureId == m_fontTextureId)
         return;
 
     // Save the current fonts texture id
-    m_fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+    m_fontTextureId     = fontTextureId;
+    m_usesDistanceField = distanceField;
 
     // Mark geometry as updated
     m_geometryNeedUpdate = false;
@@ -436,6 +553,8 @@ void Text::ensureGeometryUpdate() const
     // Clear the previous geometry
     m_vertices.clear();
     m_outlineVertices.clear();
+    m_vertexCounts.assign(1, 0);
+    m_outlineVertexCounts.assign(1, 0);
     m_bounds = FloatRect();
 
     // No text: nothing to draw
@@ -453,17 +572,24 @@ void Text::ensureGeometryUpdate() const
     // Compute the location of the strike through dynamically
     // We use the center point of the lowercase 'x' glyph as the reference
     // We reuse the underline thickness as the thickness of the strike through as well
-    FloatRect xBounds             = m_font->getGlyph(U'x', m_characterSize, isBold).bounds;
-    float     strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
+    FloatRect xBounds             = m_font->getGlyph(U'x', glyphSize, isBold, 0, distanceField).bounds;
+    float     strikeThroughOffset = (xBounds.top + xBounds.height / 2.f) * scale;
 
     // Precompute the variables needed by the algorithm
-    float whitespaceWidth = m_font->getGlyph(U' ', m_characterSize, isBold).advance;
+    float whitespaceWidth = m_font->getGlyph(U' ', glyphSize, isBold, 0, distanceField).advance * scale;
     float letterSpacing   = (whitespaceWidth / 3.f) * (m_letterSpacingFactor - 1.f);
     whitespaceWidth += letterSpacing;
     float lineSpacing = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
     float x           = 0.f;
     auto  y           = static_cast<float>(m_characterSize);
 
+    // Quads of glyphs which are not in the first texture of the font
+    std::vector<std::pair<std::size_t, unsigned int>> quadTextures;
+    std::vector<std::pair<std::size_t, unsigned int>> outlineQuadTextures;
+
+    // Distance field quads cover the whole spread of the distance field, for the outline to fit in them
+    const float quadPadding = distanceField ? static_cast<float>(Font::distanceFieldSpread) : 1.f;
+
     // Create one quad for each character
     auto   minX     = static_cast<float>(m_characterSize);
     auto   minY     = static_cast<float>(m_characterSize);
@@ -479,7 +605,7 @@ void Text::ensureGeometryUpdate() const
             continue;
 
         // Apply the kerning offset
-        x += m_font->getKerning(prevChar, curChar, m_characterSize, isBold);
+        x += m_font->getKerning(prevChar, curChar, glyphSize, isBold, distanceField) * scale;
 
         // If we're using the underlined style and there's a new line, draw a line
         if (isUnderlined && (curChar == U'\n' && prevChar != U'\n'))
@@ -533,15 +659,20 @@ void Text::ensureGeometryUpdate() const
         // Apply the outline
         if (m_outlineThickness != 0)
         {
-            const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, isBold, m_outlineThickness);
+            // Distance field outlines reuse the regular glyphs, drawn with a lower threshold
+            const float  outlineThickness = distanceField ? 0.f : m_outlineThickness;
+            const float  boundsThickness  = distanceField ? m_outlineThickness : 0.f;
+            const Glyph& glyph = m_font->getGlyph(curChar, glyphSize, isBold, outlineThickness, distanceField);
 
-            float left   = glyph.bounds.left;
-            float top    = glyph.bounds.top;
-            float right  = glyph.bounds.left + glyph.bounds.width;
-            float bottom = glyph.bounds.top + glyph.bounds.height;
+            float left   = glyph.bounds.left * scale - boundsThickness;
+            float top    = glyph.bounds.top * scale - boundsThickness;
+            float right  = (glyph.bounds.left + glyph.bounds.width) * scale + boundsThickness;
+            float bottom = (glyph.bounds.top + glyph.bounds.height) * scale + boundsThickness;
 
             // Add the outline glyph to the vertices
-            addGlyphQuad(m_outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italicShear);
+            if (glyph.page != 0)
+                outlineQuadTextures.emplace_back(m_outlineVertices.getVertexCount() / 6, glyph.page);
+            addGlyphQuad(m_outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italicShear, scale, quadPadding);
 
             // Update the current bounds with the outlined glyph bounds
             minX = std::min(minX, x + left - italicShear * bottom);
@@ -551,18 +682,20 @@ void Text::ensureGeometryUpdate() const
         }
 
         // Extract the current glyph's description
-        const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, isBold);
+        const Glyph& glyph = m_font->getGlyph(curChar, glyphSize, isBold, 0, distanceField);
 
         // Add the glyph to the vertices
-        addGlyphQuad(m_vertices, Vector2f(x, y), m_fillColor, glyph, italicShear);
+        if (glyph.page != 0)
+            quadTextures.emplace_back(m_vertices.getVertexCount() / 6, glyph.page);
+        addGlyphQuad(m_vertices, Vector2f(x, y), m_fillColor, glyph, italicShear, scale, quadPadding);
 
         // Update the current bounds with the non outlined glyph bounds
         if (m_outlineThickness == 0)
         {
-            float left   = glyph.bounds.left;
-            float top    = glyph.bounds.top;
-            float right  = glyph.bounds.left + glyph.bounds.width;
-            float bottom = glyph.bounds.top + glyph.bounds.height;
+            float left   = glyph.bounds.left * scale;
+            float top    = glyph.bounds.top * scale;
+            float right  = (glyph.bounds.left + glyph.bounds.width) * scale;
+            float bottom = (glyph.bounds.top + glyph.bounds.height) * scale;
 
             minX = std::min(minX, x + left - italicShear * bottom);
             maxX = std::max(maxX, x + right - italicShear * top);
@@ -571,7 +704,7 @@ void Text::ensureGeometryUpdate() const
         }
 
         // Advance to the next character
-        x += glyph.advance + letterSpacing;
+        x += glyph.advance * scale + letterSpacing;
     }
 
     // If we're using the underlined style, add the last line
@@ -592,6 +725,10 @@ void Text::ensureGeometryUpdate() const
             addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
     }
 
+    // Draw calls are issued per font texture, the quads of each texture must be contiguous
+    groupByTexture(m_vertices, quadTextures, m_vertexCounts);
+    groupByTexture(m_outlineVertices, outlineQuadTextures, m_outlineVertexCounts);
+
     // Update the bounding rectangle
     m_bounds.left   = minX;
     m_bounds.top    = minY;
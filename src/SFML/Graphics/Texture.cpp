@@ -25,19 +25,26 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompressedImage.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <SFML/Graphics/PixelBufferPool.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureCache.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Graphics/UploadCounters.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
 #include <cstring>
 #include <mutex>
 #include <ostream>
+#include <vector>
 
 
 namespace
@@ -58,6 +65,123 @@ sf::Uint64 getUniqueId()
 
     return id++;
 }
+
+// OpenGL description of the pixels of a format
+struct GlPixelFormat
+{
+    GLint  internalFormat; //!< Format of the texture in video memory
+    GLenum format;         //!< Components of the uploaded pixels
+    GLenum type;           //!< Data type of the uploaded pixels
+};
+
+GlPixelFormat getGlPixelFormat(sf::PixelFormat format, bool sRgb)
+{
+    switch (format)
+    {
+        case sf::R8:
+            return {GLEXT_GL_R8, GLEXT_GL_RED, GL_UNSIGNED_BYTE};
+        case sf::RG8:
+            return {GLEXT_GL_RG8, GLEXT_GL_RG, GL_UNSIGNED_BYTE};
+        case sf::RGB565:
+            return {GLEXT_GL_RGB565, GL_RGB, GLEXT_GL_UNSIGNED_SHORT_5_6_5};
+        case sf::RGBA4444:
+            return {GLEXT_GL_RGBA4, GL_RGBA, GLEXT_GL_UNSIGNED_SHORT_4_4_4_4};
+        case sf::RGBA16F:
+            return {GLEXT_GL_RGBA16F, GL_RGBA, GLEXT_GL_HALF_FLOAT};
+        default:
+            return {sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE};
+    }
+}
+
+// Availability of the block compression formats in the OpenGL implementation
+struct CompressedFormatSupport
+{
+    bool s3tc; //!< BC1, BC2 and BC3
+    bool rgtc; //!< BC4 and BC5
+    bool bptc; //!< BC7
+    bool etc1; //!< ETC1
+    bool etc2; //!< ETC2 and EAC
+};
+
+const CompressedFormatSupport& getCompressedFormatSupport()
+{
+    static const CompressedFormatSupport support = []
+    {
+        CompressedFormatSupport result{false, false, false, false, false};
+
+        if (!GLEXT_texture_compression)
+            return result;
+
+        result.s3tc = sf::Context::isExtensionAvailable("GL_EXT_texture_compression_s3tc");
+        result.rgtc = GLEXT_GL_VERSION_3_0 || sf::Context::isExtensionAvailable("GL_ARB_texture_compression_rgtc") ||
+                      sf::Context::isExtensionAvailable("GL_EXT_texture_compression_rgtc");
+        result.bptc = GLEXT_GL_VERSION_4_2 || sf::Context::isExtensionAvailable("GL_ARB_texture_compression_bptc") ||
+                      sf::Context::isExtensionAvailable("GL_EXT_texture_compression_bptc");
+        result.etc2 = GLEXT_GL_VERSION_4_3 || sf::Context::isExtensionAvailable("GL_ARB_ES3_compatibility");
+        result.etc1 = sf::Context::isExtensionAvailable("GL_OES_compressed_ETC1_RGB8_texture");
+
+        return result;
+    }();
+
+    return support;
+}
+
+bool isCompressedFormatAvailable(sf::priv::CompressedFormat format)
+{
+    const CompressedFormatSupport& support = getCompressedFormatSupport();
+
+    switch (format)
+    {
+        case sf::priv::BC1:
+        case sf::priv::BC1A:
+        case sf::priv::BC2:
+        case sf::priv::BC3:
+            return support.s3tc;
+        case sf::priv::BC4:
+        case sf::priv::BC5:
+            return support.rgtc;
+        case sf::priv::BC7:
+            return support.bptc;
+        case sf::priv::ETC1:
+            return support.etc1 || support.etc2;
+        default:
+            return support.etc2;
+    }
+}
+
+// OpenGL internal format of a block compression format
+GLenum getGlCompressedFormat(sf::priv::CompressedFormat format, bool sRgb)
+{
+    switch (format)
+    {
+        case sf::priv::BC1:
+            return sRgb ? GLEXT_GL_COMPRESSED_SRGB_S3TC_DXT1 : GLEXT_GL_COMPRESSED_RGB_S3TC_DXT1;
+        case sf::priv::BC1A:
+            return sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1;
+        case sf::priv::BC2:
+            return sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3;
+        case sf::priv::BC3:
+            return sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5;
+        case sf::priv::BC4:
+            return GLEXT_GL_COMPRESSED_RED_RGTC1;
+        case sf::priv::BC5:
+            return GLEXT_GL_COMPRESSED_RG_RGTC2;
+        case sf::priv::BC7:
+            return sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GLEXT_GL_COMPRESSED_RGBA_BPTC_UNORM;
+        case sf::priv::ETC1:
+            // ETC1 blocks are valid ETC2 blocks, which can also be sampled as sRGB
+            if (!getCompressedFormatSupport().etc2)
+                return GLEXT_GL_ETC1_RGB8;
+            [[fallthrough]];
+        case sf::priv::ETC2RGB:
+            return sRgb ? GLEXT_GL_COMPRESSED_SRGB8_ETC2 : GLEXT_GL_COMPRESSED_RGB8_ETC2;
+        case sf::priv::ETC2RGBA1:
+            return sRgb ? GLEXT_GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2
+                        : GLEXT_GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+        default:
+            return sRgb ? GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC : GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC;
+    }
+}
 } // namespace TextureImpl
 } // namespace
 
@@ -75,7 +199,11 @@ m_isRepeated(false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap(false),
-m_cacheId(TextureImpl::getUniqueId())
+m_cacheId(TextureImpl::getUniqueId()),
+m_format(RGBA8),
+m_isCompressed(false),
+m_compressedSize(0),
+m_cacheEntry(nullptr)
 {
 }
 
@@ -91,11 +219,15 @@ m_isRepeated(copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap(false),
-m_cacheId(TextureImpl::getUniqueId())
+m_cacheId(TextureImpl::getUniqueId()),
+m_format(RGBA8),
+m_isCompressed(false),
+m_compressedSize(0),
+m_cacheEntry(nullptr)
 {
     if (copy.m_texture)
     {
-        if (create(copy.getSize()))
+        if (create(copy.getSize(), copy.m_format))
         {
             update(copy);
         }
@@ -110,6 +242,9 @@ m_cacheId(TextureImpl::getUniqueId())
 ////////////////////////////////////////////////////////////
 Texture::~Texture()
 {
+    if (m_cacheEntry)
+        TextureCache::detach(*m_cacheEntry);
+
     // Destroy the OpenGL texture
     if (m_texture)
     {
@@ -122,7 +257,7 @@ Texture::~Texture()
 
 
 ////////////////////////////////////////////////////////////
-bool Texture::create(const Vector2u& size)
+bool Texture::create(const Vector2u& size, PixelFormat format)
 {
     // Check if texture parameters are valid before creating it
     if ((size.x == 0) || (size.y == 0))
@@ -136,6 +271,13 @@ bool Texture::create(const Vector2u& size)
     // Make sure that extensions are initialized
     priv::ensureExtensionsInit();
 
+    if (!isPixelFormatAvailable(format))
+    {
+        err() << "Failed to create texture, its pixel format is not supported by the OpenGL implementation"
+              << std::endl;
+        return false;
+    }
+
     // Compute the internal texture dimensions depending on NPOT textures support
     Vector2u actualSize(getValidSize(size.x), getValidSize(size.y));
 
@@ -154,6 +296,9 @@ bool Texture::create(const Vector2u& size)
     m_actualSize    = actualSize;
     m_pixelsFlipped = false;
     m_fboAttachment = false;
+    m_format         = format;
+    m_isCompressed   = false;
+    m_compressedSize = 0;
 
     // Create the OpenGL texture if it doesn't exist yet
     if (!m_texture)
@@ -205,15 +350,16 @@ bool Texture::create(const Vector2u& size)
     }
 
     // Initialize the texture
+    const TextureImpl::GlPixelFormat glFormat = TextureImpl::getGlPixelFormat(m_format, m_sRgb);
     glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
     glCheck(glTexImage2D(GL_TEXTURE_2D,
                          0,
-                         (m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA),
+                         glFormat.internalFormat,
                          static_cast<GLsizei>(m_actualSize.x),
                          static_cast<GLsizei>(m_actualSize.y),
                          0,
-                         GL_RGBA,
-                         GL_UNSIGNED_BYTE,
+                         glFormat.format,
+                         glFormat.type,
                          nullptr));
     glCheck(glTexParameteri(GL_TEXTURE_2D,
                             GL_TEXTURE_WRAP_S,
@@ -234,6 +380,10 @@ bool Texture::create(const Vector2u& size)
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromFile(const std::filesystem::path& filename, const IntRect& area)
 {
+    std::vector<Uint8> buffer;
+    if (priv::readCompressedImageFile(filename, buffer))
+        return loadFromCompressedImage(buffer.data(), buffer.size(), area);
+
     Image image;
     return image.loadFromFile(filename) && loadFromImage(image, area);
 }
@@ -242,6 +392,9 @@ bool Texture::loadFromFile(const std::filesystem::path& filename, const IntRect&
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect& area)
 {
+    if (priv::isCompressedImage(data, size))
+        return loadFromCompressedImage(data, size, area);
+
     Image image;
     return image.loadFromMemory(data, size) && loadFromImage(image, area);
 }
@@ -250,6 +403,10 @@ bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect&
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromStream(InputStream& stream, const IntRect& area)
 {
+    std::vector<Uint8> buffer;
+    if (priv::readCompressedImageStream(stream, buffer))
+        return loadFromCompressedImage(buffer.data(), buffer.size(), area);
+
     Image image;
     return image.loadFromStream(stream) && loadFromImage(image, area);
 }
@@ -310,6 +467,8 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
                 pixels += 4 * width;
             }
 
+            priv::countTextureUpload(4 * static_cast<Uint64>(rectangle.width) * static_cast<Uint64>(rectangle.height));
+
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
             m_hasMipmap = false;
 
@@ -334,6 +493,13 @@ Vector2u Texture::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+PixelFormat Texture::getPixelFormat() const
+{
+    return m_format;
+}
+
+
 ////////////////////////////////////////////////////////////
 Image Texture::copyToImage() const
 {
@@ -417,6 +583,71 @@ Image Texture::copyToImage() const
 }
 
 
+////////////////////////////////////////////////////////////
+TextureReadback Texture::copyToImageAsync() const
+{
+    TextureReadback readback;
+
+    // Easy case: empty texture
+    if (!m_texture)
+        return readback;
+
+#ifndef SFML_OPENGL_ES
+
+    if (priv::PixelBufferPool::isAvailable())
+    {
+        TransientContextLock lock;
+
+        if (!m_readbackBuffers)
+            m_readbackBuffers = std::make_shared<priv::PixelBufferPool>(GLEXT_GL_PIXEL_PACK_BUFFER,
+                                                                        GLEXT_GL_STREAM_READ);
+
+        // The whole texture is read, padding and flipping are handled when the pixels are consumed
+        const std::size_t byteSize = static_cast<std::size_t>(m_actualSize.x) *
+                                     static_cast<std::size_t>(m_actualSize.y) * 4;
+        const priv::PixelBufferPool::Buffer buffer = m_readbackBuffers->acquire(byteSize);
+
+        if (buffer.name)
+        {
+            // Make sure that the current texture binding will be preserved
+            priv::TextureSaver save;
+
+            // With a pixel buffer bound, the pixels pointer is an offset in the buffer
+            // and the copy is performed by the GPU, asynchronously
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, buffer.name));
+            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+            if (GLEXT_sync)
+            {
+                GLEXT_GLsync fence = nullptr;
+                glCheck(fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+                readback.m_fence = fence;
+            }
+
+            readback.m_pool          = m_readbackBuffers;
+            readback.m_buffer        = buffer.name;
+            readback.m_capacity      = buffer.capacity;
+            readback.m_size          = m_size;
+            readback.m_actualSize    = m_actualSize;
+            readback.m_pixelsFlipped = m_pixelsFlipped;
+
+            // Make sure that the transfer starts now rather than when the readback is consumed
+            glCheck(glFlush());
+
+            return readback;
+        }
+    }
+
+#endif // SFML_OPENGL_ES
+
+    readback.m_image = copyToImage();
+
+    return readback;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Uint8* pixels)
 {
@@ -427,18 +658,60 @@ void Texture::update(const Uint8* pixels)
 
 ////////////////////////////////////////////////////////////
 void Texture::update(const Uint8* pixels, const Vector2u& size, const Vector2u& dest)
+{
+    update(pixels, RGBA8, size, dest);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const void* pixels, PixelFormat format)
+{
+    // Update the whole texture
+    update(pixels, format, m_size, {0, 0});
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const void* pixels, PixelFormat format, const Vector2u& size, const Vector2u& dest)
 {
     assert(dest.x + size.x <= m_size.x);
     assert(dest.y + size.y <= m_size.y);
 
+    if (m_isCompressed)
+    {
+        err() << "Cannot update a texture stored with block compression" << std::endl;
+        return;
+    }
+
     if (pixels && m_texture)
     {
+        // Pixels of another format are converted to the format of the texture first
+        std::vector<Uint8> convertedPixels;
+        if (format != m_format)
+        {
+            const std::size_t pixelCount = static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y);
+            convertedPixels.resize(pixelCount * getPixelSize(m_format));
+            priv::convertPixels(static_cast<const Uint8*>(pixels), format, convertedPixels.data(), m_format, pixelCount);
+            pixels = convertedPixels.data();
+        }
+
         TransientContextLock lock;
 
         // Make sure that the current texture binding will be preserved
         priv::TextureSaver save;
 
+        // Rows of formats smaller than 4 bytes per pixel are not necessarily aligned on 4 bytes
+        const std::size_t pixelSize        = getPixelSize(m_format);
+        GLint             unpackAlignment  = 4;
+        const bool        alignmentChanged = ((size.x * pixelSize) % 4) != 0;
+        if (alignmentChanged)
+        {
+            glCheck(glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment));
+            glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+        }
+
         // Copy pixels from the given array to the texture
+        const TextureImpl::GlPixelFormat glFormat = TextureImpl::getGlPixelFormat(m_format, m_sRgb);
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
         glCheck(glTexSubImage2D(GL_TEXTURE_2D,
                                 0,
@@ -446,10 +719,15 @@ void Texture::update(const Uint8* pixels, const Vector2u& size, const Vector2u&
                                 static_cast<GLint>(dest.y),
                                 static_cast<GLsizei>(size.x),
                                 static_cast<GLsizei>(size.y),
-                                GL_RGBA,
-                                GL_UNSIGNED_BYTE,
+                                glFormat.format,
+                                glFormat.type,
                                 pixels));
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+        priv::countTextureUpload(pixelSize * static_cast<Uint64>(size.x) * static_cast<Uint64>(size.y));
+
+        if (alignmentChanged)
+            glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment));
+
         m_hasMipmap     = false;
         m_pixelsFlipped = false;
         m_cacheId       = TextureImpl::getUniqueId();
@@ -461,6 +739,60 @@ void Texture::update(const Uint8* pixels, const Vector2u& size, const Vector2u&
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::update(const std::vector<Area>& areas)
+{
+    if (areas.empty() || !m_texture)
+        return;
+
+    // Pixels need to be converted to the format of the texture area by area, let the regular update do it
+    if (m_isCompressed || (m_format != RGBA8))
+    {
+        for (const Area& area : areas)
+            update(area.pixels, area.size, area.dest);
+        return;
+    }
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // Copy the pixels of each area to the texture, RGBA rows are always aligned on 4 bytes
+    const TextureImpl::GlPixelFormat glFormat = TextureImpl::getGlPixelFormat(m_format, m_sRgb);
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+
+    Uint64 bytes = 0;
+    for (const Area& area : areas)
+    {
+        assert(area.dest.x + area.size.x <= m_size.x);
+        assert(area.dest.y + area.size.y <= m_size.y);
+
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D,
+                                0,
+                                static_cast<GLint>(area.dest.x),
+                                static_cast<GLint>(area.dest.y),
+                                static_cast<GLsizei>(area.size.x),
+                                static_cast<GLsizei>(area.size.y),
+                                glFormat.format,
+                                glFormat.type,
+                                area.pixels));
+        bytes += 4 * static_cast<Uint64>(area.size.x) * static_cast<Uint64>(area.size.y);
+    }
+
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    priv::countTextureUpload(bytes);
+
+    m_hasMipmap     = false;
+    m_pixelsFlipped = false;
+    m_cacheId       = TextureImpl::getUniqueId();
+
+    // Force an OpenGL flush, so that the texture data will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Texture& texture)
 {
@@ -478,6 +810,12 @@ void Texture::update(const Texture& texture, const Vector2u& dest)
     if (!m_texture || !texture.m_texture)
         return;
 
+    if (m_isCompressed)
+    {
+        err() << "Cannot copy to a texture stored with block compression" << std::endl;
+        return;
+    }
+
 #ifndef SFML_OPENGL_ES
 
     {
@@ -487,7 +825,8 @@ void Texture::update(const Texture& texture, const Vector2u& dest)
         priv::ensureExtensionsInit();
     }
 
-    if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit)
+    // Compressed textures can't be attached to a frame buffer, their pixels are read back instead
+    if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit && !texture.m_isCompressed)
     {
         TransientContextLock lock;
 
@@ -608,6 +947,15 @@ void Texture::update(const Window& window, const Vector2u& dest)
     assert(dest.x + window.getSize().x <= m_size.x);
     assert(dest.y + window.getSize().y <= m_size.y);
 
+    if (m_isCompressed)
+    {
+        err() << "Cannot update a texture stored with block compression" << std::endl;
+        return;
+    }
+
+    // Let the window submit the rendering it deferred (e.g. the batch of a render window), so that the copy contains it
+    window.onBeforeRead();
+
     if (m_texture && window.setActive(true))
     {
         TransientContextLock lock;
@@ -637,6 +985,173 @@ void Texture::update(const Window& window, const Vector2u& dest)
 }
 
 
+////////////////////////////////////////////////////////////
+TextureUpload Texture::prepareUpdate(const Vector2u& size, const Vector2u& dest)
+{
+    assert(dest.x + size.x <= m_size.x);
+    assert(dest.y + size.y <= m_size.y);
+
+    TextureUpload upload;
+
+    if (!m_texture || m_isCompressed)
+    {
+        err() << "Cannot prepare texture update, the texture is empty or stored with block compression" << std::endl;
+        return upload;
+    }
+
+    upload.m_texture     = this;
+    upload.m_size        = size;
+    upload.m_destination = dest;
+    upload.m_format      = m_format;
+
+    const std::size_t byteSize = static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) *
+                                 getPixelSize(m_format);
+
+    if (priv::PixelBufferPool::isAvailable())
+    {
+        TransientContextLock lock;
+
+        if (!m_uploadBuffers)
+            m_uploadBuffers = std::make_shared<priv::PixelBufferPool>(GLEXT_GL_PIXEL_UNPACK_BUFFER,
+                                                                      GLEXT_GL_STREAM_DRAW);
+
+        const priv::PixelBufferPool::Buffer buffer = m_uploadBuffers->acquire(byteSize);
+
+        if (buffer.name)
+        {
+            // Invalidating the buffer lets the driver provide fresh storage if a previous transfer still reads it
+            void* mapping = nullptr;
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, buffer.name));
+            glCheck(mapping = GLEXT_glMapBufferRange(GLEXT_GL_PIXEL_UNPACK_BUFFER,
+                                                     0,
+                                                     static_cast<GLsizeiptr>(byteSize),
+                                                     GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_INVALIDATE_BUFFER_BIT));
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+            if (mapping)
+            {
+                upload.m_pool     = m_uploadBuffers;
+                upload.m_buffer   = buffer.name;
+                upload.m_capacity = buffer.capacity;
+                upload.m_pixels   = static_cast<Uint8*>(mapping);
+            }
+            else
+            {
+                m_uploadBuffers->release(buffer);
+            }
+        }
+    }
+
+    // Stage the pixels in system memory if pixel buffers can't be used
+    if (!upload.m_pixels)
+    {
+        upload.m_systemPixels.resize(byteSize);
+        upload.m_pixels = upload.m_systemPixels.data();
+    }
+
+    return upload;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::update(TextureUpload& upload)
+{
+    if ((upload.m_texture != this) || upload.m_submitted || (upload.m_format != m_format) || m_isCompressed)
+    {
+        err() << "Cannot update texture, the upload was not prepared for it or was already submitted" << std::endl;
+        return false;
+    }
+
+    assert(upload.m_destination.x + upload.m_size.x <= m_size.x);
+    assert(upload.m_destination.y + upload.m_size.y <= m_size.y);
+
+    upload.m_submitted = true;
+
+    // Without pixel buffers the pixels are copied from system memory right away
+    if (!upload.m_buffer)
+    {
+        update(upload.m_systemPixels.data(), upload.m_format, upload.m_size, upload.m_destination);
+        upload.m_pixels = nullptr;
+        upload.m_systemPixels.clear();
+        upload.m_systemPixels.shrink_to_fit();
+        return true;
+    }
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    const priv::PixelBufferPool::Buffer buffer{upload.m_buffer, upload.m_capacity};
+    upload.m_buffer = 0;
+    upload.m_pixels = nullptr;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, buffer.name));
+
+    GLboolean unmapped = GL_FALSE;
+    glCheck(unmapped = GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+
+    // The contents of the buffer may have been lost, e.g. on a display mode change
+    if (unmapped == GL_FALSE)
+    {
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+        upload.m_pool->release(buffer);
+        err() << "Cannot update texture, the contents of the upload were lost" << std::endl;
+        return false;
+    }
+
+    // Rows of formats smaller than 4 bytes per pixel are not necessarily aligned on 4 bytes
+    const std::size_t pixelSize        = getPixelSize(m_format);
+    GLint             unpackAlignment  = 4;
+    const bool        alignmentChanged = ((upload.m_size.x * pixelSize) % 4) != 0;
+    if (alignmentChanged)
+    {
+        glCheck(glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment));
+        glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    }
+
+    // With a pixel buffer bound, the pixels pointer is an offset in the buffer
+    // and the copy is performed by the GPU, asynchronously
+    const TextureImpl::GlPixelFormat glFormat = TextureImpl::getGlPixelFormat(m_format, m_sRgb);
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    glCheck(glTexSubImage2D(GL_TEXTURE_2D,
+                            0,
+                            static_cast<GLint>(upload.m_destination.x),
+                            static_cast<GLint>(upload.m_destination.y),
+                            static_cast<GLsizei>(upload.m_size.x),
+                            static_cast<GLsizei>(upload.m_size.y),
+                            glFormat.format,
+                            glFormat.type,
+                            nullptr));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    priv::countTextureUpload(pixelSize * static_cast<Uint64>(upload.m_size.x) * static_cast<Uint64>(upload.m_size.y));
+
+    if (alignmentChanged)
+        glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment));
+
+    // The buffer can be reused right away, mapping it again orphans the storage still being read
+    upload.m_pool->release(buffer);
+
+    if (GLEXT_sync)
+    {
+        GLEXT_GLsync fence = nullptr;
+        glCheck(fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        upload.m_fence = fence;
+    }
+
+    m_hasMipmap     = false;
+    m_pixelsFlipped = false;
+    m_cacheId       = TextureImpl::getUniqueId();
+
+    // Force an OpenGL flush, so that the transfer starts and the texture data
+    // will appear updated in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::setSmooth(bool smooth)
 {
@@ -744,7 +1259,8 @@ bool Texture::isRepeated() const
 ////////////////////////////////////////////////////////////
 bool Texture::generateMipmap()
 {
-    if (!m_texture)
+    // Compressed textures keep the mipmaps of their file
+    if (!m_texture || m_isCompressed)
         return false;
 
     TransientContextLock lock;
@@ -770,6 +1286,120 @@ bool Texture::generateMipmap()
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 Texture::getMemoryUsage() const
+{
+    if (!m_texture)
+        return 0;
+
+    // Compressed textures know the size of the levels they uploaded
+    if (m_isCompressed)
+        return m_compressedSize;
+
+    // Each mipmap level halves the size of the previous one, down to 1x1
+    Vector2u levelSize = m_actualSize;
+    Uint64   pixels    = static_cast<Uint64>(levelSize.x) * static_cast<Uint64>(levelSize.y);
+    while (m_hasMipmap && ((levelSize.x > 1) || (levelSize.y > 1)))
+    {
+        levelSize.x = std::max(levelSize.x / 2, 1u);
+        levelSize.y = std::max(levelSize.y / 2, 1u);
+        pixels += static_cast<Uint64>(levelSize.x) * static_cast<Uint64>(levelSize.y);
+    }
+
+    return pixels * getPixelSize(m_format);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedImage(const void* data, std::size_t size, const IntRect& area)
+{
+    priv::CompressedImage compressed;
+    if (!priv::parseCompressedImage(data, size, compressed))
+    {
+        err() << "Failed to load compressed texture" << std::endl;
+        return false;
+    }
+
+    const priv::CompressedImage::Level& base = compressed.levels.front();
+
+    bool uploadBlocks;
+    {
+        TransientContextLock lock;
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        // Blocks can't be cropped nor padded to a power of two size, such textures are decompressed
+        const bool fullArea = (area.width == 0) || (area.height == 0) ||
+                              ((area.left <= 0) && (area.top <= 0) && (area.width >= static_cast<int>(base.size.x)) &&
+                               (area.height >= static_cast<int>(base.size.y)));
+        uploadBlocks = fullArea && TextureImpl::isCompressedFormatAvailable(compressed.format) &&
+                       (getValidSize(base.size.x) == base.size.x) && (getValidSize(base.size.y) == base.size.y);
+    }
+
+    if (!uploadBlocks)
+    {
+        std::vector<Uint8> pixels(static_cast<std::size_t>(base.size.x) * static_cast<std::size_t>(base.size.y) * 4);
+        priv::decompressImage(base, compressed.format, pixels.data());
+
+        Image image;
+        image.create(base.size, pixels.data());
+        return loadFromImage(image, area);
+    }
+
+    if (!create(base.size))
+        return false;
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // The mipmaps of the file are only used if the whole chain down to 1x1 is there
+    unsigned int fullChainLength = 1;
+    for (unsigned int levelSize = std::max(base.size.x, base.size.y); levelSize > 1; levelSize /= 2)
+        ++fullChainLength;
+    const std::size_t levelCount = (compressed.levels.size() >= fullChainLength) ? fullChainLength : 1;
+
+    // Replace the uncompressed storage allocated by create() with the compressed blocks
+    const GLenum internalFormat = TextureImpl::getGlCompressedFormat(compressed.format, m_sRgb);
+    Uint64       uploadedBytes  = 0;
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    for (std::size_t i = 0; i < levelCount; ++i)
+    {
+        const priv::CompressedImage::Level& level = compressed.levels[i];
+        glCheck(GLEXT_glCompressedTexImage2D(GL_TEXTURE_2D,
+                                             static_cast<GLint>(i),
+                                             internalFormat,
+                                             static_cast<GLsizei>(level.size.x),
+                                             static_cast<GLsizei>(level.size.y),
+                                             0,
+                                             static_cast<GLsizei>(level.dataSize),
+                                             level.data));
+        uploadedBytes += level.dataSize;
+    }
+    priv::countTextureUpload(uploadedBytes);
+
+    if (levelCount > 1)
+    {
+        glCheck(glTexParameteri(GL_TEXTURE_2D,
+                                GL_TEXTURE_MIN_FILTER,
+                                m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+        m_hasMipmap = true;
+    }
+
+    m_isCompressed   = true;
+    m_compressedSize = uploadedBytes;
+    m_cacheId        = TextureImpl::getUniqueId();
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::invalidateMipmap()
 {
@@ -788,9 +1418,41 @@ void Texture::invalidateMipmap()
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::evict()
+{
+    if (!m_texture)
+        return;
+
+    {
+        TransientContextLock lock;
+
+        GLuint texture = m_texture;
+        glCheck(glDeleteTextures(1, &texture));
+    }
+
+    // The pixel buffers are only released once the pending transfers are finished
+    m_uploadBuffers.reset();
+    m_readbackBuffers.reset();
+
+    m_texture        = 0;
+    m_pixelsFlipped  = false;
+    m_hasMipmap      = false;
+    m_isCompressed   = false;
+    m_compressedSize = 0;
+
+    // Render targets must not skip binding the texture, so that it gets restored
+    m_cacheId = TextureImpl::getUniqueId();
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::bind(const Texture* texture, CoordinateType coordinateType)
 {
+    // Textures of a cache are marked as used, and restored if they were evicted
+    if (texture && texture->m_cacheEntry)
+        TextureCache::touch(*texture->m_cacheEntry);
+
     TransientContextLock lock;
 
     if (texture && texture->m_texture)
@@ -867,6 +1529,41 @@ unsigned int Texture::getMaximumSize()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::isPixelFormatAvailable(PixelFormat format)
+{
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    switch (format)
+    {
+        case R8:
+        case RG8:
+        {
+            static const bool textureRg = GLEXT_texture_rg || Context::isExtensionAvailable("GL_ARB_texture_rg");
+            return textureRg;
+        }
+        case RGB565:
+        case RGBA4444:
+        {
+            static const bool packedPixels = GLEXT_packed_pixels;
+            return packedPixels;
+        }
+        case RGBA16F:
+        {
+            static const bool textureHalfFloat = GLEXT_texture_half_float ||
+                                                 (Context::isExtensionAvailable("GL_ARB_texture_float") &&
+                                                  Context::isExtensionAvailable("GL_ARB_half_float_pixel"));
+            return textureHalfFloat;
+        }
+        default:
+            return true;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 Texture& Texture::operator=(const Texture& right)
 {
@@ -890,6 +1587,18 @@ void Texture::swap(Texture& right)
     std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
     std::swap(m_fboAttachment, right.m_fboAttachment);
     std::swap(m_hasMipmap, right.m_hasMipmap);
+    std::swap(m_format, right.m_format);
+    std::swap(m_isCompressed, right.m_isCompressed);
+    std::swap(m_compressedSize, right.m_compressedSize);
+    std::swap(m_uploadBuffers, right.m_uploadBuffers);
+    std::swap(m_readbackBuffers, right.m_readbackBuffers);
+    std::swap(m_cacheEntry, right.m_cacheEntry);
+
+    // Cache entries follow the contents they describe
+    if (m_cacheEntry)
+        TextureCache::retarget(*m_cacheEntry, *this);
+    if (right.m_cacheEntry)
+        TextureCache::retarget(*right.m_cacheEntry, right);
 
     m_cacheId       = TextureImpl::getUniqueId();
     right.m_cacheId = TextureImpl::getUniqueId();
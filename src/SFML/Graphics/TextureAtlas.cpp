@@ -0,0 +1,256 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/SkylinePacker.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureAtlas.hpp>
+
+#include <SFML/System/Err.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <deque>
+#include <ostream>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+struct TextureAtlasImpl
+{
+    ////////////////////////////////////////////////////////////
+    // Texture and free space of a page
+    ////////////////////////////////////////////////////////////
+    struct Page
+    {
+        Texture       texture; //!< Pixels of the page, only as tall as its used part
+        SkylinePacker packer;  //!< Free space of the page
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Make the texture of a page at least as tall as the given height
+    ////////////////////////////////////////////////////////////
+    bool grow(Page& page, unsigned int height) const
+    {
+        const Vector2u size = page.texture.getSize();
+        if (height <= size.y)
+            return true;
+
+        // Pages start 128 pixels tall and double their height when they grow
+        unsigned int newHeight = std::max(size.y, 128u);
+        while (newHeight < height)
+            newHeight *= 2;
+        newHeight = std::min(newHeight, page.packer.getSize().y);
+
+        Texture newTexture;
+        if (!newTexture.create({page.packer.getSize().x, newHeight}))
+        {
+            err() << "Failed to create texture atlas page" << std::endl;
+            return false;
+        }
+
+        newTexture.setSmooth(smooth);
+        if (size.y > 0)
+            newTexture.update(page.texture);
+        page.texture.swap(newTexture);
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Copy an image surrounded by its extrusion and padding to the cell buffer
+    ////////////////////////////////////////////////////////////
+    void fillCell(const Image& image, const Vector2u& cellSize)
+    {
+        const Vector2u    imageSize = image.getSize();
+        const Uint8*      pixels    = image.getPixelsPtr();
+        const std::size_t pitch     = static_cast<std::size_t>(cellSize.x) * 4;
+
+        cell.assign(pitch * cellSize.y, 0);
+
+        for (unsigned int y = 0; y < imageSize.y + 2 * extrusion; ++y)
+        {
+            // Rows of the extrusion repeat the first and last rows of the image
+            const unsigned int sourceY = std::clamp(y, extrusion, extrusion + imageSize.y - 1) - extrusion;
+            const Uint8*       source  = pixels + static_cast<std::size_t>(sourceY) * imageSize.x * 4;
+            Uint8*             dest    = cell.data() + (padding + y) * pitch + padding * 4;
+
+            for (unsigned int i = 0; i < extrusion; ++i)
+            {
+                std::memcpy(dest + i * 4, source, 4);
+                std::memcpy(dest + (extrusion + imageSize.x + i) * 4, source + (imageSize.x - 1) * 4, 4);
+            }
+            std::memcpy(dest + extrusion * 4, source, static_cast<std::size_t>(imageSize.x) * 4);
+        }
+    }
+
+    unsigned int       pageSize;  //!< Width and maximum height of the pages
+    unsigned int       padding;   //!< Transparent border around the images
+    unsigned int       extrusion; //!< Repetitions of the edge pixels around the images
+    bool               smooth;    //!< Smooth filter of the pages
+    std::deque<Page>   pages;     //!< Pages, whose addresses never change
+    std::vector<Uint8> cell;      //!< Pixels of the image being added, with its border
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas(unsigned int pageSize, unsigned int padding, unsigned int extrusion) :
+m_impl(std::make_unique<priv::TextureAtlasImpl>())
+{
+    m_impl->pageSize  = pageSize;
+    m_impl->padding   = padding;
+    m_impl->extrusion = extrusion;
+    m_impl->smooth    = false;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::~TextureAtlas() = default;
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas(TextureAtlas&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas& TextureAtlas::operator=(TextureAtlas&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+std::optional<TextureAtlas::Region> TextureAtlas::add(const Image& image)
+{
+    // A moved-from atlas is used again with the default settings
+    if (!m_impl)
+        *this = TextureAtlas();
+
+    const Vector2u imageSize = image.getSize();
+    if ((imageSize.x == 0) || (imageSize.y == 0))
+    {
+        err() << "Failed to add image to texture atlas, the image is empty" << std::endl;
+        return std::nullopt;
+    }
+
+    const unsigned int border   = m_impl->padding + m_impl->extrusion;
+    const Vector2u     cellSize = imageSize + Vector2u(2 * border, 2 * border);
+    const unsigned int pageSize = std::min(m_impl->pageSize, Texture::getMaximumSize());
+    if ((cellSize.x > pageSize) || (cellSize.y > pageSize))
+    {
+        err() << "Failed to add image to texture atlas, the image is larger than a page "
+              << "(" << imageSize.x << "x" << imageSize.y << ", page size is " << pageSize << ")" << std::endl;
+        return std::nullopt;
+    }
+
+    // The existing pages are tried first, a new one is started when none has room left
+    std::optional<Vector2u> position;
+    std::size_t             index = 0;
+    for (; index < m_impl->pages.size(); ++index)
+    {
+        position = m_impl->pages[index].packer.find(cellSize);
+        if (position)
+            break;
+    }
+
+    const bool newPage = !position;
+    if (newPage)
+    {
+        m_impl->pages.emplace_back();
+        m_impl->pages.back().packer.reset({pageSize, pageSize});
+        position = m_impl->pages.back().packer.find(cellSize);
+        assert(position);
+    }
+
+    // The space of the image is only reserved once the page is large enough, so that nothing is left behind on failure
+    priv::TextureAtlasImpl::Page& page = m_impl->pages[index];
+    if (!m_impl->grow(page, position->y + cellSize.y))
+    {
+        if (newPage)
+            m_impl->pages.pop_back();
+
+        return std::nullopt;
+    }
+
+    [[maybe_unused]] const std::optional<Vector2u> inserted = page.packer.insert(cellSize);
+    assert(inserted == position);
+
+    // Only the cell of the image is uploaded, the rest of the page is left untouched
+    m_impl->fillCell(image, cellSize);
+    page.texture.update(m_impl->cell.data(), cellSize, *position);
+
+    return Region{&page.texture, IntRect(Vector2i(*position + Vector2u(border, border)), Vector2i(imageSize)), index};
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setSmooth(bool smooth)
+{
+    if (!m_impl)
+        *this = TextureAtlas();
+
+    m_impl->smooth = smooth;
+
+    for (priv::TextureAtlasImpl::Page& page : m_impl->pages)
+        page.texture.setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::isSmooth() const
+{
+    return m_impl && m_impl->smooth;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getPageCount() const
+{
+    return m_impl ? m_impl->pages.size() : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getPage(std::size_t index) const
+{
+    assert(m_impl && (index < m_impl->pages.size()));
+    return m_impl->pages[index].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::clear()
+{
+    if (m_impl)
+        m_impl->pages.clear();
+}
+
+} // namespace sf
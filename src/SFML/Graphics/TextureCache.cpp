@@ -0,0 +1,375 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureCache.hpp>
+
+#include <SFML/System/Err.hpp>
+
+#include <list>
+#include <ostream>
+#include <utility>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+struct TextureCacheEntry
+{
+    TextureCacheImpl*                      cache;       //!< Cache which the texture belongs to
+    Texture*                               texture;     //!< Texture described by the entry
+    TextureCache::ReloadFunction           reload;      //!< Reloads the evicted texture, empty to keep a copy instead
+    Image                                  image;       //!< Copy of the pixels of the evicted texture
+    PixelFormat                            format;      //!< Format of the evicted texture
+    bool                                   hadMipmap;   //!< Did the evicted texture have a mipmap?
+    bool                                   resident;    //!< Is the texture in video memory?
+    Uint64                                 memoryUsage; //!< Video memory accounted for the texture, in bytes
+    std::list<TextureCacheEntry>::iterator position;    //!< Position of the entry in the cache
+};
+
+
+////////////////////////////////////////////////////////////
+struct TextureCacheImpl
+{
+    ////////////////////////////////////////////////////////////
+    // Add a texture as the most recently used one
+    ////////////////////////////////////////////////////////////
+    void add(Texture& texture, TextureCache::ReloadFunction reload)
+    {
+        entries.push_front({this, &texture, std::move(reload), Image(), texture.m_format, false, true, 0, {}});
+
+        TextureCacheEntry& entry = entries.front();
+        entry.position           = entries.begin();
+        texture.m_cacheEntry     = &entry;
+
+        updateUsage(entry);
+        enforceBudget(&entry);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Remove a texture without restoring it
+    ////////////////////////////////////////////////////////////
+    void erase(TextureCacheEntry& entry)
+    {
+        memoryUsage -= entry.memoryUsage;
+        entry.texture->m_cacheEntry = nullptr;
+        entries.erase(entry.position);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Remove a texture, restoring it first if it is evicted
+    ////////////////////////////////////////////////////////////
+    void remove(TextureCacheEntry& entry)
+    {
+        if (!entry.resident)
+            restore(entry);
+
+        erase(entry);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Mark a texture as the most recently used one, restoring it if needed,
+    // returns false if it couldn't be restored and was removed from the cache
+    ////////////////////////////////////////////////////////////
+    bool touch(TextureCacheEntry& entry)
+    {
+        if (!entry.resident && !restore(entry))
+        {
+            erase(entry);
+            return false;
+        }
+
+        entries.splice(entries.begin(), entries, entry.position);
+
+        // The texture may have been recreated or got a mipmap since it was last used
+        updateUsage(entry);
+        enforceBudget(&entry);
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void updateUsage(TextureCacheEntry& entry)
+    {
+        const Uint64 usage = entry.texture->getMemoryUsage();
+        memoryUsage        = memoryUsage - entry.memoryUsage + usage;
+        entry.memoryUsage  = usage;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Evict the least recently used textures until the budget is met
+    ////////////////////////////////////////////////////////////
+    void enforceBudget(const TextureCacheEntry* keep)
+    {
+        if (budget == 0)
+            return;
+
+        for (auto it = entries.end(); (memoryUsage > budget) && (it != entries.begin());)
+        {
+            --it;
+            if (&*it != keep)
+                evict(*it);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void evict(TextureCacheEntry& entry)
+    {
+        Texture& texture = *entry.texture;
+
+        // Render textures are attached to a framebuffer, and compressed or
+        // floating point textures can't be copied without loss to an image
+        if (!entry.resident || !texture.m_texture || texture.m_fboAttachment)
+            return;
+        if (!entry.reload && (texture.m_isCompressed || (texture.m_format == RGBA16F)))
+            return;
+
+        if (!entry.reload)
+        {
+            entry.image = texture.copyToImage();
+            if (entry.image.getSize() != texture.getSize())
+            {
+                entry.image = Image();
+                return;
+            }
+        }
+
+        entry.format    = texture.m_format;
+        entry.hadMipmap = texture.m_hasMipmap;
+        entry.resident  = false;
+        texture.evict();
+
+        memoryUsage -= entry.memoryUsage;
+        entry.memoryUsage = 0;
+        ++evictionCount;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool restore(TextureCacheEntry& entry)
+    {
+        Texture& texture = *entry.texture;
+
+        // The texture may have been created again by the application in the meantime
+        if (!texture.m_texture)
+        {
+            bool success = false;
+            if (entry.reload)
+            {
+                success = entry.reload(texture);
+            }
+            else if (texture.create(entry.image.getSize(), entry.format))
+            {
+                texture.update(entry.image);
+                success = true;
+            }
+
+            if (!success)
+            {
+                err() << "Failed to restore a texture evicted from its cache" << std::endl;
+                return false;
+            }
+
+            if (entry.hadMipmap && !texture.m_hasMipmap && !texture.generateMipmap())
+                err() << "Failed to generate the mipmap of a texture restored from its cache" << std::endl;
+        }
+
+        entry.image    = Image();
+        entry.resident = true;
+
+        return true;
+    }
+
+    Uint64                       budget{0};        //!< Maximum video memory of the textures, 0 for no limit
+    Uint64                       memoryUsage{0};   //!< Video memory used by the resident textures
+    Uint64                       evictionCount{0}; //!< Number of evictions so far
+    std::list<TextureCacheEntry> entries;          //!< Textures, most recently used first
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+TextureCache::TextureCache() : m_impl(std::make_unique<priv::TextureCacheImpl>())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureCache::TextureCache(Uint64 budget) : m_impl(std::make_unique<priv::TextureCacheImpl>())
+{
+    m_impl->budget = budget;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureCache::~TextureCache()
+{
+    if (!m_impl)
+        return;
+
+    while (!m_impl->entries.empty())
+        m_impl->remove(m_impl->entries.front());
+}
+
+
+////////////////////////////////////////////////////////////
+TextureCache::TextureCache(TextureCache&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+TextureCache& TextureCache::operator=(TextureCache&& right) noexcept
+{
+    if (this != &right)
+    {
+        TextureCache temp(std::move(*this));
+        m_impl = std::move(right.m_impl);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::setBudget(Uint64 budget)
+{
+    if (!m_impl)
+        m_impl = std::make_unique<priv::TextureCacheImpl>();
+
+    m_impl->budget = budget;
+    m_impl->enforceBudget(nullptr);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 TextureCache::getBudget() const
+{
+    return m_impl ? m_impl->budget : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::add(Texture& texture)
+{
+    add(texture, ReloadFunction());
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::add(Texture& texture, ReloadFunction reload)
+{
+    if (!m_impl)
+        m_impl = std::make_unique<priv::TextureCacheImpl>();
+
+    if (contains(texture))
+    {
+        texture.m_cacheEntry->reload = std::move(reload);
+        m_impl->touch(*texture.m_cacheEntry);
+        return;
+    }
+
+    // A texture belongs to a single cache
+    if (texture.m_cacheEntry)
+        texture.m_cacheEntry->cache->remove(*texture.m_cacheEntry);
+
+    m_impl->add(texture, std::move(reload));
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::remove(Texture& texture)
+{
+    if (contains(texture))
+        m_impl->remove(*texture.m_cacheEntry);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureCache::contains(const Texture& texture) const
+{
+    return m_impl && texture.m_cacheEntry && (texture.m_cacheEntry->cache == m_impl.get());
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureCache::isResident(const Texture& texture) const
+{
+    return contains(texture) && texture.m_cacheEntry->resident;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureCache::restore(Texture& texture)
+{
+    return contains(texture) && m_impl->touch(*texture.m_cacheEntry);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureCache::getCount() const
+{
+    return m_impl ? m_impl->entries.size() : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 TextureCache::getMemoryUsage() const
+{
+    return m_impl ? m_impl->memoryUsage : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 TextureCache::getEvictionCount() const
+{
+    return m_impl ? m_impl->evictionCount : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::touch(priv::TextureCacheEntry& entry)
+{
+    entry.cache->touch(entry);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::detach(priv::TextureCacheEntry& entry)
+{
+    entry.cache->erase(entry);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureCache::retarget(priv::TextureCacheEntry& entry, Texture& texture)
+{
+    entry.texture = &texture;
+}
+
+} // namespace sf
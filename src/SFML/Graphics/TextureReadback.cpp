@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/PixelBufferPool.hpp>
+#include <SFML/Graphics/TextureReadback.hpp>
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureReadback::TextureReadback() :
+m_buffer(0),
+m_capacity(0),
+m_fence(nullptr),
+m_size(0, 0),
+m_actualSize(0, 0),
+m_pixelsFlipped(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureReadback::~TextureReadback()
+{
+    release();
+}
+
+
+////////////////////////////////////////////////////////////
+TextureReadback::TextureReadback(TextureReadback&& right) noexcept : TextureReadback()
+{
+    *this = std::move(right);
+}
+
+
+////////////////////////////////////////////////////////////
+TextureReadback& TextureReadback::operator=(TextureReadback&& right) noexcept
+{
+    if (this != &right)
+    {
+        release();
+
+        m_pool          = std::move(right.m_pool);
+        m_buffer        = std::exchange(right.m_buffer, 0);
+        m_capacity      = std::exchange(right.m_capacity, 0);
+        m_fence         = std::exchange(right.m_fence, nullptr);
+        m_size          = std::exchange(right.m_size, Vector2u(0, 0));
+        m_actualSize    = std::exchange(right.m_actualSize, Vector2u(0, 0));
+        m_pixelsFlipped = std::exchange(right.m_pixelsFlipped, false);
+        m_image         = std::exchange(right.m_image, Image());
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReadback::isReady() const
+{
+    // Pixels copied synchronously are always ready
+    if (!m_buffer)
+        return m_image.getSize().x > 0;
+
+    if (!m_fence)
+        return true;
+
+    TransientContextLock lock;
+
+    // A zero timeout only polls the state of the fence
+    GLenum status = GLEXT_GL_TIMEOUT_EXPIRED;
+    glCheck(status = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(m_fence), 0, 0));
+
+    return (status == GLEXT_GL_ALREADY_SIGNALED) || (status == GLEXT_GL_CONDITION_SATISFIED);
+}
+
+
+////////////////////////////////////////////////////////////
+Image TextureReadback::getImage()
+{
+    if (!m_buffer)
+        return std::exchange(m_image, Image());
+
+    Image image;
+
+    {
+        TransientContextLock lock;
+
+        // Mapping the buffer waits for the transfer if it is not done yet
+        const std::size_t srcPitch = static_cast<std::size_t>(m_actualSize.x) * 4;
+        const void*       mapping  = nullptr;
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, m_buffer));
+        glCheck(mapping = GLEXT_glMapBufferRange(GLEXT_GL_PIXEL_PACK_BUFFER,
+                                                 0,
+                                                 static_cast<GLsizeiptr>(srcPitch * m_actualSize.y),
+                                                 GLEXT_GL_MAP_READ_BIT));
+
+        if (mapping && (m_size == m_actualSize) && !m_pixelsFlipped)
+        {
+            // Texture is not padded nor flipped, we can use a direct copy
+            image.create(m_size, static_cast<const Uint8*>(mapping));
+        }
+        else if (mapping)
+        {
+            // Copy the useful pixels of each row, in reverse order if the texture is flipped,
+            // straight into the storage that the image then takes over
+            const auto*        src      = static_cast<const Uint8*>(mapping);
+            const std::size_t  dstPitch = static_cast<std::size_t>(m_size.x) * 4;
+            std::vector<Uint8> pixels(dstPitch * m_size.y);
+
+            for (std::size_t y = 0; y < m_size.y; ++y)
+            {
+                const std::size_t srcRow = m_pixelsFlipped ? m_size.y - 1 - y : y;
+                std::memcpy(pixels.data() + y * dstPitch, src + srcRow * srcPitch, dstPitch);
+            }
+
+            image.create(m_size, std::move(pixels));
+        }
+
+        if (mapping)
+            glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER));
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+    }
+
+    release();
+
+    return image;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReadback::isAvailable()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!priv::PixelBufferPool::isAvailable())
+        return false;
+
+    TransientContextLock lock;
+
+    return GLEXT_sync;
+
+#else
+
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureReadback::release()
+{
+    if (!m_buffer && !m_fence)
+        return;
+
+    TransientContextLock lock;
+
+    if (m_buffer)
+    {
+        m_pool->release({m_buffer, m_capacity});
+        m_buffer = 0;
+    }
+
+    if (m_fence)
+    {
+        glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_fence)));
+        m_fence = nullptr;
+    }
+}
+
+} // namespace sf
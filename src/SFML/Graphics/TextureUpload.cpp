@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/PixelBufferPool.hpp>
+#include <SFML/Graphics/TextureUpload.hpp>
+
+#include <utility>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureUpload::TextureUpload() :
+m_texture(nullptr),
+m_buffer(0),
+m_capacity(0),
+m_pixels(nullptr),
+m_size(0, 0),
+m_destination(0, 0),
+m_format(RGBA8),
+m_fence(nullptr),
+m_submitted(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureUpload::~TextureUpload()
+{
+    release();
+}
+
+
+////////////////////////////////////////////////////////////
+TextureUpload::TextureUpload(TextureUpload&& right) noexcept : TextureUpload()
+{
+    *this = std::move(right);
+}
+
+
+////////////////////////////////////////////////////////////
+TextureUpload& TextureUpload::operator=(TextureUpload&& right) noexcept
+{
+    if (this != &right)
+    {
+        release();
+
+        // Moving the vector keeps its storage, so m_pixels stays valid
+        m_texture      = std::exchange(right.m_texture, nullptr);
+        m_pool         = std::move(right.m_pool);
+        m_buffer       = std::exchange(right.m_buffer, 0);
+        m_capacity     = std::exchange(right.m_capacity, 0);
+        m_pixels       = std::exchange(right.m_pixels, nullptr);
+        m_systemPixels = std::move(right.m_systemPixels);
+        m_size         = std::exchange(right.m_size, Vector2u(0, 0));
+        m_destination  = std::exchange(right.m_destination, Vector2u(0, 0));
+        m_format       = std::exchange(right.m_format, RGBA8);
+        m_fence        = std::exchange(right.m_fence, nullptr);
+        m_submitted    = std::exchange(right.m_submitted, false);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* TextureUpload::getPixels()
+{
+    return m_pixels;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureUpload::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureUpload::getDestination() const
+{
+    return m_destination;
+}
+
+
+////////////////////////////////////////////////////////////
+PixelFormat TextureUpload::getPixelFormat() const
+{
+    return m_format;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureUpload::isSubmitted() const
+{
+    return m_submitted;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureUpload::isComplete() const
+{
+    if (!m_submitted)
+        return false;
+
+    // Without a fence the transfer was either synchronous or can't be tracked
+    if (!m_fence)
+        return true;
+
+    TransientContextLock lock;
+
+    // A zero timeout only polls the state of the fence
+    GLenum status = GLEXT_GL_TIMEOUT_EXPIRED;
+    glCheck(status = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(m_fence), 0, 0));
+
+    return (status == GLEXT_GL_ALREADY_SIGNALED) || (status == GLEXT_GL_CONDITION_SATISFIED);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureUpload::wait() const
+{
+    if (!m_submitted || !m_fence)
+        return;
+
+    TransientContextLock lock;
+
+    GLenum status = GLEXT_GL_TIMEOUT_EXPIRED;
+    while (status == GLEXT_GL_TIMEOUT_EXPIRED)
+        glCheck(status = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(m_fence),
+                                                GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT,
+                                                1000000000));
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureUpload::isAvailable()
+{
+    if (!priv::PixelBufferPool::isAvailable())
+        return false;
+
+    TransientContextLock lock;
+
+    return GLEXT_sync;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureUpload::release()
+{
+    if (!m_buffer && !m_fence)
+        return;
+
+    TransientContextLock lock;
+
+    if (m_buffer)
+    {
+        // The upload was discarded before being submitted, its buffer is still mapped
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_buffer));
+        glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+        m_pool->release({m_buffer, m_capacity});
+        m_buffer = 0;
+        m_pixels = nullptr;
+    }
+
+    if (m_fence)
+    {
+        glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_fence)));
+        m_fence = nullptr;
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/UploadCounters.hpp>
+
+#include <atomic>
+
+
+namespace
+{
+// A nested named namespace is used here to allow unity builds of SFML.
+namespace UploadCountersImpl
+{
+// Uploads can happen on any thread, the counters only need to be atomic, not ordered
+std::atomic<sf::Uint64> textureUploadBytes(0);
+std::atomic<sf::Uint64> bufferUploadBytes(0);
+} // namespace UploadCountersImpl
+} // namespace
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void countTextureUpload(Uint64 bytes)
+{
+    UploadCountersImpl::textureUploadBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+void countBufferUpload(Uint64 bytes)
+{
+    UploadCountersImpl::bufferUploadBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 getTextureUploadBytes()
+{
+    return UploadCountersImpl::textureUploadBytes.load(std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 getBufferUploadBytes()
+{
+    return UploadCountersImpl::bufferUploadBytes.load(std::memory_order_relaxed);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_UPLOADCOUNTERS_HPP
+#define SFML_UPLOADCOUNTERS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Count bytes uploaded to a texture
+///
+/// \param bytes Number of bytes uploaded
+///
+////////////////////////////////////////////////////////////
+void countTextureUpload(Uint64 bytes);
+
+////////////////////////////////////////////////////////////
+/// \brief Count bytes uploaded to a vertex or index buffer
+///
+/// \param bytes Number of bytes uploaded
+///
+////////////////////////////////////////////////////////////
+void countBufferUpload(Uint64 bytes);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the total number of bytes uploaded to textures
+///
+/// \return Number of bytes uploaded since the program started
+///
+////////////////////////////////////////////////////////////
+Uint64 getTextureUploadBytes();
+
+////////////////////////////////////////////////////////////
+/// \brief Get the total number of bytes uploaded to vertex and index buffers
+///
+/// \return Number of bytes uploaded since the program started
+///
+////////////////////////////////////////////////////////////
+Uint64 getBufferUploadBytes();
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_UPLOADCOUNTERS_HPP
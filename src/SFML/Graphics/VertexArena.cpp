@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexArena.hpp>
+
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+VertexArena::VertexArena() : m_vertices(), m_size(0), m_primitiveType(Points)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+VertexArena::VertexArena(PrimitiveType type, std::size_t capacity) :
+m_vertices(capacity),
+m_size(0),
+m_primitiveType(type)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Vertex* VertexArena::allocate(std::size_t vertexCount)
+{
+    std::size_t first = m_size.load(std::memory_order_relaxed);
+
+    // Only reserve the range if it fits, so that a failed allocation doesn't affect the others
+    do
+    {
+        if (vertexCount > m_vertices.size() - first)
+            return nullptr;
+    } while (!m_size.compare_exchange_weak(first, first + vertexCount, std::memory_order_relaxed));
+
+    return m_vertices.data() + first;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexArena::getVertexCount() const
+{
+    return m_size.load(std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+const Vertex* VertexArena::getVertices() const
+{
+    return m_vertices.data();
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArena::setCapacity(std::size_t capacity)
+{
+    m_vertices.resize(capacity);
+    m_size = std::min(m_size.load(), capacity);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexArena::getCapacity() const
+{
+    return m_vertices.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArena::clear()
+{
+    m_size = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArena::setPrimitiveType(PrimitiveType type)
+{
+    m_primitiveType = type;
+}
+
+
+////////////////////////////////////////////////////////////
+PrimitiveType VertexArena::getPrimitiveType() const
+{
+    return m_primitiveType;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArena::draw(RenderTarget& target, const RenderStates& states) const
+{
+    std::size_t vertexCount = getVertexCount();
+
+    if (vertexCount > 0)
+        target.draw(m_vertices.data(), vertexCount, m_primitiveType, states);
+}
+
+} // namespace sf
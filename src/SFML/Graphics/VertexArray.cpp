@@ -136,6 +136,13 @@ FloatRect VertexArray::getBounds() const
 }
 
 
+////////////////////////////////////////////////////////////
+std::optional<FloatRect> VertexArray::getCullingBounds() const
+{
+    return getBounds();
+}
+
+
 ////////////////////////////////////////////////////////////
 void VertexArray::draw(RenderTarget& target, const RenderStates& states) const
 {
@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/UploadCounters.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/VertexBuffer.hpp>
 #include <SFML/System/Err.hpp>
@@ -202,6 +203,8 @@ bool VertexBuffer::update(const Vertex* vertices, std::size_t vertexCount, unsig
 
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
 
+    priv::countBufferUpload(sizeof(Vertex) * static_cast<Uint64>(vertexCount));
+
     return true;
 }
 
@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/VertexStream.hpp>
+#include <SFML/System/Err.hpp>
+
+#include <cstring>
+#include <mutex>
+#include <ostream>
+
+
+namespace
+{
+// A nested named namespace is used here to allow unity builds of SFML.
+namespace VertexStreamImpl
+{
+std::recursive_mutex isAvailableMutex;
+
+// Persistent mapping requires both immutable storage and fences
+bool isPersistentMappingAvailable()
+{
+    return GLEXT_buffer_storage && GLEXT_sync;
+}
+} // namespace VertexStreamImpl
+} // namespace
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+VertexStream::VertexStream() :
+m_buffer(0),
+m_mapping(nullptr),
+m_useFences(false),
+m_segment(0),
+m_offset(0),
+m_fences()
+{
+    if (!isAvailable())
+        return;
+
+    TransientContextLock contextLock;
+
+    auto size = static_cast<GLsizeiptr>(sizeof(Vertex) * SegmentSize * SegmentCount);
+
+    GLuint buffer = 0;
+    glCheck(GLEXT_glGenBuffers(1, &buffer));
+
+    if (!buffer)
+    {
+        err() << "Could not create vertex stream, failed to generate buffer" << std::endl;
+        return;
+    }
+
+    m_buffer = buffer;
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    if (VertexStreamImpl::isPersistentMappingAvailable())
+    {
+        // Map the whole buffer once and for all, fences prevent overwriting data still in use
+        GLbitfield flags = GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_PERSISTENT_BIT | GLEXT_GL_MAP_COHERENT_BIT;
+        glCheck(GLEXT_glBufferStorage(GLEXT_GL_ARRAY_BUFFER, size, nullptr, flags));
+
+        void* mapping = nullptr;
+        glCheck(mapping = GLEXT_glMapBufferRange(GLEXT_GL_ARRAY_BUFFER, 0, size, flags));
+        m_mapping = static_cast<Vertex*>(mapping);
+    }
+
+    if (!m_mapping)
+    {
+        // Fall back to mapping each written range without synchronization,
+        // protected by fences if available and by orphaning the buffer otherwise
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, size, nullptr, GLEXT_GL_STREAM_DRAW));
+    }
+
+    m_useFences = GLEXT_sync;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+}
+
+
+////////////////////////////////////////////////////////////
+VertexStream::~VertexStream()
+{
+    if (!m_buffer)
+        return;
+
+    TransientContextLock contextLock;
+
+    for (GLEXT_GLsync& fence : m_fences)
+    {
+        if (fence)
+            glCheck(GLEXT_glDeleteSync(fence));
+    }
+
+    // Deleting the buffer also releases its persistent mapping
+    glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexStream::isAvailable()
+{
+    std::scoped_lock lock(VertexStreamImpl::isAvailableMutex);
+
+    static bool checked   = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = GLEXT_vertex_buffer_object && GLEXT_map_buffer_range;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexStream::isValid() const
+{
+    return m_buffer != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexStream::write(const Vertex* vertices, std::size_t vertexCount, std::size_t& firstVertex)
+{
+    if (!m_buffer || (vertexCount > SegmentSize))
+        return false;
+
+    if (m_offset + vertexCount > SegmentSize)
+        nextSegment();
+
+    firstVertex = m_segment * SegmentSize + m_offset;
+
+    if (m_mapping)
+    {
+        std::memcpy(m_mapping + firstVertex, vertices, sizeof(Vertex) * vertexCount);
+    }
+    else
+    {
+        // The range is known not to be used by the GPU anymore, no need for the driver to synchronize
+        GLbitfield flags = GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_INVALIDATE_RANGE_BIT | GLEXT_GL_MAP_UNSYNCHRONIZED_BIT;
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+        void* destination = nullptr;
+        glCheck(destination = GLEXT_glMapBufferRange(GLEXT_GL_ARRAY_BUFFER,
+                                                     static_cast<GLintptr>(sizeof(Vertex) * firstVertex),
+                                                     static_cast<GLsizeiptr>(sizeof(Vertex) * vertexCount),
+                                                     flags));
+
+        GLboolean unmapped = GL_FALSE;
+        if (destination)
+        {
+            std::memcpy(destination, vertices, sizeof(Vertex) * vertexCount);
+
+            glCheck(unmapped = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
+        }
+
+        // On failure the caller falls back to client-side arrays, which
+        // would be read as offsets into a buffer that is left bound
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+        // The contents of the buffer may have been lost, e.g. on a display mode change
+        if (unmapped == GL_FALSE)
+            return false;
+    }
+
+    m_offset += vertexCount;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int VertexStream::getNativeHandle() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexStream::nextSegment()
+{
+    if (m_useFences)
+    {
+        // Signal when the GPU is done with the draws that read the segment we leave
+        glCheck(m_fences[m_segment] = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    }
+
+    m_segment = (m_segment + 1) % SegmentCount;
+    m_offset  = 0;
+
+    if (m_useFences)
+    {
+        // Wait until the GPU is done with the segment we enter, it was released
+        // a full ring ago so the fence is most likely already signaled
+        if (GLEXT_GLsync fence = m_fences[m_segment])
+        {
+            GLenum status = GLEXT_GL_TIMEOUT_EXPIRED;
+            while (status == GLEXT_GL_TIMEOUT_EXPIRED)
+                glCheck(status = GLEXT_glClientWaitSync(fence, GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000));
+
+            glCheck(GLEXT_glDeleteSync(fence));
+            m_fences[m_segment] = nullptr;
+        }
+    }
+    else if (m_segment == 0)
+    {
+        // Without fences, orphan the buffer every time the ring wraps around:
+        // the driver hands us fresh storage while the GPU keeps reading the old one
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER,
+                                   static_cast<GLsizeiptr>(sizeof(Vertex) * SegmentSize * SegmentCount),
+                                   nullptr,
+                                   GLEXT_GL_STREAM_DRAW));
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
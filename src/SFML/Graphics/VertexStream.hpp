@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VERTEXSTREAM_HPP
+#define SFML_VERTEXSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <SFML/Window/GlResource.hpp>
+
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Ring buffer used to stream vertices to the GPU
+///
+/// The buffer is split into segments. Vertices are written
+/// sequentially into the current segment; when it is full,
+/// a fence is inserted after the draws that read it and
+/// writing continues in the next segment, once its own fence
+/// (inserted a full ring earlier) has been signaled.
+///
+////////////////////////////////////////////////////////////
+class VertexStream : GlResource
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates the buffer, isValid tells whether this succeeded.
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~VertexStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexStream(const VertexStream&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexStream& operator=(const VertexStream&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether vertex streaming is supported by the system
+    ///
+    /// \return True if vertex streaming is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the buffer was successfully created
+    ///
+    /// \return True if the buffer can be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isValid() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write vertices into the buffer
+    ///
+    /// No buffer is left bound to GL_ARRAY_BUFFER when this
+    /// function returns, whether the write succeeded or not.
+    ///
+    /// \param vertices    Pointer to the vertices to write
+    /// \param vertexCount Number of vertices to write
+    /// \param firstVertex Filled with the index of the first written vertex in the buffer
+    ///
+    /// \return True on success, false if the vertices don't fit or couldn't be written
+    ///
+    ////////////////////////////////////////////////////////////
+    bool write(const Vertex* vertices, std::size_t vertexCount, std::size_t& firstVertex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenGL handle of the buffer
+    ///
+    /// \return OpenGL name of the buffer object
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Move to the beginning of the next segment
+    ///
+    ////////////////////////////////////////////////////////////
+    void nextSegment();
+
+    ////////////////////////////////////////////////////////////
+    // Member types
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        SegmentCount = 4,    //!< Number of segments in the ring
+        SegmentSize  = 65536 //!< Number of vertices in a segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_buffer;               //!< OpenGL buffer object
+    Vertex*      m_mapping;              //!< Persistent mapping of the buffer, if supported
+    bool         m_useFences;            //!< Are fences used to protect the segments?
+    std::size_t  m_segment;              //!< Index of the segment being written
+    std::size_t  m_offset;               //!< Write position in the current segment, in vertices
+    GLEXT_GLsync m_fences[SegmentCount]; //!< Fences signaled when the GPU is done with each segment
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_VERTEXSTREAM_HPP
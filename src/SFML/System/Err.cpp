@@ -30,6 +30,7 @@
 #include <cstdio>
 #include <iostream>
 #include <streambuf>
+#include <utility>
 
 
 namespace
@@ -93,6 +94,9 @@ private:
         return 0;
     }
 };
+
+// Stream that replaces sf::err() on the current thread, if any
+thread_local std::ostream* threadStream(nullptr);
 } // namespace
 
 namespace sf
@@ -103,7 +107,14 @@ std::ostream& err()
     static DefaultErrStreamBuf buffer;
     static std::ostream        stream(&buffer);
 
-    return stream;
+    return threadStream ? *threadStream : stream;
+}
+
+
+////////////////////////////////////////////////////////////
+std::ostream* priv::setThreadErrStream(std::ostream* stream)
+{
+    return std::exchange(threadStream, stream);
 }
 
 
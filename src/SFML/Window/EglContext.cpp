@@ -31,6 +31,7 @@
 #include <SFML/Window/EglContext.hpp>
 #include <SFML/Window/WindowImpl.hpp>
 
+#include <cstring>
 #include <mutex>
 #include <ostream>
 #ifdef SFML_SYSTEM_ANDROID
@@ -48,6 +49,10 @@
 #include <glad/egl.h>
 #endif
 
+#ifndef EGL_BUFFER_AGE_EXT
+#define EGL_BUFFER_AGE_EXT 0x313D
+#endif
+
 namespace
 {
 // A nested named namespace is used here to allow unity builds of SFML.
@@ -93,6 +98,46 @@ void ensureInit()
         gladLoaderLoadEGL(getInitializedDisplay());
     }
 }
+
+
+////////////////////////////////////////////////////////////
+bool isExtensionAvailable(EGLDisplay display, const char* name)
+{
+    // Buffer age and swap with damage are not handled by the loader, look them up in the extension string
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+
+    return extensions && std::strstr(extensions, name);
+}
+
+
+////////////////////////////////////////////////////////////
+bool isBufferAgeAvailable(EGLDisplay display)
+{
+    static const bool available = isExtensionAvailable(display, "EGL_EXT_buffer_age");
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+using SwapBuffersWithDamageFunction = EGLBoolean(GLAD_API_PTR*)(EGLDisplay, EGLSurface, const EGLint*, EGLint);
+
+SwapBuffersWithDamageFunction getSwapBuffersWithDamage(EGLDisplay display)
+{
+    static const SwapBuffersWithDamageFunction function = [display]() -> SwapBuffersWithDamageFunction
+    {
+        const char* name = nullptr;
+
+        if (isExtensionAvailable(display, "EGL_KHR_swap_buffers_with_damage"))
+            name = "eglSwapBuffersWithDamageKHR";
+        else if (isExtensionAvailable(display, "EGL_EXT_swap_buffers_with_damage"))
+            name = "eglSwapBuffersWithDamageEXT";
+
+        return name ? reinterpret_cast<SwapBuffersWithDamageFunction>(eglGetProcAddress(name)) : nullptr;
+    }();
+
+    return function;
+}
 } // namespace EglContextImpl
 } // namespace
 
@@ -258,6 +303,37 @@ void EglContext::setVerticalSyncEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+void EglContext::displayWithDamage(const Vector2i& position, const Vector2i& size)
+{
+    if (m_surface == EGL_NO_SURFACE)
+        return;
+
+    if (EglContextImpl::SwapBuffersWithDamageFunction swapBuffersWithDamage = EglContextImpl::getSwapBuffersWithDamage(m_display))
+    {
+        const EGLint rectangle[] = {position.x, position.y, size.x, size.y};
+        eglCheck(swapBuffersWithDamage(m_display, m_surface, rectangle, 1));
+    }
+    else
+    {
+        eglCheck(eglSwapBuffers(m_display, m_surface));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int EglContext::getBackBufferAge()
+{
+    if ((m_surface == EGL_NO_SURFACE) || !EglContextImpl::isBufferAgeAvailable(m_display))
+        return 0;
+
+    EGLint age = 0;
+    eglCheck(eglQuerySurface(m_display, m_surface, EGL_BUFFER_AGE_EXT, &age));
+
+    return static_cast<unsigned int>(age);
+}
+
+
 ////////////////////////////////////////////////////////////
 void EglContext::createContext(EglContext* shared)
 {
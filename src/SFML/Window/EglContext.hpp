@@ -122,6 +122,23 @@ public:
     ////////////////////////////////////////////////////////////
     void setVerticalSyncEnabled(bool enabled) override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Display what has been rendered, telling which region changed
+    ///
+    /// \param position Bottom-left corner of the damaged region, in pixels
+    /// \param size     Size of the damaged region, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void displayWithDamage(const Vector2i& position, const Vector2i& size) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the back buffer
+    ///
+    /// \return Age of the back buffer in frames, 0 if its contents are undefined
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBackBufferAge() override;
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the context
     ///
@@ -687,6 +687,20 @@ bool GlContext::setActive(bool active)
 }
 
 
+////////////////////////////////////////////////////////////
+void GlContext::displayWithDamage(const Vector2i& /* position */, const Vector2i& /* size */)
+{
+    display();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int GlContext::getBackBufferAge()
+{
+    return 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 GlContext::GlContext() : m_id(GlContextImpl::id++)
 {
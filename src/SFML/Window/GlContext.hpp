@@ -33,6 +33,7 @@
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/ContextSettings.hpp>
 #include <SFML/Window/GlResource.hpp>
+#include <SFML/System/Vector2.hpp>
 
 #include <memory>
 
@@ -241,6 +242,33 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Display what has been rendered, telling which region changed
+    ///
+    /// The region is a hint that allows the windowing system to
+    /// only update the damaged part of the screen. The default
+    /// implementation ignores it and calls display().
+    ///
+    /// \param position Bottom-left corner of the damaged region, in pixels
+    /// \param size     Size of the damaged region, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void displayWithDamage(const Vector2i& position, const Vector2i& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the back buffer
+    ///
+    /// The age is the number of frames since the current contents
+    /// of the back buffer were displayed: 1 if it contains the
+    /// previous frame, 2 if it contains the frame before, etc.
+    /// 0 means that its contents are undefined. The default
+    /// implementation always returns 0.
+    ///
+    /// \return Age of the back buffer, in frames
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getBackBufferAge();
+
 protected:
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
@@ -31,6 +31,7 @@
 #include <SFML/Window/Unix/GlxContext.hpp>
 #include <SFML/Window/Unix/WindowImplX11.hpp>
 
+#include <cstring>
 #include <mutex>
 #include <ostream>
 #include <vector>
@@ -43,6 +44,10 @@
 #include <glad/glx.h>
 #endif
 
+#ifndef GLX_BACK_BUFFER_AGE_EXT
+#define GLX_BACK_BUFFER_AGE_EXT 0x20F4
+#endif
+
 #if !defined(GLX_DEBUGGING) && defined(SFML_DEBUG)
 // Enable this to print messages to err() everytime GLX produces errors
 //#define GLX_DEBUGGING
@@ -71,6 +76,20 @@ void ensureExtensionsInit(::Display* display, int screen)
 }
 
 
+////////////////////////////////////////////////////////////
+bool isBufferAgeAvailable(::Display* display)
+{
+    // GLX_EXT_buffer_age is not handled by the loader, look it up in the extension string
+    static const bool available = [display]
+    {
+        const char* extensions = glXQueryExtensionsString(display, DefaultScreen(display));
+        return SF_GLAD_GLX_VERSION_1_3 && extensions && std::strstr(extensions, "GLX_EXT_buffer_age");
+    }();
+
+    return available;
+}
+
+
 int HandleXError(::Display*, XErrorEvent*)
 {
     glxErrorOccurred = true;
@@ -321,6 +340,20 @@ void GlxContext::setVerticalSyncEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int GlxContext::getBackBufferAge()
+{
+    // Only window back buffers are swapped
+    if (m_pbuffer || !m_window || !isBufferAgeAvailable(m_display))
+        return 0;
+
+    unsigned int age = 0;
+    glXQueryDrawable(m_display, m_window, GLX_BACK_BUFFER_AGE_EXT, &age);
+
+    return age;
+}
+
+
 ////////////////////////////////////////////////////////////
 XVisualInfo GlxContext::selectBestVisual(::Display* display, unsigned int bitsPerPixel, const ContextSettings& settings)
 {
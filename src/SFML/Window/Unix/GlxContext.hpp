@@ -120,6 +120,14 @@ public:
     ////////////////////////////////////////////////////////////
     void setVerticalSyncEnabled(bool enabled) override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the back buffer
+    ///
+    /// \return Age of the back buffer in frames, 0 if its contents are undefined
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBackBufferAge() override;
+
     ////////////////////////////////////////////////////////////
     /// \brief Select the best GLX visual for a given set of settings
     ///
@@ -214,12 +214,35 @@ void Window::display()
     if (setActive())
         m_context->display();
 
-    // Limit the framerate if needed
-    if (m_frameTimeLimit != Time::Zero)
-    {
-        sleep(m_frameTimeLimit - m_clock.getElapsedTime());
-        m_clock.restart();
-    }
+    limitFramerate();
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::displayWithDamage(const Vector2i& position, const Vector2i& size)
+{
+    // Display the backbuffer on screen, only the damaged region needs to be updated
+    if (setActive())
+        m_context->displayWithDamage(position, size);
+
+    limitFramerate();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Window::getBackBufferAge() const
+{
+    if (setActive())
+        return m_context->getBackBufferAge();
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::onBeforeRead() const
+{
+    // Nothing by default
 }
 
 
@@ -242,4 +265,16 @@ void Window::initialize()
     WindowBase::initialize();
 }
 
+
+////////////////////////////////////////////////////////////
+void Window::limitFramerate()
+{
+    // Limit the framerate if needed
+    if (m_frameTimeLimit != Time::Zero)
+    {
+        sleep(m_frameTimeLimit - m_clock.getElapsedTime());
+        m_clock.restart();
+    }
+}
+
 } // namespace sf
@@ -0,0 +1,161 @@
+#include <SFML/Graphics/DistanceField.hpp>
+
+#include <doctest/doctest.h>
+
+#include <GraphicsUtil.hpp>
+#include <vector>
+
+namespace
+{
+// Create RGBA pixels whose coverage is given by a function of the position
+template <typename F>
+std::vector<sf::Uint8> makePixels(const sf::Vector2u& size, F coverage)
+{
+    std::vector<sf::Uint8> pixels;
+    for (unsigned int y = 0; y < size.y; ++y)
+    {
+        for (unsigned int x = 0; x < size.x; ++x)
+            pixels.insert(pixels.end(), {10, 20, 30, coverage(x, y)});
+    }
+
+    return pixels;
+}
+
+// Get the alpha channel of a pixel
+sf::Uint8 alphaAt(const std::vector<sf::Uint8>& pixels, const sf::Vector2u& size, unsigned int x, unsigned int y)
+{
+    return pixels[(y * size.x + x) * 4 + 3];
+}
+
+// Check that the color channels were left unchanged
+bool hasOriginalColors(const std::vector<sf::Uint8>& pixels)
+{
+    for (std::size_t i = 0; i < pixels.size(); i += 4)
+    {
+        if ((pixels[i] != 10) || (pixels[i + 1] != 20) || (pixels[i + 2] != 30))
+            return false;
+    }
+
+    return true;
+}
+} // namespace
+
+TEST_CASE("sf::priv::computeDistanceField - [graphics]")
+{
+    SUBCASE("Filled square")
+    {
+        // Square covering the pixels 4 to 11 of a 16x16 image
+        const sf::Vector2u size(16, 16);
+        const auto         isInside = [](unsigned int x, unsigned int y)
+        { return (x >= 4) && (x < 12) && (y >= 4) && (y < 12); };
+
+        std::vector<sf::Uint8> pixels = makePixels(size,
+                                                   [&](unsigned int x, unsigned int y)
+                                                   { return static_cast<sf::Uint8>(isInside(x, y) ? 255 : 0); });
+        sf::priv::computeDistanceField(pixels.data(), size, 4.f);
+        CHECK(hasOriginalColors(pixels));
+
+        SUBCASE("Sign")
+        {
+            for (unsigned int y = 0; y < size.y; ++y)
+            {
+                for (unsigned int x = 0; x < size.x; ++x)
+                    CHECK((alphaAt(pixels, size, x, y) > 128) == isInside(x, y));
+            }
+        }
+
+        SUBCASE("Edge")
+        {
+            // The edge lies halfway between the pixels on each side, at the 0.5 iso-level
+            CHECK(alphaAt(pixels, size, 4, 8) + alphaAt(pixels, size, 3, 8) == 255);
+            CHECK(alphaAt(pixels, size, 11, 8) + alphaAt(pixels, size, 12, 8) == 255);
+            CHECK(alphaAt(pixels, size, 8, 4) + alphaAt(pixels, size, 8, 3) == 255);
+
+            // Half a pixel from the edge, with a spread of 4 pixels
+            CHECK(alphaAt(pixels, size, 4, 8) == 143);
+            CHECK(alphaAt(pixels, size, 3, 8) == 112);
+        }
+
+        SUBCASE("Distances")
+        {
+            // The distance field increases from the outside to the center of the square
+            for (unsigned int x = 1; x < 8; ++x)
+                CHECK(alphaAt(pixels, size, x, 8) > alphaAt(pixels, size, x - 1, 8));
+
+            // Corners are further away from the edge than the sides
+            CHECK(alphaAt(pixels, size, 2, 2) < alphaAt(pixels, size, 2, 8));
+        }
+
+        SUBCASE("Saturation")
+        {
+            // Beyond the spread, the distance field saturates
+            CHECK(alphaAt(pixels, size, 0, 0) == 0);
+            CHECK(alphaAt(pixels, size, 0, 1) == 0);
+            CHECK(alphaAt(pixels, size, 15, 15) == 0);
+
+            // 3.5 pixels from the edge, it doesn't yet
+            CHECK(alphaAt(pixels, size, 0, 8) > 0);
+        }
+    }
+
+    SUBCASE("Saturation inside")
+    {
+        const sf::Vector2u     size(16, 16);
+        std::vector<sf::Uint8> pixels = makePixels(size,
+                                                   [](unsigned int x, unsigned int y)
+                                                   {
+                                                       const bool inside = (x >= 2) && (x < 14) && (y >= 2) && (y < 14);
+                                                       return static_cast<sf::Uint8>(inside ? 255 : 0);
+                                                   });
+        sf::priv::computeDistanceField(pixels.data(), size, 2.f);
+
+        // The center is 6 pixels away from the edge
+        CHECK(alphaAt(pixels, size, 7, 7) == 255);
+        CHECK(alphaAt(pixels, size, 8, 8) == 255);
+        CHECK(alphaAt(pixels, size, 0, 0) == 0);
+    }
+
+    SUBCASE("Partial coverage")
+    {
+        // Pixels crossed by the edge keep an estimate based on their coverage
+        const sf::Vector2u size(8, 1);
+        const auto         coverage = [](unsigned int x, unsigned int)
+        {
+            if (x == 4)
+                return sf::Uint8(128);
+
+            return static_cast<sf::Uint8>(x < 4 ? 255 : 0);
+        };
+
+        std::vector<sf::Uint8> pixels = makePixels(size, coverage);
+        sf::priv::computeDistanceField(pixels.data(), size, 4.f);
+        CHECK(alphaAt(pixels, size, 4, 0) == 128);
+        CHECK(alphaAt(pixels, size, 3, 0) > 128);
+        CHECK(alphaAt(pixels, size, 5, 0) < 128);
+    }
+
+    SUBCASE("Empty image")
+    {
+        // There is no edge: the distances to the inside stay infinite, which saturates the whole field
+        const sf::Vector2u     size(64, 32);
+        std::vector<sf::Uint8> pixels = makePixels(size, [](unsigned int, unsigned int) { return sf::Uint8(0); });
+        sf::priv::computeDistanceField(pixels.data(), size, 4.f);
+        CHECK(pixels == makePixels(size, [](unsigned int, unsigned int) { return sf::Uint8(0); }));
+    }
+
+    SUBCASE("Full image")
+    {
+        // Same with the distances to the outside
+        const sf::Vector2u     size(64, 32);
+        std::vector<sf::Uint8> pixels = makePixels(size, [](unsigned int, unsigned int) { return sf::Uint8(255); });
+        sf::priv::computeDistanceField(pixels.data(), size, 4.f);
+        CHECK(pixels == makePixels(size, [](unsigned int, unsigned int) { return sf::Uint8(255); }));
+    }
+
+    SUBCASE("Empty size")
+    {
+        std::vector<sf::Uint8> pixels(4, 255);
+        sf::priv::computeDistanceField(pixels.data(), {0, 1}, 4.f);
+        CHECK(pixels == std::vector<sf::Uint8>(4, 255));
+    }
+}
@@ -14,5 +14,6 @@ TEST_CASE("sf::Glyph class - [graphics]")
         CHECK(glyph.rsbDelta == 0);
         CHECK(glyph.bounds == sf::FloatRect());
         CHECK(glyph.textureRect == sf::IntRect());
+        CHECK(glyph.page == 0);
     }
 }
@@ -1,9 +1,110 @@
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
 
 #include <doctest/doctest.h>
 
 #include <GraphicsUtil.hpp>
+#include <algorithm>
 #include <array>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Scalar compositing formula, that Image::copy must match exactly whatever the CPU
+void blendReference(sf::Uint8* dst, const sf::Uint8* src, std::size_t pixelCount)
+{
+    for (std::size_t i = 0; i < pixelCount; ++i, src += 4, dst += 4)
+    {
+        const int srcAlpha = src[3];
+        const int dstAlpha = dst[3];
+        const int outAlpha = srcAlpha + dstAlpha - srcAlpha * dstAlpha / 255;
+
+        for (int k = 0; k < 3; ++k)
+            dst[k] = static_cast<sf::Uint8>(outAlpha ? (src[k] * srcAlpha + dst[k] * (outAlpha - srcAlpha)) / outAlpha : src[k]);
+
+        dst[3] = static_cast<sf::Uint8>(outAlpha);
+    }
+}
+
+// Deterministic pseudo-random pixels
+std::vector<sf::Uint8> makePixels(const sf::Vector2u& size, sf::Uint32 seed)
+{
+    std::vector<sf::Uint8> pixels(std::size_t{size.x} * size.y * 4);
+    for (sf::Uint8& component : pixels)
+    {
+        seed      = seed * 1664525u + 1013904223u;
+        component = static_cast<sf::Uint8>(seed >> 24);
+    }
+
+    return pixels;
+}
+
+void writeUint32(std::vector<sf::Uint8>& file, std::size_t offset, sf::Uint32 value)
+{
+    for (std::size_t i = 0; i < 4; ++i)
+        file[offset + i] = static_cast<sf::Uint8>(value >> (8 * i));
+}
+
+// Minimal DDS file with a single level of blocks
+std::vector<sf::Uint8> makeDds(const char* fourCC, const sf::Vector2u& size, const std::vector<sf::Uint8>& blocks)
+{
+    std::vector<sf::Uint8> file(128);
+    std::copy_n("DDS ", 4, file.begin());
+    writeUint32(file, 4, 124);
+    writeUint32(file, 8, 0x1007);
+    writeUint32(file, 12, size.y);
+    writeUint32(file, 16, size.x);
+    writeUint32(file, 76, 32);
+    writeUint32(file, 80, 0x4);
+    std::copy_n(fourCC, 4, file.begin() + 84);
+    writeUint32(file, 108, 0x1000);
+    file.insert(file.end(), blocks.begin(), blocks.end());
+    return file;
+}
+
+// Minimal KTX file with a single level of blocks
+std::vector<sf::Uint8> makeKtx(sf::Uint32                    glInternalFormat,
+                               const sf::Vector2u&           size,
+                               const std::vector<sf::Uint8>& blocks)
+{
+    std::vector<sf::Uint8> file = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+    file.resize(68);
+    writeUint32(file, 12, 0x04030201);
+    writeUint32(file, 20, 1);
+    writeUint32(file, 28, glInternalFormat);
+    writeUint32(file, 36, size.x);
+    writeUint32(file, 40, size.y);
+    writeUint32(file, 52, 1);
+    writeUint32(file, 56, 1);
+    writeUint32(file, 64, static_cast<sf::Uint32>(blocks.size()));
+    file.insert(file.end(), blocks.begin(), blocks.end());
+    return file;
+}
+
+// Minimal KTX2 file with a single level of blocks
+std::vector<sf::Uint8> makeKtx2(sf::Uint32 vkFormat, const sf::Vector2u& size, const std::vector<sf::Uint8>& blocks)
+{
+    std::vector<sf::Uint8> file = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+    file.resize(104);
+    writeUint32(file, 12, vkFormat);
+    writeUint32(file, 16, 1);
+    writeUint32(file, 20, size.x);
+    writeUint32(file, 24, size.y);
+    writeUint32(file, 36, 1);
+    writeUint32(file, 40, 1);
+    writeUint32(file, 80, 104);
+    writeUint32(file, 88, static_cast<sf::Uint32>(blocks.size()));
+    writeUint32(file, 96, static_cast<sf::Uint32>(blocks.size()));
+    file.insert(file.end(), blocks.begin(), blocks.end());
+    return file;
+}
+} // namespace
 
 TEST_CASE("sf::Image - [graphics]")
 {
@@ -75,6 +176,23 @@ TEST_CASE("sf::Image - [graphics]")
                 }
             }
         }
+
+        SUBCASE("create(Vector2, std::vector<Uint8>&&)")
+        {
+            std::vector<sf::Uint8> pixels = makePixels(sf::Vector2u(3, 2), 1);
+            const sf::Uint8*       data   = pixels.data();
+            const sf::Color        color(pixels[4], pixels[5], pixels[6], pixels[7]);
+
+            sf::Image image;
+            image.create(sf::Vector2u(3, 2), std::move(pixels));
+            CHECK(image.getSize() == sf::Vector2u(3, 2));
+            CHECK(image.getPixelsPtr() == data);
+            CHECK(image.getPixel(sf::Vector2u(1, 0)) == color);
+
+            image.create(sf::Vector2u(3, 3), makePixels(sf::Vector2u(3, 2), 1));
+            CHECK(image.getSize() == sf::Vector2u(0, 0));
+            CHECK(image.getPixelsPtr() == nullptr);
+        }
     }
 
     SUBCASE("Set/get pixel")
@@ -160,6 +278,37 @@ TEST_CASE("sf::Image - [graphics]")
             }
         }
 
+        SUBCASE("Copy (Image, Vector2u, IntRect, bool) (All alpha combinations)")
+        {
+            // Every pair of source and destination alpha values, with widths that exercise the unaligned
+            // and left over pixels of the vectorized implementations
+            const sf::Vector2u     sourceSize(259, 256);
+            const sf::Vector2u     destinationSize(262, 256);
+            std::vector<sf::Uint8> sourcePixels      = makePixels(sourceSize, 1);
+            std::vector<sf::Uint8> destinationPixels = makePixels(destinationSize, 2);
+
+            for (unsigned int y = 0; y < sourceSize.y; ++y)
+                for (unsigned int x = 0; x < sourceSize.x; ++x)
+                    sourcePixels[(y * sourceSize.x + x) * 4 + 3] = static_cast<sf::Uint8>(x);
+
+            for (unsigned int y = 0; y < destinationSize.y; ++y)
+                for (unsigned int x = 0; x < destinationSize.x; ++x)
+                    destinationPixels[(y * destinationSize.x + x) * 4 + 3] = static_cast<sf::Uint8>(y);
+
+            sf::Image source;
+            source.create(sourceSize, sourcePixels.data());
+
+            sf::Image destination;
+            destination.create(destinationSize, destinationPixels.data());
+            CHECK(destination.copy(source, sf::Vector2u(3, 0), sf::IntRect(), true));
+
+            std::vector<sf::Uint8> expected = destinationPixels;
+            for (unsigned int y = 0; y < sourceSize.y; ++y)
+                blendReference(&expected[(y * destinationSize.x + 3) * 4], &sourcePixels[y * sourceSize.x * 4], sourceSize.x);
+
+            CHECK(std::equal(expected.begin(), expected.end(), destination.getPixelsPtr()));
+        }
+
         SUBCASE("Copy (Empty image)")
         {
             sf::Image image1;
@@ -249,4 +398,493 @@ TEST_CASE("sf::Image - [graphics]")
 
         CHECK(image.getPixel(sf::Vector2u(0, 9)) == sf::Color::Green);
     }
+
+    SUBCASE("Pixel operations (compared to scalar operations)")
+    {
+        // Odd sizes exercise the leftover pixels of the vectorized paths, large ones the parallel path
+        const std::array<sf::Vector2u, 5> sizes = {sf::Vector2u(1, 1),
+                                                   sf::Vector2u(3, 5),
+                                                   sf::Vector2u(17, 9),
+                                                   sf::Vector2u(1031, 1030),
+                                                   sf::Vector2u(1030, 1031)};
+
+        for (const sf::Vector2u& size : sizes)
+        {
+            // Few distinct components, so that many pixels match the mask color
+            std::vector<sf::Uint8> pixels = makePixels(size, size.x * 31 + size.y);
+            for (sf::Uint8& component : pixels)
+                component &= 0xC0;
+
+            const std::size_t width  = size.x;
+            const std::size_t height = size.y;
+
+            sf::Image source;
+            source.create(size, pixels.data());
+
+            const sf::Color color = source.getPixel(sf::Vector2u(size.x / 2, size.y / 2));
+
+            // Fill
+            sf::Image filled;
+            filled.create(size, color);
+            std::vector<sf::Uint8> expected(pixels.size());
+            for (std::size_t i = 0; i < expected.size(); i += 4)
+            {
+                expected[i + 0] = color.r;
+                expected[i + 1] = color.g;
+                expected[i + 2] = color.b;
+                expected[i + 3] = color.a;
+            }
+            CHECK(std::equal(expected.begin(), expected.end(), filled.getPixelsPtr()));
+
+            // Mask
+            sf::Image masked = source;
+            masked.createMaskFromColor(color, 42);
+            expected = pixels;
+            for (std::size_t i = 0; i < expected.size(); i += 4)
+            {
+                if ((expected[i] == color.r) && (expected[i + 1] == color.g) && (expected[i + 2] == color.b) &&
+                    (expected[i + 3] == color.a))
+                    expected[i + 3] = 42;
+            }
+            CHECK(std::equal(expected.begin(), expected.end(), masked.getPixelsPtr()));
+
+            // Horizontal flip
+            sf::Image flipped = source;
+            flipped.flipHorizontally();
+            for (std::size_t y = 0; y < height; ++y)
+                for (std::size_t x = 0; x < width; ++x)
+                    std::copy_n(&pixels[(y * width + width - 1 - x) * 4], 4, &expected[(y * width + x) * 4]);
+            CHECK(std::equal(expected.begin(), expected.end(), flipped.getPixelsPtr()));
+
+            flipped.flipHorizontally();
+            CHECK(std::equal(pixels.begin(), pixels.end(), flipped.getPixelsPtr()));
+
+            // Vertical flip
+            flipped.flipVertically();
+            for (std::size_t y = 0; y < height; ++y)
+                std::copy_n(&pixels[(height - 1 - y) * width * 4], width * 4, &expected[y * width * 4]);
+            CHECK(std::equal(expected.begin(), expected.end(), flipped.getPixelsPtr()));
+
+            flipped.flipVertically();
+            CHECK(std::equal(pixels.begin(), pixels.end(), flipped.getPixelsPtr()));
+        }
+    }
+
+    SUBCASE("Resize")
+    {
+        const std::array<sf::Image::ResizeFilter, 4> filters = {sf::Image::Nearest,
+                                                                sf::Image::Bilinear,
+                                                                sf::Image::Box,
+                                                                sf::Image::Lanczos};
+
+        SUBCASE("Empty images")
+        {
+            sf::Image image;
+            CHECK(image.scaled(sf::Vector2u(10, 10)).getSize() == sf::Vector2u());
+
+            image.create(sf::Vector2u(10, 10), sf::Color::Red);
+            CHECK(image.scaled(sf::Vector2u(0, 10)).getSize() == sf::Vector2u());
+            CHECK(image.scaled(sf::Vector2u(10, 0)).getSize() == sf::Vector2u());
+
+            image.resize(sf::Vector2u(0, 0));
+            CHECK(image.getSize() == sf::Vector2u());
+            CHECK(image.getPixelsPtr() == nullptr);
+        }
+
+        SUBCASE("Uniform images stay uniform")
+        {
+            // Large sizes exercise the parallel path
+            const std::array<sf::Vector2u, 4> sizes = {sf::Vector2u(1, 1),
+                                                       sf::Vector2u(37, 5),
+                                                       sf::Vector2u(3, 64),
+                                                       sf::Vector2u(1500, 900)};
+
+            sf::Image image;
+            image.create(sf::Vector2u(101, 67), sf::Color(10, 20, 30, 40));
+
+            for (sf::Image::ResizeFilter filter : filters)
+            {
+                for (const sf::Vector2u& size : sizes)
+                {
+                    const sf::Image result = image.scaled(size, filter);
+                    REQUIRE(result.getSize() == size);
+
+                    const sf::Uint8* pixels = result.getPixelsPtr();
+                    for (std::size_t i = 0; i < std::size_t{size.x} * size.y * 4; i += 4)
+                    {
+                        if (sf::Color(pixels[i], pixels[i + 1], pixels[i + 2], pixels[i + 3]) != sf::Color(10, 20, 30, 40))
+                        {
+                            FAIL_CHECK("Pixel " << i / 4 << " differs with filter " << filter);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            CHECK(image.getSize() == sf::Vector2u(101, 67));
+        }
+
+        SUBCASE("Nearest")
+        {
+            sf::Image image;
+            image.create(sf::Vector2u(2, 2), sf::Color::Red);
+            image.setPixel(sf::Vector2u(1, 0), sf::Color::Green);
+            image.setPixel(sf::Vector2u(0, 1), sf::Color::Blue);
+            image.resize(sf::Vector2u(4, 6), sf::Image::Nearest);
+
+            REQUIRE(image.getSize() == sf::Vector2u(4, 6));
+            CHECK(image.getPixel(sf::Vector2u(1, 2)) == sf::Color::Red);
+            CHECK(image.getPixel(sf::Vector2u(2, 0)) == sf::Color::Green);
+            CHECK(image.getPixel(sf::Vector2u(0, 3)) == sf::Color::Blue);
+            CHECK(image.getPixel(sf::Vector2u(3, 5)) == sf::Color::Red);
+        }
+
+        SUBCASE("Box downscaling averages pixels")
+        {
+            sf::Image image;
+            image.create(sf::Vector2u(4, 2), sf::Color(10, 10, 10));
+            image.setPixel(sf::Vector2u(1, 0), sf::Color(30, 50, 70));
+            image.setPixel(sf::Vector2u(3, 1), sf::Color(50, 90, 130));
+
+            const sf::Image result = image.scaled(sf::Vector2u(2, 1), sf::Image::Box);
+            CHECK(result.getPixel(sf::Vector2u(0, 0)) == sf::Color(15, 20, 25));
+            CHECK(result.getPixel(sf::Vector2u(1, 0)) == sf::Color(20, 30, 40));
+        }
+
+        SUBCASE("Colors are weighted by alpha")
+        {
+            // The color of the transparent pixel must not bleed into the result
+            sf::Image image;
+            image.create(sf::Vector2u(2, 1), sf::Color(255, 0, 0, 0));
+            image.setPixel(sf::Vector2u(1, 0), sf::Color::Green);
+
+            for (sf::Image::ResizeFilter filter : {sf::Image::Bilinear, sf::Image::Box, sf::Image::Lanczos})
+            {
+                const sf::Color color = image.scaled(sf::Vector2u(1, 1), filter).getPixel(sf::Vector2u(0, 0));
+                CHECK(color.r == 0);
+                CHECK(color.g == 255);
+                CHECK(color.b == 0);
+                CHECK(color.a == 128);
+            }
+        }
+
+        SUBCASE("Bilinear preserves gradients")
+        {
+            std::vector<sf::Uint8> pixels(256 * 4 * 4);
+            for (std::size_t y = 0; y < 4; ++y)
+            {
+                for (std::size_t x = 0; x < 256; ++x)
+                {
+                    const std::size_t i = (y * 256 + x) * 4;
+                    pixels[i + 0] = static_cast<sf::Uint8>(x);
+                    pixels[i + 1] = static_cast<sf::Uint8>(255 - x);
+                    pixels[i + 2] = 0;
+                    pixels[i + 3] = 255;
+                }
+            }
+
+            sf::Image image;
+            image.create(sf::Vector2u(256, 4), pixels.data());
+            image.resize(sf::Vector2u(128, 4));
+
+            for (unsigned int x = 0; x < 128; ++x)
+            {
+                const sf::Color color = image.getPixel(sf::Vector2u(x, 2));
+                CHECK(std::abs(int{color.r} - int(2 * x) - 1) <= 1);
+                CHECK(std::abs(int{color.g} - int(254 - 2 * x)) <= 1);
+            }
+        }
+
+        SUBCASE("Maximum thread count")
+        {
+            CHECK(sf::Image::getMaximumThreadCount() == 0);
+
+            // Large enough to be split between threads by default
+            std::vector<sf::Uint8> pixels(1024 * 1024 * 4);
+            for (std::size_t i = 0; i < pixels.size(); ++i)
+                pixels[i] = static_cast<sf::Uint8>(i * 7 + i / 4093);
+
+            sf::Image image;
+            image.create(sf::Vector2u(1024, 1024), pixels.data());
+
+            for (sf::Image::ResizeFilter filter : filters)
+            {
+                const sf::Image parallel = image.scaled(sf::Vector2u(1500, 700), filter);
+
+                sf::Image::setMaximumThreadCount(1);
+                CHECK(sf::Image::getMaximumThreadCount() == 1);
+                const sf::Image sequential = image.scaled(sf::Vector2u(1500, 700), filter);
+                sf::Image::setMaximumThreadCount(0);
+
+                REQUIRE(sequential.getSize() == parallel.getSize());
+                CHECK(std::memcmp(sequential.getPixelsPtr(), parallel.getPixelsPtr(), 1500 * 700 * 4) == 0);
+            }
+        }
+    }
+
+    SUBCASE("Generate mipmaps")
+    {
+        sf::Image image;
+        CHECK(image.generateMipmaps().empty());
+
+        image.create(sf::Vector2u(1, 1), sf::Color::Red);
+        CHECK(image.generateMipmaps().empty());
+
+        image.create(sf::Vector2u(16, 5), sf::Color::Red);
+        const std::vector<sf::Image> levels = image.generateMipmaps();
+        REQUIRE(levels.size() == 4);
+        CHECK(levels[0].getSize() == sf::Vector2u(8, 2));
+        CHECK(levels[1].getSize() == sf::Vector2u(4, 1));
+        CHECK(levels[2].getSize() == sf::Vector2u(2, 1));
+        CHECK(levels[3].getSize() == sf::Vector2u(1, 1));
+        CHECK(levels[3].getPixel(sf::Vector2u(0, 0)) == sf::Color::Red);
+    }
+
+    SUBCASE("Load compressed containers")
+    {
+        sf::Image image;
+
+        SUBCASE("DDS with BC1 blocks")
+        {
+            // Red and blue endpoints, the first row goes through the 4 colors of the palette
+            const std::vector<sf::Uint8> file = makeDds("DXT1",
+                                                        sf::Vector2u(4, 4),
+                                                        {0x00, 0xF8, 0x1F, 0x00, 0xE4, 0x00, 0x00, 0x00});
+            REQUIRE(image.loadFromMemory(file.data(), file.size()));
+            CHECK(image.getSize() == sf::Vector2u(4, 4));
+            CHECK(image.getPixel(sf::Vector2u(0, 0)) == sf::Color(255, 0, 0));
+            CHECK(image.getPixel(sf::Vector2u(1, 0)) == sf::Color(0, 0, 255));
+            CHECK(image.getPixel(sf::Vector2u(2, 0)) == sf::Color(170, 0, 85));
+            CHECK(image.getPixel(sf::Vector2u(3, 0)) == sf::Color(85, 0, 170));
+            CHECK(image.getPixel(sf::Vector2u(3, 3)) == sf::Color(255, 0, 0));
+        }
+
+        SUBCASE("KTX with ETC2 blocks")
+        {
+            // Individual mode, only the first pixel uses the large modifier
+            const std::vector<sf::Uint8> file = makeKtx(0x9274,
+                                                        sf::Vector2u(3, 3),
+                                                        {0x88, 0x44, 0x22, 0x00, 0x00, 0x00, 0x00, 0x01});
+            REQUIRE(image.loadFromMemory(file.data(), file.size()));
+            CHECK(image.getSize() == sf::Vector2u(3, 3));
+            CHECK(image.getPixel(sf::Vector2u(0, 0)) == sf::Color(144, 76, 42));
+            CHECK(image.getPixel(sf::Vector2u(1, 0)) == sf::Color(138, 70, 36));
+            CHECK(image.getPixel(sf::Vector2u(2, 2)) == sf::Color(138, 70, 36));
+        }
+
+        SUBCASE("KTX2 with BC4 blocks")
+        {
+            // The second and third pixels use the second endpoint and the first interpolated value
+            const std::vector<sf::Uint8> file = makeKtx2(139, sf::Vector2u(4, 4), {200, 100, 0x88, 0, 0, 0, 0, 0});
+            REQUIRE(image.loadFromMemory(file.data(), file.size()));
+            CHECK(image.getPixel(sf::Vector2u(0, 0)) == sf::Color(200, 0, 0));
+            CHECK(image.getPixel(sf::Vector2u(1, 0)) == sf::Color(100, 0, 0));
+            CHECK(image.getPixel(sf::Vector2u(2, 0)) == sf::Color(185, 0, 0));
+            CHECK(image.getPixel(sf::Vector2u(3, 3)) == sf::Color(200, 0, 0));
+        }
+
+        SUBCASE("DDS with BC2 and BC3 blocks")
+        {
+            // Same colors as the BC1 block, the first pixels have distinct alpha values
+            const std::vector<sf::Uint8> colors = {0x00, 0xF8, 0x1F, 0x00, 0xE4, 0x00, 0x00, 0x00};
+
+            std::vector<sf::Uint8> blocks = {0x8F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+            blocks.insert(blocks.end(), colors.begin(), colors.end());
+            std::vector<sf::Uint8> file = makeDds("DXT3", sf::Vector2u(4, 4), blocks);
+            REQUIRE(image.loadFromMemory(file.data(), file.size()));
+            CHECK(image.getPixel(sf::Vector2u(0, 0)) == sf::Color(255, 0, 0, 255));
+            CHECK(image.getPixel(sf::Vector2u(1, 0)) == sf::Color(0, 0, 255, 136));
+            CHECK(image.getPixel(sf::Vector2u(2, 0)) == sf::Color(170, 0, 85, 255));
+
+            blocks = {255, 0, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00};
+            blocks.insert(blocks.end(), colors.begin(), colors.end());
+            file = makeDds("DXT5", sf::Vector2u(4, 4), blocks);
+            REQUIRE(image.loadFromMemory(file.data(), file.size()));
+            CHECK(image.getPixel(sf::Vector2u(0, 0)) == sf::Color(255, 0, 0, 255));
+            CHECK(image.getPixel(sf::Vector2u(1, 0)) == sf::Color(0, 0, 255, 0));
+            CHECK(image.getPixel(sf::Vector2u(2, 0)) == sf::Color(170, 0, 85, 218));
+            CHECK(image.getPixel(sf::Vector2u(3, 3)) == sf::Color(255, 0, 0, 255));
+        }
+
+        SUBCASE("KTX with BC5 blocks")
+        {
+            // Red block of the BC4 test, uniform green block
+            const std::vector<sf::Uint8> file = makeKtx(0x8DBD,
+                                                        sf::Vector2u(4, 4),
+                                                        {200, 100, 0x88, 0, 0, 0, 0, 0, 50, 0, 0, 0, 0, 0, 0, 0});
+            REQUIRE(image.loadFromMemory(file.data(), file.size()));
+            CHECK(image.getPixel(sf::Vector2u(0, 0)) == sf::Color(200, 50, 0));
+            CHECK(image.getPixel(sf::Vector2u(1, 0)) == sf::Color(100, 50, 0));
+            CHECK(image.getPixel(sf::Vector2u(2, 0)) == sf::Color(185, 50, 0));
+        }
+
+        SUBCASE("KTX2 with BC7 blocks")
+        {
+            // Mode 6, red and black endpoints with different p-bits, the first pixels use indices 0, 15 and 8
+            const std::vector<sf::Uint8> file = makeKtx2(
+                145,
+                sf::Vector2u(4, 4),
+                {0xC0, 0x3F, 0x00, 0x00, 0x00, 0x00, 0xFE, 0x00, 0xF1, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+            REQUIRE(image.loadFromMemory(file.data(), file.size()));
+            CHECK(image.getPixel(sf::Vector2u(0, 0)) == sf::Color(254, 0, 0, 254));
+            CHECK(image.getPixel(sf::Vector2u(1, 0)) == sf::Color(1, 1, 1, 1));
+            CHECK(image.getPixel(sf::Vector2u(2, 0)) == sf::Color(120, 1, 1, 120));
+            CHECK(image.getPixel(sf::Vector2u(3, 3)) == sf::Color(254, 0, 0, 254));
+        }
+
+        SUBCASE("KTX with ETC2 and EAC blocks")
+        {
+            // Base alpha of 128 with the first modifier table, the pixel below the first one uses index 4
+            const std::vector<sf::Uint8> file = makeKtx(
+                0x9278,
+                sf::Vector2u(4, 4),
+                {0x80, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x44, 0x22, 0x00, 0x00, 0x00, 0x00, 0x01});
+            REQUIRE(image.loadFromMemory(file.data(), file.size()));
+            CHECK(image.getPixel(sf::Vector2u(0, 0)) == sf::Color(144, 76, 42, 125));
+            CHECK(image.getPixel(sf::Vector2u(0, 1)) == sf::Color(138, 70, 36, 130));
+            CHECK(image.getPixel(sf::Vector2u(1, 0)) == sf::Color(138, 70, 36, 125));
+        }
+
+        SUBCASE("Invalid files")
+        {
+            std::vector<sf::Uint8> file = makeDds("DXT5", sf::Vector2u(4, 4), std::vector<sf::Uint8>(15));
+            CHECK(!image.loadFromMemory(file.data(), file.size()));
+
+            file = makeKtx2(139, sf::Vector2u(4, 4), std::vector<sf::Uint8>(8));
+            writeUint32(file, 44, 1); // BasisLZ supercompression
+            CHECK(!image.loadFromMemory(file.data(), file.size()));
+
+            file = makeDds("DXT1", sf::Vector2u(0, 4), {});
+            CHECK(!image.loadFromMemory(file.data(), file.size()));
+
+            file = makeKtx(0x9274, sf::Vector2u(4, 4), std::vector<sf::Uint8>(8));
+            writeUint32(file, 60, 0xFFFFFFF0); // Key/value data larger than the file
+            CHECK(!image.loadFromMemory(file.data(), file.size()));
+
+            file = makeKtx(0x9274, sf::Vector2u(4, 4), std::vector<sf::Uint8>(8));
+            writeUint32(file, 64, 16); // Level larger than its blocks
+            CHECK(!image.loadFromMemory(file.data(), file.size()));
+        }
+
+        SUBCASE("Oversized headers")
+        {
+            // The size of the blocks of such an image overflows 64 bits, and would wrap around to the empty level
+            std::vector<sf::Uint8> file = makeKtx2(145, sf::Vector2u(0xFFFFFFFF, 0xFFFFFFFF), {});
+            CHECK(!image.loadFromMemory(file.data(), file.size()));
+
+            file = makeDds("DXT1", sf::Vector2u(65537, 4), std::vector<sf::Uint8>(16392 * 8));
+            CHECK(!image.loadFromMemory(file.data(), file.size()));
+
+            file = makeKtx(0x9274, sf::Vector2u(4, 0x80000000), {});
+            CHECK(!image.loadFromMemory(file.data(), file.size()));
+        }
+    }
+
+    SUBCASE("Save to memory")
+    {
+        sf::Image image;
+        image.create(sf::Vector2u(16, 8), makePixels(sf::Vector2u(16, 8), 3));
+
+        std::vector<sf::Uint8> expected;
+        REQUIRE(image.saveToMemory(expected, "png"));
+
+        std::vector<sf::Uint8>           buffer(expected.size());
+        const std::optional<std::size_t> size = image.saveToMemory(buffer.data(), buffer.size(), "png");
+        REQUIRE(size.has_value());
+        CHECK(*size == expected.size());
+        CHECK(std::equal(expected.begin(), expected.end(), buffer.begin()));
+
+        CHECK(!image.saveToMemory(buffer.data(), expected.size() - 1, "png").has_value());
+        CHECK(!image.saveToMemory(buffer.data(), buffer.size(), "webp").has_value());
+    }
+
+    SUBCASE("Save settings")
+    {
+        // Large enough to be encoded as several PNG segments
+        const sf::Vector2u     size(300, 500);
+        const std::size_t      byteCount = std::size_t{size.x} * size.y * 4;
+        std::vector<sf::Uint8> pixels    = makePixels(size, 5);
+        for (std::size_t i = 0; i < pixels.size(); i += 4)
+        {
+            const std::size_t x = (i / 4) % size.x;
+            const std::size_t y = (i / 4) / size.x;
+            pixels[i]           = static_cast<sf::Uint8>(x);
+            pixels[i + 1]       = static_cast<sf::Uint8>(y);
+        }
+
+        sf::Image image;
+        image.create(size, std::move(pixels));
+
+        std::vector<std::size_t> fileSizes;
+        for (int level : {0, 1, 8, 9})
+        {
+            for (int filter = sf::Image::PngNone; filter <= sf::Image::PngAdaptive; ++filter)
+            {
+                const sf::Image::SaveSettings settings(level, static_cast<sf::Image::PngFilter>(filter));
+
+                std::vector<sf::Uint8> file;
+                REQUIRE(image.saveToMemory(file, "png", settings));
+
+                sf::Image loaded;
+                REQUIRE(loaded.loadFromMemory(file.data(), file.size()));
+                CHECK(loaded.getSize() == size);
+                CHECK(std::equal(image.getPixelsPtr(), image.getPixelsPtr() + byteCount, loaded.getPixelsPtr()));
+
+                if (filter == sf::Image::PngAdaptive)
+                    fileSizes.push_back(file.size());
+            }
+        }
+
+        // Level 0 stores the filtered rows uncompressed
+        CHECK(fileSizes[0] > byteCount);
+        CHECK(fileSizes[1] < fileSizes[0]);
+        CHECK(fileSizes[3] <= fileSizes[2]);
+
+        std::vector<sf::Uint8> lowQuality;
+        std::vector<sf::Uint8> highQuality;
+        REQUIRE(image.saveToMemory(lowQuality, "jpg", sf::Image::SaveSettings(8, sf::Image::PngAdaptive, 10)));
+        REQUIRE(image.saveToMemory(highQuality, "jpg", sf::Image::SaveSettings(8, sf::Image::PngAdaptive, 95)));
+        CHECK(lowQuality.size() < highQuality.size());
+    }
+
+    SUBCASE("Save to and load from file")
+    {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "sfmlimage.png";
+
+        sf::Image source;
+        source.create(sf::Vector2u(5, 7), makePixels(sf::Vector2u(5, 7), 4));
+        REQUIRE(source.saveToFile(path));
+
+        sf::Image image;
+        REQUIRE(image.loadFromFile(path));
+        CHECK(image.getSize() == sf::Vector2u(5, 7));
+        CHECK(std::equal(source.getPixelsPtr(), source.getPixelsPtr() + 5 * 7 * 4, image.getPixelsPtr()));
+
+        std::filesystem::remove(path);
+        CHECK(!image.loadFromFile(path));
+    }
+}
+
+TEST_CASE("sf::Image::copy benchmark - [graphics]" * doctest::skip())
+{
+    // Run with --no-skip to compare the scalar formula with Image::copy on 4K images
+    const sf::Vector2u     size(3840, 2160);
+    std::vector<sf::Uint8> sourcePixels      = makePixels(size, 1);
+    std::vector<sf::Uint8> destinationPixels = makePixels(size, 2);
+
+    sf::Image source;
+    source.create(size, sourcePixels.data());
+
+    sf::Image destination;
+    destination.create(size, destinationPixels.data());
+
+    sf::Clock clock;
+    blendReference(destinationPixels.data(), sourcePixels.data(), std::size_t{size.x} * size.y);
+    const sf::Int64 scalarTime = clock.restart().asMicroseconds();
+
+    CHECK(destination.copy(source, sf::Vector2u(0, 0), sf::IntRect(), true));
+    const sf::Int64 copyTime = clock.restart().asMicroseconds();
+
+    CHECK(std::equal(destinationPixels.begin(), destinationPixels.end(), destination.getPixelsPtr()));
+    MESSAGE("Scalar: " << scalarTime << " us, Image::copy: " << copyTime << " us");
 }
@@ -0,0 +1,131 @@
+#include <SFML/Graphics/ImageBatch.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
+
+#include <doctest/doctest.h>
+
+#include <GraphicsUtil.hpp>
+#include <array>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+const std::array<sf::Color, 5> colors = {sf::Color::Red,
+                                         sf::Color::Green,
+                                         sf::Color::Blue,
+                                         sf::Color::Yellow,
+                                         sf::Color::Cyan};
+
+sf::Image makeImage(std::size_t index)
+{
+    sf::Image image;
+    image.create(sf::Vector2u(3 + static_cast<unsigned int>(index), 2), colors[index]);
+    return image;
+}
+
+// Collect the results of a batch, checking that each source is returned once with the expected image
+void checkBatch(sf::ImageBatch& batch, std::size_t failingIndex)
+{
+    std::vector<bool>      seen(batch.getCount(), false);
+    sf::ImageBatch::Result result;
+
+    while (batch.wait(result))
+    {
+        REQUIRE(result.index < seen.size());
+        CHECK(!seen[result.index]);
+        seen[result.index] = true;
+
+        CHECK(result.success == (result.index != failingIndex));
+        CHECK(result.error.empty() == result.success);
+        if (result.success)
+        {
+            CHECK(result.image.getSize() == sf::Vector2u(3 + static_cast<unsigned int>(result.index), 2));
+            CHECK(result.image.getPixel(sf::Vector2u(1, 1)) == colors[result.index]);
+        }
+    }
+
+    CHECK(batch.getRemainingCount() == 0);
+    CHECK(!batch.poll(result));
+    for (bool value : seen)
+        CHECK(value);
+}
+} // namespace
+
+TEST_CASE("sf::ImageBatch - [graphics]")
+{
+    SUBCASE("Load from files")
+    {
+        std::vector<std::filesystem::path> paths;
+        for (std::size_t i = 0; i < colors.size(); ++i)
+        {
+            paths.push_back(std::filesystem::temp_directory_path() / ("sfmlbatch" + std::to_string(i) + ".png"));
+            REQUIRE(makeImage(i).saveToFile(paths.back()));
+        }
+
+        // Replace one of the images by a missing file
+        std::filesystem::remove(paths[2]);
+
+        sf::ImageBatch batch(paths, 2);
+        CHECK(batch.getCount() == colors.size());
+        CHECK(batch.getRemainingCount() == colors.size());
+        checkBatch(batch, 2);
+
+        for (const std::filesystem::path& path : paths)
+            std::filesystem::remove(path);
+    }
+
+    SUBCASE("Load from streams")
+    {
+        std::array<std::vector<sf::Uint8>, colors.size()> files;
+        std::array<sf::MemoryInputStream, colors.size()>  streams;
+        std::vector<sf::InputStream*>                     sources;
+        for (std::size_t i = 0; i < colors.size(); ++i)
+        {
+            REQUIRE(makeImage(i).saveToMemory(files[i], "png"));
+
+            // Truncate one of the files so that it fails to load
+            if (i == 4)
+                files[i].resize(files[i].size() / 2);
+
+            streams[i].open(files[i].data(), files[i].size());
+            sources.push_back(&streams[i]);
+        }
+
+        sf::ImageBatch batch(sources);
+        checkBatch(batch, 4);
+    }
+
+    SUBCASE("Errors are written by the calling thread")
+    {
+        std::vector<sf::Uint8> file;
+        REQUIRE(makeImage(0).saveToMemory(file, "png"));
+        file.resize(file.size() / 2);
+
+        sf::MemoryInputStream  stream;
+        sf::ImageBatch::Result result;
+        stream.open(file.data(), file.size());
+        sf::ImageBatch batch(std::vector<sf::InputStream*>{&stream}, 1);
+
+        // Until the result is returned, the error is kept with it
+        std::ostringstream    errors;
+        std::streambuf* const previous = sf::err().rdbuf(errors.rdbuf());
+        REQUIRE(batch.wait(result));
+        sf::err().rdbuf(previous);
+
+        CHECK(!result.success);
+        CHECK(!result.error.empty());
+        CHECK(errors.str() == result.error);
+    }
+
+    SUBCASE("Empty batch")
+    {
+        sf::ImageBatch         batch(std::vector<std::filesystem::path>{});
+        sf::ImageBatch::Result result;
+        CHECK(batch.getCount() == 0);
+        CHECK(!batch.poll(result));
+        CHECK(!batch.wait(result));
+    }
+}
@@ -0,0 +1,125 @@
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
+
+#include <doctest/doctest.h>
+
+#include <GraphicsUtil.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+TEST_CASE("sf::PixelFormat - [graphics]")
+{
+    SUBCASE("getPixelSize()")
+    {
+        CHECK(sf::getPixelSize(sf::RGBA8) == 4);
+        CHECK(sf::getPixelSize(sf::R8) == 1);
+        CHECK(sf::getPixelSize(sf::RG8) == 2);
+        CHECK(sf::getPixelSize(sf::RGB565) == 2);
+        CHECK(sf::getPixelSize(sf::RGBA4444) == 2);
+        CHECK(sf::getPixelSize(sf::RGBA16F) == 8);
+    }
+
+    SUBCASE("Conversions from RGBA8")
+    {
+        sf::Image image;
+        image.create(sf::Vector2u(3, 1), sf::Color(255, 0, 0, 255));
+        image.setPixel(sf::Vector2u(1, 0), sf::Color(0, 255, 0, 0));
+        image.setPixel(sf::Vector2u(2, 0), sf::Color(10, 20, 30, 40));
+
+        const std::vector<sf::Uint8> r8 = image.convertPixels(sf::R8);
+        REQUIRE(r8.size() == 3);
+        CHECK(r8[0] == 255);
+        CHECK(r8[1] == 0);
+        CHECK(r8[2] == 10);
+
+        const std::vector<sf::Uint8> rg8 = image.convertPixels(sf::RG8);
+        REQUIRE(rg8.size() == 6);
+        CHECK(rg8[0] == 255);
+        CHECK(rg8[1] == 0);
+        CHECK(rg8[2] == 0);
+        CHECK(rg8[3] == 255);
+        CHECK(rg8[4] == 10);
+        CHECK(rg8[5] == 20);
+
+        // Packed formats are stored as native-endian 16-bit integers
+        sf::Uint16 packed[3];
+
+        const std::vector<sf::Uint8> rgb565 = image.convertPixels(sf::RGB565);
+        REQUIRE(rgb565.size() == sizeof(packed));
+        std::memcpy(packed, rgb565.data(), sizeof(packed));
+        CHECK(packed[0] == 0xF800);
+        CHECK(packed[1] == 0x07E0);
+        CHECK(packed[2] == ((1 << 11) | (5 << 5) | 4));
+
+        const std::vector<sf::Uint8> rgba4444 = image.convertPixels(sf::RGBA4444);
+        REQUIRE(rgba4444.size() == sizeof(packed));
+        std::memcpy(packed, rgba4444.data(), sizeof(packed));
+        CHECK(packed[0] == 0xF00F);
+        CHECK(packed[1] == 0x0F00);
+        CHECK(packed[2] == 0x1122);
+
+        // Half floats: 1.0 is 0x3C00, 0.0 is 0x0000
+        const std::vector<sf::Uint8> rgba16f = image.convertPixels(sf::RGBA16F);
+        REQUIRE(rgba16f.size() == 24);
+        sf::Uint16 halves[4];
+        std::memcpy(halves, rgba16f.data(), sizeof(halves));
+        CHECK(halves[0] == 0x3C00);
+        CHECK(halves[1] == 0x0000);
+        CHECK(halves[2] == 0x0000);
+        CHECK(halves[3] == 0x3C00);
+
+        CHECK(sf::Image().convertPixels(sf::R8).empty());
+    }
+
+    SUBCASE("Conversions to RGBA8")
+    {
+        const sf::Uint8 r8[] = {0, 128, 255};
+        sf::Image       image;
+        image.create(sf::Vector2u(3, 1), r8, sf::R8);
+        REQUIRE(image.getSize() == sf::Vector2u(3, 1));
+        CHECK(image.getPixel(sf::Vector2u(0, 0)) == sf::Color(0, 0, 0, 255));
+        CHECK(image.getPixel(sf::Vector2u(1, 0)) == sf::Color(128, 0, 0, 255));
+        CHECK(image.getPixel(sf::Vector2u(2, 0)) == sf::Color(255, 0, 0, 255));
+
+        const sf::Uint8 rg8[] = {1, 2, 3, 4};
+        image.create(sf::Vector2u(1, 2), rg8, sf::RG8);
+        CHECK(image.getPixel(sf::Vector2u(0, 0)) == sf::Color(1, 2, 0, 255));
+        CHECK(image.getPixel(sf::Vector2u(0, 1)) == sf::Color(3, 4, 0, 255));
+
+        image.create(sf::Vector2u(1, 1), nullptr, sf::RGB565);
+        CHECK(image.getSize() == sf::Vector2u());
+    }
+
+    SUBCASE("Round trips")
+    {
+        // Every 8-bit component survives a conversion to half floats
+        std::vector<sf::Uint8> pixels(256 * 4);
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+            pixels[i] = static_cast<sf::Uint8>(i / 4);
+
+        sf::Image image;
+        image.create(sf::Vector2u(256, 1), pixels.data());
+
+        const std::vector<sf::Uint8> halves = image.convertPixels(sf::RGBA16F);
+        sf::Image                    converted;
+        converted.create(sf::Vector2u(256, 1), halves.data(), sf::RGBA16F);
+        const std::vector<sf::Uint8> roundTrip = converted.convertPixels(sf::RGBA8);
+        CHECK(std::equal(roundTrip.begin(), roundTrip.end(), pixels.begin(), pixels.end()));
+
+        // Every value of the packed formats survives a conversion to RGBA8
+        for (sf::PixelFormat format : {sf::RGB565, sf::RGBA4444})
+        {
+            std::vector<sf::Uint8> packed(65536 * 2);
+            for (std::size_t i = 0; i < 65536; ++i)
+            {
+                const auto value = static_cast<sf::Uint16>(i);
+                std::memcpy(&packed[i * 2], &value, sizeof(value));
+            }
+
+            converted.create(sf::Vector2u(256, 256), packed.data(), format);
+            const std::vector<sf::Uint8> packedRoundTrip = converted.convertPixels(format);
+            CHECK(std::equal(packedRoundTrip.begin(), packedRoundTrip.end(), packed.begin(), packed.end()));
+        }
+    }
+}
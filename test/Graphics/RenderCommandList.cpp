@@ -0,0 +1,87 @@
+#include <SFML/Graphics/RenderCommandList.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <doctest/doctest.h>
+
+#include <GraphicsUtil.hpp>
+#include <array>
+
+TEST_CASE("sf::RenderCommandList class - [graphics]")
+{
+    const std::array<sf::Vertex, 3> vertices;
+
+    SUBCASE("Default constructor")
+    {
+        const sf::RenderCommandList list;
+        CHECK(list.getCommandCount() == 0);
+    }
+
+    SUBCASE("Empty vertex draws are not recorded")
+    {
+        sf::RenderCommandList list;
+        list.draw(vertices.data(), 0, sf::PrimitiveType::Points);
+        list.draw(nullptr, 3, sf::PrimitiveType::Points);
+        CHECK(list.getCommandCount() == 0);
+    }
+
+    SUBCASE("Replay")
+    {
+        const DrawableSpy first;
+        const DrawableSpy second;
+
+        sf::RenderCommandList list;
+        list.draw(first, sf::RenderStates(sf::BlendAdd));
+        list.setView(sf::View({100, 200}, {50, 50}));
+        list.draw(vertices.data(), vertices.size(), sf::PrimitiveType::Triangles);
+        list.draw(second, sf::RenderStates(sf::Transform().translate({1, 2})));
+        list.clear(sf::Color::Red);
+        CHECK(list.getCommandCount() == 5);
+
+        TestRenderTarget target;
+        target.draw(list, sf::RenderStates(sf::Transform().scale({2, 2})));
+
+        // The commands are replayed in recording order, with the transform of the replay applied to the recorded ones
+        REQUIRE(target.events.size() == 4);
+
+        CHECK(target.events[0].drawable == &first);
+        CHECK(target.events[0].states.blendMode == sf::BlendAdd);
+        CHECK(target.events[0].states.transform == sf::Transform().scale({2, 2}));
+        CHECK(target.events[0].viewCenter == sf::Vector2f(320, 240));
+
+        // Vertex draw, issued with the recorded view
+        CHECK(target.events[1].drawable == nullptr);
+        CHECK(target.events[1].viewCenter == sf::Vector2f(100, 200));
+
+        CHECK(target.events[2].drawable == &second);
+        CHECK(target.events[2].states.blendMode == sf::BlendAlpha);
+        CHECK(target.events[2].states.transform == sf::Transform().scale({2, 2}).translate({1, 2}));
+        CHECK(target.events[2].viewCenter == sf::Vector2f(100, 200));
+
+        // Clear
+        CHECK(target.events[3].drawable == nullptr);
+
+        CHECK(target.getView().getCenter() == sf::Vector2f(100, 200));
+
+        SUBCASE("Replaying again gives the same commands")
+        {
+            target.setView(target.getDefaultView());
+            target.events.clear();
+            target.draw(list, sf::RenderStates(sf::Transform().scale({2, 2})));
+            REQUIRE(target.events.size() == 4);
+            CHECK(target.events[0].drawable == &first);
+            CHECK(target.events[0].viewCenter == sf::Vector2f(320, 240));
+            CHECK(target.events[2].drawable == &second);
+            CHECK(target.events[2].viewCenter == sf::Vector2f(100, 200));
+        }
+
+        SUBCASE("Reset")
+        {
+            list.reset();
+            CHECK(list.getCommandCount() == 0);
+
+            target.events.clear();
+            target.draw(list);
+            CHECK(target.events.empty());
+        }
+    }
+}
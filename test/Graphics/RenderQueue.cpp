@@ -0,0 +1,139 @@
+#include <SFML/Graphics/RenderQueue.hpp>
+
+#include <doctest/doctest.h>
+
+#include <GraphicsUtil.hpp>
+#include <array>
+#include <vector>
+
+namespace
+{
+// Check the drawables drawn by a queue, in drawing order; vertex draws are expected as null
+bool isDrawnInOrder(const sf::RenderQueue& queue, const std::vector<const sf::Drawable*>& expected)
+{
+    TestRenderTarget target;
+    target.draw(queue);
+
+    std::vector<const sf::Drawable*> order;
+    for (const TestRenderTarget::Event& event : target.events)
+        order.push_back(event.drawable);
+
+    return order == expected;
+}
+} // namespace
+
+TEST_CASE("sf::RenderQueue class - [graphics]")
+{
+    const std::array<sf::Vertex, 3> vertices;
+
+    // Textures and shaders are only compared by address, these never-dereferenced pointers stand for them
+    const std::array<unsigned char, 2> storage{};
+    const auto*                        firstTexture  = reinterpret_cast<const sf::Texture*>(&storage[0]);
+    const auto*                        secondTexture = reinterpret_cast<const sf::Texture*>(&storage[1]);
+    const auto*                        shader        = reinterpret_cast<const sf::Shader*>(&storage[0]);
+
+    const DrawableSpy a;
+    const DrawableSpy b;
+    const DrawableSpy c;
+    const DrawableSpy d;
+    const DrawableSpy e;
+
+    SUBCASE("Default constructor")
+    {
+        const sf::RenderQueue queue;
+        CHECK(queue.getSubmissionCount() == 0);
+        CHECK(!queue.isSubmissionOrderPreserved(0));
+        CHECK(isDrawnInOrder(queue, {}));
+    }
+
+    SUBCASE("Submission")
+    {
+        sf::RenderQueue queue;
+        queue.submit(a);
+        queue.submit(b, sf::RenderStates(sf::BlendAdd), 1, 0.5f);
+        queue.submit(vertices.data(), vertices.size(), sf::PrimitiveType::Triangles, sf::RenderStates::Default, -1);
+        CHECK(queue.getSubmissionCount() == 3);
+
+        SUBCASE("Empty vertex draws are not submitted")
+        {
+            queue.submit(vertices.data(), 0, sf::PrimitiveType::Points);
+            queue.submit(nullptr, 3, sf::PrimitiveType::Points);
+            CHECK(queue.getSubmissionCount() == 3);
+        }
+
+        SUBCASE("Clear")
+        {
+            queue.setSubmissionOrderPreserved(1, true);
+            queue.clear();
+            CHECK(queue.getSubmissionCount() == 0);
+            CHECK(queue.isSubmissionOrderPreserved(1));
+            CHECK(isDrawnInOrder(queue, {}));
+        }
+    }
+
+    SUBCASE("Draws are sorted by layer")
+    {
+        sf::RenderQueue queue;
+        queue.submit(a, sf::RenderStates::Default, 2);
+        queue.submit(b, sf::RenderStates::Default, -1);
+        queue.submit(vertices.data(), vertices.size(), sf::PrimitiveType::Triangles, sf::RenderStates::Default, 1);
+        queue.submit(c, sf::RenderStates::Default, 0);
+        CHECK(isDrawnInOrder(queue, {&b, &c, nullptr, &a}));
+    }
+
+    SUBCASE("Draws are grouped by shader, texture and blend mode within a layer")
+    {
+        sf::RenderQueue queue;
+        queue.submit(a, sf::RenderStates(secondTexture));
+        queue.submit(b, sf::RenderStates(sf::BlendAdd, sf::Transform::Identity, firstTexture, nullptr));
+        queue.submit(c, sf::RenderStates(shader));
+        queue.submit(d, sf::RenderStates(firstTexture));
+        queue.submit(e, sf::RenderStates(sf::BlendAdd, sf::Transform::Identity, firstTexture, nullptr));
+
+        // No shader first, then textures by address; blend modes are ordered by first appearance in the queue
+        CHECK(isDrawnInOrder(queue, {&d, &b, &e, &a, &c}));
+    }
+
+    SUBCASE("Draws with the same states are sorted by depth, then by submission order")
+    {
+        sf::RenderQueue queue;
+        queue.submit(a, sf::RenderStates::Default, 0, 2.f);
+        queue.submit(b, sf::RenderStates::Default, 0, 1.f);
+        queue.submit(c, sf::RenderStates::Default, 0, 2.f);
+        queue.submit(d, sf::RenderStates::Default, 0, -1.f);
+        CHECK(isDrawnInOrder(queue, {&d, &b, &a, &c}));
+    }
+
+    SUBCASE("Submission order")
+    {
+        sf::RenderQueue queue;
+        queue.setSubmissionOrderPreserved(2, true);
+        CHECK(queue.isSubmissionOrderPreserved(2));
+        CHECK(!queue.isSubmissionOrderPreserved(1));
+
+        queue.setSubmissionOrderPreserved(2, true);
+        queue.setSubmissionOrderPreserved(2, false);
+        CHECK(!queue.isSubmissionOrderPreserved(2));
+
+        queue.submit(a, sf::RenderStates(secondTexture), 1, 3.f);
+        queue.submit(b, sf::RenderStates(firstTexture), 1, 2.f);
+        queue.submit(c, sf::RenderStates(secondTexture), 1, 1.f);
+        queue.submit(d, sf::RenderStates::Default, 0);
+        CHECK(isDrawnInOrder(queue, {&d, &b, &c, &a}));
+
+        // Preserved layers are still drawn in layer order, but their draws are not reordered
+        queue.setSubmissionOrderPreserved(1, true);
+        CHECK(isDrawnInOrder(queue, {&d, &a, &b, &c}));
+    }
+
+    SUBCASE("Transform")
+    {
+        sf::RenderQueue queue;
+        queue.submit(a, sf::RenderStates(sf::Transform().translate({1, 2})));
+
+        TestRenderTarget target;
+        target.draw(queue, sf::RenderStates(sf::Transform().scale({2, 2})));
+        REQUIRE(target.events.size() == 1);
+        CHECK(target.events[0].states.transform == sf::Transform().scale({2, 2}).translate({1, 2}));
+    }
+}
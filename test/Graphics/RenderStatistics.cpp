@@ -0,0 +1,92 @@
+#include <SFML/Graphics/RenderStatistics.hpp>
+
+#include <doctest/doctest.h>
+
+#include <GraphicsUtil.hpp>
+
+TEST_CASE("sf::RenderStatistics class - [graphics]")
+{
+    SUBCASE("Construction")
+    {
+        const sf::RenderStatistics statistics;
+        CHECK(statistics.drawCalls == 0);
+        CHECK(statistics.vertices == 0);
+        CHECK(statistics.textureBinds == 0);
+        CHECK(statistics.shaderBinds == 0);
+        CHECK(statistics.blendModeChanges == 0);
+        CHECK(statistics.viewChanges == 0);
+        CHECK(statistics.vertexCacheHits == 0);
+        CHECK(statistics.vertexCacheMisses == 0);
+        CHECK(statistics.culledDraws == 0);
+        CHECK(statistics.textureUploadBytes == 0);
+        CHECK(statistics.bufferUploadBytes == 0);
+    }
+
+    SUBCASE("Accounting")
+    {
+        // Culled draws are counted without reaching OpenGL, which makes them testable without a context
+        const DrawableSpy visible(sf::FloatRect({10, 10}, {20, 20}));
+        const DrawableSpy hidden(sf::FloatRect({1000, 1000}, {20, 20}));
+
+        TestRenderTarget target;
+        target.setCullingEnabled(true);
+        CHECK(!target.isStatisticsEnabled());
+
+        SUBCASE("Disabled statistics are not counted")
+        {
+            target.draw(hidden);
+            target.endFrame();
+            CHECK(target.getStatistics().culledDraws == 0);
+        }
+
+        SUBCASE("Counters of the last complete frame")
+        {
+            target.setStatisticsEnabled(true);
+            CHECK(target.isStatisticsEnabled());
+
+            target.draw(visible);
+            target.draw(hidden);
+            target.draw(hidden);
+            REQUIRE(target.events.size() == 1);
+
+            // The frame is not complete yet
+            CHECK(target.getStatistics().culledDraws == 0);
+
+            target.endFrame();
+            CHECK(target.getStatistics().culledDraws == 2);
+            CHECK(target.getStatistics().drawCalls == 0);
+            CHECK(target.getStatistics().textureUploadBytes == 0);
+            CHECK(target.getStatistics().bufferUploadBytes == 0);
+
+            // The counters start again from zero at each frame
+            target.draw(hidden);
+            CHECK(target.getStatistics().culledDraws == 2);
+            target.endFrame();
+            CHECK(target.getStatistics().culledDraws == 1);
+            target.endFrame();
+            CHECK(target.getStatistics().culledDraws == 0);
+        }
+
+        SUBCASE("Reset")
+        {
+            target.setStatisticsEnabled(true);
+            target.draw(hidden);
+            target.resetStatistics();
+            target.draw(hidden);
+            target.endFrame();
+            CHECK(target.getStatistics().culledDraws == 1);
+        }
+
+        SUBCASE("Disabling keeps the last counters")
+        {
+            target.setStatisticsEnabled(true);
+            target.draw(hidden);
+            target.endFrame();
+
+            target.setStatisticsEnabled(false);
+            target.draw(hidden);
+            target.endFrame();
+            CHECK(target.getStatistics().culledDraws == 1);
+        }
+    }
+}
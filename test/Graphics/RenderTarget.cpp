@@ -0,0 +1,326 @@
+#include <SFML/Graphics/RenderTarget.hpp>
+
+// Other 1st party headers
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <doctest/doctest.h>
+
+#include <GraphicsUtil.hpp>
+#include <array>
+#include <vector>
+
+namespace
+{
+// Get the drawables drawn to a test target, in drawing order
+std::vector<const sf::Drawable*> getDrawnDrawables(const TestRenderTarget& target)
+{
+    std::vector<const sf::Drawable*> drawables;
+    for (const TestRenderTarget::Event& event : target.events)
+    {
+        if (event.drawable)
+            drawables.push_back(event.drawable);
+    }
+
+    return drawables;
+}
+} // namespace
+
+TEST_CASE("sf::RenderTarget class - [graphics]")
+{
+    SUBCASE("Batching")
+    {
+        // Batches are submitted when they are flushed, each submission activates the target
+        const std::array<sf::Vertex, 4> vertices;
+        TestRenderTarget                target;
+        CHECK(!target.isBatchingEnabled());
+
+        const auto draw = [&](sf::PrimitiveType type, const sf::RenderStates& states = sf::RenderStates::Default)
+        { target.draw(vertices.data(), vertices.size(), type, states); };
+
+        SUBCASE("Disabled")
+        {
+            draw(sf::PrimitiveType::Triangles);
+            draw(sf::PrimitiveType::Triangles);
+            CHECK(target.events.size() == 2);
+
+            target.endFrame();
+            CHECK(target.getBatchFlushCount() == 0);
+        }
+
+        SUBCASE("Compatible draws are merged")
+        {
+            target.setBatchingEnabled(true);
+            CHECK(target.isBatchingEnabled());
+
+            // Vertices are pre-transformed, the transform doesn't break the batch
+            draw(sf::PrimitiveType::Triangles);
+            draw(sf::PrimitiveType::Triangles, sf::RenderStates(sf::Transform().translate({10, 10})));
+            draw(sf::PrimitiveType::Triangles);
+            CHECK(target.events.empty());
+
+            target.flush();
+            CHECK(target.events.size() == 1);
+
+            // Nothing is pending anymore
+            target.flush();
+            CHECK(target.events.size() == 1);
+
+            target.endFrame();
+            CHECK(target.getBatchFlushCount() == 1);
+        }
+
+        SUBCASE("Incompatible states flush the batch")
+        {
+            // Textures are compared by their cache identifier, shaders by address only
+            const sf::Texture                  texture;
+            const std::array<unsigned char, 1> storage{};
+            const auto*                        shader = reinterpret_cast<const sf::Shader*>(&storage[0]);
+
+            target.setBatchingEnabled(true);
+            draw(sf::PrimitiveType::Triangles);
+            draw(sf::PrimitiveType::Triangles, sf::RenderStates(&texture));
+            CHECK(target.events.size() == 1);
+            draw(sf::PrimitiveType::Triangles, sf::RenderStates(shader));
+            CHECK(target.events.size() == 2);
+            draw(sf::PrimitiveType::Triangles, sf::RenderStates(sf::BlendAdd));
+            CHECK(target.events.size() == 3);
+            draw(sf::PrimitiveType::Points, sf::RenderStates(sf::BlendAdd));
+            CHECK(target.events.size() == 4);
+
+            target.endFrame();
+            CHECK(target.events.size() == 5);
+            CHECK(target.getBatchFlushCount() == 5);
+        }
+
+        SUBCASE("Strips and fans are converted to lists")
+        {
+            target.setBatchingEnabled(true);
+            draw(sf::PrimitiveType::Triangles);
+            draw(sf::PrimitiveType::TriangleStrip);
+            draw(sf::PrimitiveType::TriangleFan);
+            draw(sf::PrimitiveType::Triangles);
+            CHECK(target.events.empty());
+
+            draw(sf::PrimitiveType::LineStrip);
+            draw(sf::PrimitiveType::Lines);
+            CHECK(target.events.size() == 1);
+
+            target.endFrame();
+            CHECK(target.getBatchFlushCount() == 2);
+        }
+
+        SUBCASE("View changes flush the batch")
+        {
+            target.setBatchingEnabled(true);
+            draw(sf::PrimitiveType::Triangles);
+
+            // The batch is drawn with the view it was issued with
+            sf::View view = target.getView();
+            view.move({100, 100});
+            target.setView(view);
+            REQUIRE(target.events.size() == 1);
+            CHECK(target.events[0].viewCenter == target.getDefaultView().getCenter());
+        }
+
+        SUBCASE("Clearing flushes the batch")
+        {
+            target.setBatchingEnabled(true);
+            draw(sf::PrimitiveType::Triangles);
+
+            // The batch is submitted, then the target is activated again for the clear
+            target.clear();
+            CHECK(target.events.size() == 2);
+            target.endFrame();
+            CHECK(target.getBatchFlushCount() == 1);
+        }
+
+        SUBCASE("Ending the frame flushes the batch")
+        {
+            target.setBatchingEnabled(true);
+            draw(sf::PrimitiveType::Triangles);
+            target.endFrame();
+            CHECK(target.events.size() == 1);
+            CHECK(target.getBatchFlushCount() == 1);
+
+            // The count restarts with each frame
+            target.endFrame();
+            CHECK(target.getBatchFlushCount() == 0);
+        }
+
+        SUBCASE("Disabling flushes the batch")
+        {
+            target.setBatchingEnabled(true);
+            draw(sf::PrimitiveType::Triangles);
+            target.setBatchingEnabled(false);
+            CHECK(target.events.size() == 1);
+        }
+    }
+
+    SUBCASE("Damage tracking")
+    {
+        TestRenderTarget target;
+        CHECK(!target.isDamageTrackingEnabled());
+
+        SUBCASE("Disabled")
+        {
+            target.markDirty(sf::IntRect({10, 10}, {20, 20}));
+            CHECK(!target.getFrameDamage().has_value());
+        }
+
+        SUBCASE("Enabling marks the whole target dirty")
+        {
+            target.setDamageTrackingEnabled(true);
+            CHECK(target.isDamageTrackingEnabled());
+            CHECK(target.getFrameDamage() == sf::IntRect({0, 0}, {640, 480}));
+
+            target.endFrame();
+            CHECK(!target.getFrameDamage().has_value());
+        }
+
+        SUBCASE("Dirty regions")
+        {
+            target.setDamageTrackingEnabled(true);
+            target.endFrame();
+
+            target.markDirty(sf::IntRect({10, 10}, {20, 20}));
+            CHECK(target.getFrameDamage() == sf::IntRect({10, 10}, {20, 20}));
+
+            // The damage of a frame is the smallest rectangle containing all its dirty regions
+            target.markDirty(sf::IntRect({100, 50}, {10, 10}));
+            CHECK(target.getFrameDamage() == sf::IntRect({10, 10}, {100, 50}));
+        }
+
+        SUBCASE("Dirty regions are clamped to the target")
+        {
+            target.setDamageTrackingEnabled(true);
+            target.endFrame();
+
+            target.markDirty(sf::IntRect({1000, 1000}, {10, 10}));
+            CHECK(!target.getFrameDamage().has_value());
+
+            target.markDirty(sf::IntRect({-10, 470}, {30, 30}));
+            CHECK(target.getFrameDamage() == sf::IntRect({0, 470}, {20, 10}));
+
+            // Huge bounds must not overflow when converted to pixels
+            const DrawableSpy huge(sf::FloatRect({-1e20f, -1e20f}, {2e20f, 2e20f}));
+            target.markDirty(huge);
+            CHECK(target.getFrameDamage() == sf::IntRect({0, 0}, {640, 480}));
+        }
+
+        SUBCASE("Drawable areas")
+        {
+            // A size whose inverse is exact in floating point keeps the mapping free of rounding errors
+            TestRenderTarget exact({512, 256});
+            exact.setDamageTrackingEnabled(true);
+            exact.endFrame();
+
+            // Drawables without bounds cover the whole target
+            const DrawableSpy unbounded;
+            exact.markDirty(unbounded);
+            CHECK(exact.getFrameDamage() == sf::IntRect({0, 0}, {512, 256}));
+            exact.endFrame();
+
+            // Areas are rounded outwards, with a margin of one pixel
+            const DrawableSpy drawable(sf::FloatRect({10, 20}, {20, 10}));
+            exact.markDirty(drawable);
+            CHECK(exact.getFrameDamage() == sf::IntRect({9, 19}, {22, 12}));
+            exact.endFrame();
+
+            exact.markDirty(drawable, sf::Transform().translate({100, 50}));
+            CHECK(exact.getFrameDamage() == sf::IntRect({109, 69}, {22, 12}));
+            exact.endFrame();
+
+            // Areas are mapped with the current view
+            exact.setView(sf::View(sf::FloatRect({64, 64}, {256, 128})));
+            const DrawableSpy zoomed(sf::FloatRect({74, 84}, {20, 10}));
+            exact.markDirty(zoomed);
+            CHECK(exact.getFrameDamage() == sf::IntRect({19, 39}, {42, 22}));
+            exact.endFrame();
+
+            sf::View view = exact.getDefaultView();
+            view.setViewport(sf::FloatRect({0.5f, 0.5f}, {0.5f, 0.5f}));
+            exact.setView(view);
+            const DrawableSpy viewported(sf::FloatRect({0, 0}, {64, 32}));
+            exact.markDirty(viewported);
+            CHECK(exact.getFrameDamage() == sf::IntRect({255, 127}, {34, 18}));
+        }
+
+        SUBCASE("Repaint area")
+        {
+            // Draws outside of the repaint area are culled once the frame has started
+            const DrawableSpy first(sf::FloatRect({0, 0}, {10, 10}));
+            const DrawableSpy second(sf::FloatRect({100, 0}, {10, 10}));
+            const DrawableSpy third(sf::FloatRect({200, 0}, {10, 10}));
+            const DrawableSpy fourth(sf::FloatRect({300, 0}, {10, 10}));
+            const DrawableSpy unchanged(sf::FloatRect({500, 400}, {10, 10}));
+
+            const auto drawFrame = [&](unsigned int age)
+            {
+                target.events.clear();
+                target.backBufferAge = age;
+                target.clear();
+
+                for (const DrawableSpy* drawable : {&first, &second, &third, &fourth, &unchanged})
+                    target.draw(*drawable);
+
+                return getDrawnDrawables(target);
+            };
+
+            // Remember a different dirty region for each of the last frames, the most recent being the fourth
+            target.setDamageTrackingEnabled(true);
+            target.endFrame();
+            for (const DrawableSpy* drawable : {&first, &second, &third, &fourth})
+            {
+                target.markDirty(*drawable);
+                target.endFrame();
+            }
+
+            SUBCASE("Undefined contents")
+            {
+                CHECK(drawFrame(0) == std::vector<const sf::Drawable*>{&first, &second, &third, &fourth, &unchanged});
+            }
+
+            SUBCASE("Previous frame")
+            {
+                // Nothing changed since the contents of the back buffer were presented
+                CHECK(drawFrame(1).empty());
+            }
+
+            SUBCASE("Previous frame with dirty regions")
+            {
+                target.markDirty(first);
+                CHECK(drawFrame(1) == std::vector<const sf::Drawable*>{&first});
+            }
+
+            SUBCASE("Older frames")
+            {
+                // The damage of the frames presented since the back buffer was drawn is repainted
+                CHECK(drawFrame(2) == std::vector<const sf::Drawable*>{&fourth});
+            }
+
+            SUBCASE("Union of older frames")
+            {
+                CHECK(drawFrame(3) == std::vector<const sf::Drawable*>{&third, &fourth});
+            }
+
+            SUBCASE("Oldest remembered frame")
+            {
+                CHECK(drawFrame(5) == std::vector<const sf::Drawable*>{&first, &second, &third, &fourth});
+            }
+
+            SUBCASE("Beyond the history")
+            {
+                CHECK(drawFrame(6) == std::vector<const sf::Drawable*>{&first, &second, &third, &fourth, &unchanged});
+            }
+
+            SUBCASE("Dirty regions marked during the frame")
+            {
+                CHECK(drawFrame(1).empty());
+                target.markDirty(unchanged);
+                target.draw(unchanged);
+                CHECK(getDrawnDrawables(target) == std::vector<const sf::Drawable*>{&unchanged});
+            }
+        }
+    }
+}
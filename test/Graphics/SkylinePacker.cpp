@@ -0,0 +1,90 @@
+#include <SFML/Graphics/SkylinePacker.hpp>
+
+#include <doctest/doctest.h>
+
+#include <GraphicsUtil.hpp>
+#include <optional>
+
+namespace
+{
+// Check that a rectangle is placed at the expected position
+bool isInsertedAt(sf::priv::SkylinePacker& packer, const sf::Vector2u& size, const sf::Vector2u& position)
+{
+    const std::optional<sf::Vector2u> result = packer.insert(size);
+    return result.has_value() && (*result == position);
+}
+} // namespace
+
+TEST_CASE("sf::priv::SkylinePacker class - [graphics]")
+{
+    SUBCASE("Construction")
+    {
+        const sf::priv::SkylinePacker packer({100, 50});
+        CHECK(packer.getSize() == sf::Vector2u(100, 50));
+        CHECK(packer.getUsedHeight() == 0);
+    }
+
+    SUBCASE("Placement")
+    {
+        sf::priv::SkylinePacker packer({100, 100});
+
+        // Each rectangle goes where it stays the closest to the top
+        CHECK(isInsertedAt(packer, {30, 20}, {0, 0}));
+        CHECK(isInsertedAt(packer, {50, 10}, {30, 0}));
+        CHECK(isInsertedAt(packer, {30, 30}, {30, 10}));
+        CHECK(isInsertedAt(packer, {20, 50}, {80, 0}));
+        CHECK(packer.getUsedHeight() == 50);
+
+        // A rectangle spanning several segments rests on the highest one
+        CHECK(isInsertedAt(packer, {70, 5}, {0, 40}));
+        CHECK(packer.getUsedHeight() == 50);
+    }
+
+    SUBCASE("Leftmost position on ties")
+    {
+        sf::priv::SkylinePacker packer({100, 100});
+        CHECK(isInsertedAt(packer, {50, 10}, {0, 0}));
+        CHECK(isInsertedAt(packer, {50, 10}, {50, 0}));
+        CHECK(isInsertedAt(packer, {10, 10}, {0, 10}));
+    }
+
+    SUBCASE("Find without reserving")
+    {
+        sf::priv::SkylinePacker packer({100, 100});
+        REQUIRE(packer.find({10, 10}).has_value());
+        CHECK(*packer.find({10, 10}) == sf::Vector2u(0, 0));
+        CHECK(packer.getUsedHeight() == 0);
+
+        CHECK(isInsertedAt(packer, {10, 10}, {0, 0}));
+        REQUIRE(packer.find({10, 10}).has_value());
+        CHECK(*packer.find({10, 10}) == sf::Vector2u(10, 0));
+    }
+
+    SUBCASE("Fill")
+    {
+        // Equal squares fill the area row by row, without any hole
+        sf::priv::SkylinePacker packer({64, 64});
+        for (unsigned int i = 0; i < 16; ++i)
+            CHECK(isInsertedAt(packer, {16, 16}, {(i % 4) * 16, (i / 4) * 16}));
+
+        CHECK(packer.getUsedHeight() == 64);
+        CHECK(!packer.find({1, 1}).has_value());
+        CHECK(!packer.insert({1, 1}).has_value());
+
+        packer.reset({64, 32});
+        CHECK(packer.getSize() == sf::Vector2u(64, 32));
+        CHECK(packer.getUsedHeight() == 0);
+        CHECK(isInsertedAt(packer, {64, 32}, {0, 0}));
+        CHECK(!packer.insert({1, 1}).has_value());
+    }
+
+    SUBCASE("Invalid sizes")
+    {
+        sf::priv::SkylinePacker packer({100, 100});
+        CHECK(!packer.insert({0, 10}).has_value());
+        CHECK(!packer.insert({10, 0}).has_value());
+        CHECK(!packer.insert({101, 10}).has_value());
+        CHECK(!packer.find({10, 101}).has_value());
+        CHECK(packer.getUsedHeight() == 0);
+    }
+}
@@ -0,0 +1,171 @@
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+
+#include <doctest/doctest.h>
+
+#include <GraphicsUtil.hpp>
+#include <cmath>
+
+namespace
+{
+// Check the two triangles of an instance against the corners of a sf::Sprite with the same transform
+void checkQuad(const sf::SpriteBatch&   batch,
+               std::size_t              index,
+               const sf::Transformable& transformable,
+               const sf::FloatRect&     textureRect)
+{
+    const sf::SpriteBatch::Instance& instance  = batch.getInstance(index);
+    const sf::Vertex*                vertices  = batch.getVertices() + index * 6;
+    const sf::Transform&             transform = transformable.getTransform();
+
+    const float width  = std::abs(textureRect.width);
+    const float height = std::abs(textureRect.height);
+    const float left   = textureRect.left;
+    const float top    = textureRect.top;
+    const float right  = textureRect.left + textureRect.width;
+    const float bottom = textureRect.top + textureRect.height;
+
+    const sf::Vector2f positions[4] = {transform.transformPoint({0, 0}),
+                                       transform.transformPoint({0, height}),
+                                       transform.transformPoint({width, 0}),
+                                       transform.transformPoint({width, height})};
+    const sf::Vector2f texCoords[4] = {{left, top}, {left, bottom}, {right, top}, {right, bottom}};
+    const std::size_t  corners[6]   = {0, 1, 2, 2, 1, 3};
+
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+        CHECK(vertices[i].position == Approx(positions[corners[i]]));
+        CHECK(vertices[i].texCoords == texCoords[corners[i]]);
+        CHECK(vertices[i].color == instance.color);
+    }
+}
+} // namespace
+
+TEST_CASE("sf::SpriteBatch class - [graphics]")
+{
+    SUBCASE("Instance")
+    {
+        SUBCASE("Default constructor")
+        {
+            const sf::SpriteBatch::Instance instance;
+            CHECK(instance.position == sf::Vector2f(0, 0));
+            CHECK(instance.origin == sf::Vector2f(0, 0));
+            CHECK(instance.rotation == sf::Angle::Zero);
+            CHECK(instance.scale == sf::Vector2f(1, 1));
+            CHECK(instance.textureRect == sf::IntRect());
+            CHECK(instance.color == sf::Color::White);
+        }
+
+        SUBCASE("Position and texture rectangle constructor")
+        {
+            const sf::SpriteBatch::Instance instance({3, 4}, {{1, 2}, {5, 6}}, sf::Color::Red);
+            CHECK(instance.position == sf::Vector2f(3, 4));
+            CHECK(instance.origin == sf::Vector2f(0, 0));
+            CHECK(instance.rotation == sf::Angle::Zero);
+            CHECK(instance.scale == sf::Vector2f(1, 1));
+            CHECK(instance.textureRect == sf::IntRect({1, 2}, {5, 6}));
+            CHECK(instance.color == sf::Color::Red);
+        }
+    }
+
+    SUBCASE("Default constructor")
+    {
+        const sf::SpriteBatch batch;
+        CHECK(batch.getTexture() == nullptr);
+        CHECK(batch.getInstanceCount() == 0);
+        CHECK(batch.getBounds() == sf::FloatRect());
+    }
+
+    SUBCASE("Append instances")
+    {
+        sf::SpriteBatch batch;
+        batch.append(sf::SpriteBatch::Instance({10, 20}, {{0, 0}, {16, 8}}, sf::Color::Red));
+        batch.append(sf::SpriteBatch::Instance({30, 40}, {{16, 0}, {4, 4}}, sf::Color::Blue));
+        REQUIRE(batch.getInstanceCount() == 2);
+
+        sf::Transformable first;
+        first.setPosition({10, 20});
+        checkQuad(batch, 0, first, {{0, 0}, {16, 8}});
+
+        sf::Transformable second;
+        second.setPosition({30, 40});
+        checkQuad(batch, 1, second, {{16, 0}, {4, 4}});
+
+        CHECK(batch.getBounds() == sf::FloatRect({10, 20}, {24, 24}));
+    }
+
+    SUBCASE("Transformed instance")
+    {
+        sf::SpriteBatch::Instance instance({100, 50}, {{8, 8}, {32, 16}}, sf::Color(10, 20, 30, 40));
+        instance.origin   = {16, 8};
+        instance.rotation = sf::degrees(30);
+        instance.scale    = {2, 0.5f};
+
+        sf::SpriteBatch batch;
+        batch.append(instance);
+
+        sf::Transformable transformable;
+        transformable.setPosition(instance.position);
+        transformable.setOrigin(instance.origin);
+        transformable.setRotation(instance.rotation);
+        transformable.setScale(instance.scale);
+        checkQuad(batch, 0, transformable, {{8, 8}, {32, 16}});
+    }
+
+    SUBCASE("Flipped texture rectangle")
+    {
+        sf::SpriteBatch batch;
+        batch.append(sf::SpriteBatch::Instance({0, 0}, {{16, 0}, {-16, 8}}));
+
+        checkQuad(batch, 0, sf::Transformable(), {{16, 0}, {-16, 8}});
+        CHECK(batch.getBounds() == sf::FloatRect({0, 0}, {16, 8}));
+    }
+
+    SUBCASE("Set instances")
+    {
+        sf::SpriteBatch batch;
+        batch.resize(3);
+        REQUIRE(batch.getInstanceCount() == 3);
+
+        const sf::SpriteBatch::Instance instances[2] = {sf::SpriteBatch::Instance({1, 2}, {{0, 0}, {2, 2}}),
+                                                        sf::SpriteBatch::Instance({5, 6}, {{2, 2}, {3, 3}})};
+        batch.setInstances(1, instances, 2);
+        CHECK(batch.getInstance(1).position == sf::Vector2f(1, 2));
+        CHECK(batch.getInstance(2).position == sf::Vector2f(5, 6));
+
+        // Default instances have an empty texture rectangle, they are drawn as degenerate quads
+        checkQuad(batch, 0, sf::Transformable(), {});
+
+        sf::Transformable second;
+        second.setPosition({5, 6});
+        checkQuad(batch, 2, second, {{2, 2}, {3, 3}});
+        CHECK(batch.getBounds() == sf::FloatRect({0, 0}, {8, 9}));
+
+        sf::SpriteBatch::Instance moved = batch.getInstance(2);
+        moved.position                  = {7, 8};
+        moved.color                     = sf::Color::Green;
+        batch.setInstance(2, moved);
+        second.setPosition({7, 8});
+        checkQuad(batch, 2, second, {{2, 2}, {3, 3}});
+        CHECK(batch.getBounds() == sf::FloatRect({0, 0}, {10, 11}));
+    }
+
+    SUBCASE("Resize and clear")
+    {
+        sf::SpriteBatch batch;
+        batch.append(sf::SpriteBatch::Instance({1, 2}, {{0, 0}, {2, 2}}));
+        batch.append(sf::SpriteBatch::Instance({3, 4}, {{0, 0}, {2, 2}}));
+        CHECK(batch.getBounds() == sf::FloatRect({1, 2}, {4, 4}));
+
+        batch.resize(1);
+        CHECK(batch.getInstanceCount() == 1);
+        CHECK(batch.getBounds() == sf::FloatRect({1, 2}, {2, 2}));
+
+        batch.clear();
+        CHECK(batch.getInstanceCount() == 0);
+        CHECK(batch.getBounds() == sf::FloatRect());
+
+        batch.append(sf::SpriteBatch::Instance({5, 6}, {{0, 0}, {1, 1}}));
+        CHECK(batch.getBounds() == sf::FloatRect({5, 6}, {1, 1}));
+    }
+}
@@ -0,0 +1,107 @@
+#include <SFML/Graphics/VertexArena.hpp>
+
+#include <doctest/doctest.h>
+
+#include <GraphicsUtil.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+TEST_CASE("sf::VertexArena class - [graphics]")
+{
+    SUBCASE("Construction")
+    {
+        SUBCASE("Default constructor")
+        {
+            const sf::VertexArena arena;
+            CHECK(arena.getVertexCount() == 0);
+            CHECK(arena.getCapacity() == 0);
+            CHECK(arena.getPrimitiveType() == sf::PrimitiveType::Points);
+        }
+
+        SUBCASE("Explicit constructor")
+        {
+            const sf::VertexArena arena(sf::PrimitiveType::Triangles, 30);
+            CHECK(arena.getVertexCount() == 0);
+            CHECK(arena.getCapacity() == 30);
+            CHECK(arena.getPrimitiveType() == sf::PrimitiveType::Triangles);
+        }
+    }
+
+    SUBCASE("Allocation")
+    {
+        sf::VertexArena arena(sf::PrimitiveType::Triangles, 10);
+
+        sf::Vertex* first = arena.allocate(6);
+        REQUIRE(first != nullptr);
+        CHECK(first == arena.getVertices());
+        CHECK(arena.getVertexCount() == 6);
+
+        sf::Vertex* second = arena.allocate(3);
+        CHECK(second == first + 6);
+        CHECK(arena.getVertexCount() == 9);
+
+        SUBCASE("Exceeding the capacity fails without side effect")
+        {
+            CHECK(arena.allocate(3) == nullptr);
+            CHECK(arena.getVertexCount() == 9);
+            CHECK(arena.allocate(1) != nullptr);
+            CHECK(arena.getVertexCount() == 10);
+        }
+
+        SUBCASE("Clear")
+        {
+            arena.clear();
+            CHECK(arena.getVertexCount() == 0);
+            CHECK(arena.getCapacity() == 10);
+            CHECK(arena.allocate(10) == arena.getVertices());
+        }
+
+        SUBCASE("Shrink capacity")
+        {
+            arena.setCapacity(4);
+            CHECK(arena.getVertexCount() == 4);
+            CHECK(arena.getCapacity() == 4);
+        }
+    }
+
+    SUBCASE("Concurrent allocation")
+    {
+        constexpr std::size_t threadCount     = 8;
+        constexpr std::size_t rangesPerThread = 100;
+        constexpr std::size_t rangeSize       = 6;
+
+        sf::VertexArena arena(sf::PrimitiveType::Triangles, threadCount * rangesPerThread * rangeSize);
+
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back(
+                [&arena, t]
+                {
+                    for (std::size_t i = 0; i < rangesPerThread; ++i)
+                    {
+                        sf::Vertex* vertices = arena.allocate(rangeSize);
+                        for (std::size_t v = 0; v < rangeSize; ++v)
+                            vertices[v].position = sf::Vector2f(static_cast<float>(t), static_cast<float>(i));
+                    }
+                });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        CHECK(arena.getVertexCount() == arena.getCapacity());
+        CHECK(arena.allocate(1) == nullptr);
+
+        // Every range must have been written by a single thread
+        const sf::Vertex* vertices = arena.getVertices();
+        for (std::size_t r = 0; r < threadCount * rangesPerThread; ++r)
+        {
+            const sf::Vertex* range = vertices + r * rangeSize;
+            CHECK(std::all_of(range,
+                              range + rangeSize,
+                              [range](const sf::Vertex& vertex) { return vertex.position == range[0].position; }));
+        }
+    }
+}
@@ -1,6 +1,7 @@
 #include <SFML/Graphics/BlendMode.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/View.hpp>
 
 #include <GraphicsUtil.hpp>
 #include <ostream>
@@ -47,3 +48,41 @@ bool operator==(const sf::Transform& lhs, const Approx<sf::Transform>& rhs)
            lhs.getMatrix()[7] == Approx(rhs.value.getMatrix()[7]) &&
            lhs.getMatrix()[15] == Approx(rhs.value.getMatrix()[15]);
 }
+
+TestRenderTarget::TestRenderTarget(const sf::Vector2u& size) : backBufferAge(0), m_size(size)
+{
+    initialize();
+}
+
+sf::Vector2u TestRenderTarget::getSize() const
+{
+    return m_size;
+}
+
+bool TestRenderTarget::setActive(bool active)
+{
+    if (active)
+        events.push_back({nullptr, sf::RenderStates::Default, getView().getCenter()});
+
+    return false;
+}
+
+unsigned int TestRenderTarget::getBackBufferAge() const
+{
+    return backBufferAge;
+}
+
+DrawableSpy::DrawableSpy(const std::optional<sf::FloatRect>& bounds) : m_bounds(bounds)
+{
+}
+
+void DrawableSpy::draw(sf::RenderTarget& target, const sf::RenderStates& states) const
+{
+    if (auto* testTarget = dynamic_cast<TestRenderTarget*>(&target))
+        testTarget->events.push_back({this, states, target.getView().getCenter()});
+}
+
+std::optional<sf::FloatRect> DrawableSpy::getCullingBounds() const
+{
+    return m_bounds;
+}
@@ -6,11 +6,16 @@
 #ifndef SFML_TESTUTILITIES_GRAPHICS_HPP
 #define SFML_TESTUTILITIES_GRAPHICS_HPP
 
+#include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
 
 #include <WindowUtil.hpp>
 #include <iomanip>
 #include <limits>
+#include <optional>
+#include <vector>
 
 namespace sf
 {
@@ -35,4 +40,54 @@ std::ostream& operator<<(std::ostream& os, const sf::Rect<T>& rect)
 
 bool operator==(const sf::Transform& lhs, const Approx<sf::Transform>& rhs);
 
+////////////////////////////////////////////////////////////
+/// Render target without an OpenGL context, recording what is
+/// drawn to it. Drawables are drawn as usual; the commands which
+/// reach OpenGL (vertex draws, clears) fail to activate the target
+/// and are recorded as activations instead of being executed.
+////////////////////////////////////////////////////////////
+class TestRenderTarget : public sf::RenderTarget
+{
+public:
+    struct Event
+    {
+        const sf::Drawable* drawable;   // Drawable drawn, or null for an activation
+        sf::RenderStates    states;     // Render states passed to the drawable
+        sf::Vector2f        viewCenter; // Center of the view of the target at the time of the event
+    };
+
+    explicit TestRenderTarget(const sf::Vector2u& size = {640, 480});
+
+    sf::Vector2u getSize() const override;
+
+    [[nodiscard]] bool setActive(bool active = true) override;
+
+    unsigned int getBackBufferAge() const override;
+
+    using sf::RenderTarget::endFrame;
+    using sf::RenderTarget::getFrameDamage;
+
+    std::vector<Event> events;
+    unsigned int       backBufferAge; // Age reported for the contents of the target, see getBackBufferAge
+
+private:
+    sf::Vector2u m_size;
+};
+
+////////////////////////////////////////////////////////////
+/// Drawable recording its draws in the events of a TestRenderTarget
+////////////////////////////////////////////////////////////
+class DrawableSpy : public sf::Drawable
+{
+public:
+    explicit DrawableSpy(const std::optional<sf::FloatRect>& bounds = std::nullopt);
+
+private:
+    void draw(sf::RenderTarget& target, const sf::RenderStates& states) const override;
+
+    std::optional<sf::FloatRect> getCullingBounds() const override;
+
+    std::optional<sf::FloatRect> m_bounds;
+};
+
 #endif // SFML_TESTUTILITIES_GRAPHICS_HPP